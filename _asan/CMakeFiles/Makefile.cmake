@@ -0,0 +1,92 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/tests/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/mg6010e.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_sim.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_socketcan.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_mock_hal.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_trace_decode.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_record_decode.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_bench.dir/DependInfo.cmake"
+  "CMakeFiles/mg6010e_bench_hal.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_rx_burst.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_rx_burst_features.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_deferred_rx.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_stats.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_params.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_params_deferred.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_group.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_group_features.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_health.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_health_deferred.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_tx_queue.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_tx_queue_features.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_seqlock.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_seqlock_soa.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_encode.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_encode_features.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_request.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_request_deferred.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_unwrap_14.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_unwrap_15.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_unwrap_16.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_recorder.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_coalesce.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_coalesce_deferred.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_traj.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_budget.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_poll.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_adapt.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_multi_iq.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_multi_iq_features.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_pool.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mg6010e_test_pool_features.dir/DependInfo.cmake"
+  )
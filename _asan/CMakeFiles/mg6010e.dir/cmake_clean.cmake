@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e.dir/mg6010e.c.o"
+  "CMakeFiles/mg6010e.dir/mg6010e.c.o.d"
+  "libmg6010e.a"
+  "libmg6010e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
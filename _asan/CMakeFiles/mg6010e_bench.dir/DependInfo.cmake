@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/mg6010e_bench.c" "CMakeFiles/mg6010e_bench.dir/bench/mg6010e_bench.c.o" "gcc" "CMakeFiles/mg6010e_bench.dir/bench/mg6010e_bench.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan/CMakeFiles/mg6010e_sim.dir/DependInfo.cmake"
+  "/root/repo/_asan/CMakeFiles/mg6010e.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
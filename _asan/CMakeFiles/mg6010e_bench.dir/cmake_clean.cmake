@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_bench.dir/bench/mg6010e_bench.c.o"
+  "CMakeFiles/mg6010e_bench.dir/bench/mg6010e_bench.c.o.d"
+  "mg6010e_bench"
+  "mg6010e_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
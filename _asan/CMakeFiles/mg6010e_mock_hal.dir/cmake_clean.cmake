@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_mock_hal.dir/bench/mock_hal/mock_hal.c.o"
+  "CMakeFiles/mg6010e_mock_hal.dir/bench/mock_hal/mock_hal.c.o.d"
+  "CMakeFiles/mg6010e_mock_hal.dir/mg6010e.c.o"
+  "CMakeFiles/mg6010e_mock_hal.dir/mg6010e.c.o.d"
+  "libmg6010e_mock_hal.a"
+  "libmg6010e_mock_hal.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_mock_hal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_record_decode.dir/tools/mg6010e_record_decode.c.o"
+  "CMakeFiles/mg6010e_record_decode.dir/tools/mg6010e_record_decode.c.o.d"
+  "mg6010e_record_decode"
+  "mg6010e_record_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_record_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_sim.dir/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_sim.dir/mg6010e_sim.c.o.d"
+  "libmg6010e_sim.a"
+  "libmg6010e_sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
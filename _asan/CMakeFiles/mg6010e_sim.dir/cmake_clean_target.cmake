@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libmg6010e_sim.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_socketcan.dir/mg6010e_socketcan.c.o"
+  "CMakeFiles/mg6010e_socketcan.dir/mg6010e_socketcan.c.o.d"
+  "libmg6010e_socketcan.a"
+  "libmg6010e_socketcan.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_socketcan.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libmg6010e_socketcan.a"
+)
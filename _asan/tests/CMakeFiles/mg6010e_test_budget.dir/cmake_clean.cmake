@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_budget.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_budget.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_budget.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_budget.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_budget.dir/mg6010e_test_budget.c.o"
+  "CMakeFiles/mg6010e_test_budget.dir/mg6010e_test_budget.c.o.d"
+  "mg6010e_test_budget"
+  "mg6010e_test_budget.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_budget.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/mock_hal/mock_hal.c" "tests/CMakeFiles/mg6010e_test_encode_features.dir/__/bench/mock_hal/mock_hal.c.o" "gcc" "tests/CMakeFiles/mg6010e_test_encode_features.dir/__/bench/mock_hal/mock_hal.c.o.d"
+  "/root/repo/mg6010e.c" "tests/CMakeFiles/mg6010e_test_encode_features.dir/__/mg6010e.c.o" "gcc" "tests/CMakeFiles/mg6010e_test_encode_features.dir/__/mg6010e.c.o.d"
+  "/root/repo/tests/mg6010e_test_encode.c" "tests/CMakeFiles/mg6010e_test_encode_features.dir/mg6010e_test_encode.c.o" "gcc" "tests/CMakeFiles/mg6010e_test_encode_features.dir/mg6010e_test_encode.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
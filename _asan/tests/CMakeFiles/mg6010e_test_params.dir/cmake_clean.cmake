@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_params.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_params.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_params.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_params.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_params.dir/mg6010e_test_params.c.o"
+  "CMakeFiles/mg6010e_test_params.dir/mg6010e_test_params.c.o.d"
+  "mg6010e_test_params"
+  "mg6010e_test_params.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_params.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_poll.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_poll.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_poll.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_poll.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_poll.dir/mg6010e_test_poll.c.o"
+  "CMakeFiles/mg6010e_test_poll.dir/mg6010e_test_poll.c.o.d"
+  "mg6010e_test_poll"
+  "mg6010e_test_poll.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_poll.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
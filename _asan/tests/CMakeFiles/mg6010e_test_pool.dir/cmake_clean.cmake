@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_pool.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_pool.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_pool.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_pool.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_pool.dir/mg6010e_test_pool.c.o"
+  "CMakeFiles/mg6010e_test_pool.dir/mg6010e_test_pool.c.o.d"
+  "mg6010e_test_pool"
+  "mg6010e_test_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_traj.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_traj.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_traj.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_traj.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_traj.dir/mg6010e_test_traj.c.o"
+  "CMakeFiles/mg6010e_test_traj.dir/mg6010e_test_traj.c.o.d"
+  "mg6010e_test_traj"
+  "mg6010e_test_traj.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_traj.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
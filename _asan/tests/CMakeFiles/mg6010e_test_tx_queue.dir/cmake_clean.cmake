@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_tx_queue.dir/__/bench/mock_hal/mock_hal.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue.dir/__/bench/mock_hal/mock_hal.c.o.d"
+  "CMakeFiles/mg6010e_test_tx_queue.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_tx_queue.dir/mg6010e_test_tx_queue.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue.dir/mg6010e_test_tx_queue.c.o.d"
+  "mg6010e_test_tx_queue"
+  "mg6010e_test_tx_queue.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_tx_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/__/bench/mock_hal/mock_hal.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/__/bench/mock_hal/mock_hal.c.o.d"
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/mg6010e_test_tx_queue.c.o"
+  "CMakeFiles/mg6010e_test_tx_queue_features.dir/mg6010e_test_tx_queue.c.o.d"
+  "mg6010e_test_tx_queue_features"
+  "mg6010e_test_tx_queue_features.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_tx_queue_features.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/__/mg6010e.c.o"
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/__/mg6010e.c.o.d"
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/__/mg6010e_sim.c.o"
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/__/mg6010e_sim.c.o.d"
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/mg6010e_test_unwrap.c.o"
+  "CMakeFiles/mg6010e_test_unwrap_15.dir/mg6010e_test_unwrap.c.o.d"
+  "mg6010e_test_unwrap_15"
+  "mg6010e_test_unwrap_15.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mg6010e_test_unwrap_15.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,70 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_asan/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(mg6010e_test_rx_burst "/root/repo/_asan/tests/mg6010e_test_rx_burst")
+set_tests_properties(mg6010e_test_rx_burst PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;37;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_rx_burst_features "/root/repo/_asan/tests/mg6010e_test_rx_burst_features")
+set_tests_properties(mg6010e_test_rx_burst_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;38;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_deferred_rx "/root/repo/_asan/tests/mg6010e_test_deferred_rx")
+set_tests_properties(mg6010e_test_deferred_rx PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;40;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_stats "/root/repo/_asan/tests/mg6010e_test_stats")
+set_tests_properties(mg6010e_test_stats PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;42;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_params "/root/repo/_asan/tests/mg6010e_test_params")
+set_tests_properties(mg6010e_test_params PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;45;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_params_deferred "/root/repo/_asan/tests/mg6010e_test_params_deferred")
+set_tests_properties(mg6010e_test_params_deferred PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;47;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_group "/root/repo/_asan/tests/mg6010e_test_group")
+set_tests_properties(mg6010e_test_group PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;49;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_group_features "/root/repo/_asan/tests/mg6010e_test_group_features")
+set_tests_properties(mg6010e_test_group_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;51;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_health "/root/repo/_asan/tests/mg6010e_test_health")
+set_tests_properties(mg6010e_test_health PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;53;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_health_deferred "/root/repo/_asan/tests/mg6010e_test_health_deferred")
+set_tests_properties(mg6010e_test_health_deferred PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;55;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_tx_queue "/root/repo/_asan/tests/mg6010e_test_tx_queue")
+set_tests_properties(mg6010e_test_tx_queue PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;57;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_tx_queue_features "/root/repo/_asan/tests/mg6010e_test_tx_queue_features")
+set_tests_properties(mg6010e_test_tx_queue_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;58;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_seqlock "/root/repo/_asan/tests/mg6010e_test_seqlock")
+set_tests_properties(mg6010e_test_seqlock PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;60;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_seqlock_soa "/root/repo/_asan/tests/mg6010e_test_seqlock_soa")
+set_tests_properties(mg6010e_test_seqlock_soa PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;62;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_encode "/root/repo/_asan/tests/mg6010e_test_encode")
+set_tests_properties(mg6010e_test_encode PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;65;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_encode_features "/root/repo/_asan/tests/mg6010e_test_encode_features")
+set_tests_properties(mg6010e_test_encode_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;66;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_request "/root/repo/_asan/tests/mg6010e_test_request")
+set_tests_properties(mg6010e_test_request PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;68;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_request_deferred "/root/repo/_asan/tests/mg6010e_test_request_deferred")
+set_tests_properties(mg6010e_test_request_deferred PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;70;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_unwrap_14 "/root/repo/_asan/tests/mg6010e_test_unwrap_14")
+set_tests_properties(mg6010e_test_unwrap_14 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;72;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_unwrap_15 "/root/repo/_asan/tests/mg6010e_test_unwrap_15")
+set_tests_properties(mg6010e_test_unwrap_15 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;75;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_unwrap_16 "/root/repo/_asan/tests/mg6010e_test_unwrap_16")
+set_tests_properties(mg6010e_test_unwrap_16 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;78;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_recorder "/root/repo/_asan/tests/mg6010e_test_recorder")
+set_tests_properties(mg6010e_test_recorder PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;80;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_coalesce "/root/repo/_asan/tests/mg6010e_test_coalesce")
+set_tests_properties(mg6010e_test_coalesce PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;82;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_coalesce_deferred "/root/repo/_asan/tests/mg6010e_test_coalesce_deferred")
+set_tests_properties(mg6010e_test_coalesce_deferred PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;84;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_traj "/root/repo/_asan/tests/mg6010e_test_traj")
+set_tests_properties(mg6010e_test_traj PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;86;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_budget "/root/repo/_asan/tests/mg6010e_test_budget")
+set_tests_properties(mg6010e_test_budget PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;88;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_poll "/root/repo/_asan/tests/mg6010e_test_poll")
+set_tests_properties(mg6010e_test_poll PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;90;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_adapt "/root/repo/_asan/tests/mg6010e_test_adapt")
+set_tests_properties(mg6010e_test_adapt PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;92;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_multi_iq "/root/repo/_asan/tests/mg6010e_test_multi_iq")
+set_tests_properties(mg6010e_test_multi_iq PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;94;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_multi_iq_features "/root/repo/_asan/tests/mg6010e_test_multi_iq_features")
+set_tests_properties(mg6010e_test_multi_iq_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;95;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_pool "/root/repo/_asan/tests/mg6010e_test_pool")
+set_tests_properties(mg6010e_test_pool PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;97;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mg6010e_test_pool_features "/root/repo/_asan/tests/mg6010e_test_pool_features")
+set_tests_properties(mg6010e_test_pool_features PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;98;mg6010e_add_test;/root/repo/tests/CMakeLists.txt;0;")
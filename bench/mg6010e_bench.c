@@ -0,0 +1,1018 @@
+/**
+ * @file mg6010e_bench.c
+ * @brief 领控6010E电机驱动上位机基准测试
+ * @note 覆盖命令编码与发送、按命令字节的反馈解析、句柄查找，以及经仿真器的端到端往返（仅MG6010E_USE_HAL为0时）。
+ * 以MG6010E_USE_HAL为1编译时链接bench/mock_hal，测量经HAL传输层的发送与接收回调路径。
+ * 参数与输出格式兼容Google Benchmark，JSON结果可直接用其tools/compare.py比较不同版本：
+ * mg6010e_bench --benchmark_format=json --benchmark_out=result.json
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "mg6010e.h"
+#if MG6010E_USE_HAL
+#include "stm32f4xx_hal.h"
+#else
+#include "mg6010e_sim.h"
+#endif
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef MG6010E_BENCH_VERSION
+#define MG6010E_BENCH_VERSION "unknown" // 被测驱动的版本，由CMake取自git describe
+#endif
+
+#define MG6010E_BENCH_MOTOR_NUM 4        // 编码、解析与查找测试初始化的电机数量（第0条总线，ID 1~4）
+#define MG6010E_BENCH_REPETITIONS_MAX 100 // 最大重复测量次数
+
+// 基准测试项
+typedef struct mg6010e_bench
+{
+    const char *name;                 // 名称，格式为“分组/项目”
+    void (*setup)(void);              // 测量前的准备，可为NULL
+    void (*run)(uint64_t iterations); // 执行iterations次被测操作
+    void (*teardown)(void);           // 测量后的清理，可为NULL
+    uint32_t items;                   // 每次迭代处理的帧数，用于计算items_per_second
+} mg6010e_bench_t;
+
+// 单项测量结果
+typedef struct mg6010e_bench_result
+{
+    uint64_t iterations; // 每次重复的迭代次数
+    double real_ns;      // 每次迭代的墙钟时间中位数，单位ns
+    double cpu_ns;       // 每次迭代的CPU时间中位数，单位ns
+    double real_min_ns;  // 各次重复中最短的每次迭代墙钟时间，单位ns
+    double real_max_ns;  // 各次重复中最长的每次迭代墙钟时间，单位ns
+} mg6010e_bench_result_t;
+
+static volatile uint32_t mg6010e_bench_sink; // 防止被测操作被优化掉
+static uint32_t mg6010e_bench_errors;        // 被测接口返回错误的次数，不为0时测试失败
+
+#if MG6010E_USE_HAL
+static CAN_HandleTypeDef mg6010e_bench_can;
+#else
+static int mg6010e_bench_can; // 空传输层的总线对象，只用其地址区分总线
+static mg6010e_sim_t mg6010e_bench_sim;
+static uint8_t mg6010e_bench_sim_motor[16]; // 仿真总线上电机的编号
+static uint32_t mg6010e_bench_sim_motor_num;
+static uint32_t mg6010e_bench_time_us;
+
+/**
+ * @brief 空传输层：始终可发送，发出的帧直接丢弃
+ */
+static uint32_t mg6010e_bench_tx_free(mg6010e_can_t *can)
+{
+    (void)can;
+    return MG6010E_CAN_BATCH_NUM;
+}
+
+static uint32_t mg6010e_bench_send(mg6010e_can_t *can, const mg6010e_can_frame_t *frames, uint32_t count)
+{
+    (void)can;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        mg6010e_bench_sink += frames[i].data[0];
+    }
+    return count;
+}
+
+static uint32_t mg6010e_bench_recv(mg6010e_can_t *can, mg6010e_can_frame_t *frames, uint32_t count)
+{
+    (void)can;
+    (void)frames;
+    (void)count;
+    return 0;
+}
+
+static uint32_t mg6010e_bench_timestamp_us(void)
+{
+    return mg6010e_bench_time_us++;
+}
+
+// 空传输层，用于只测量驱动本身的开销
+static const mg6010e_transport_t mg6010e_bench_transport = {
+    .tx_free = mg6010e_bench_tx_free,
+    .send = mg6010e_bench_send,
+    .recv = mg6010e_bench_recv,
+    .timestamp_us = mg6010e_bench_timestamp_us,
+};
+#endif
+
+/**
+ * @brief 处理延迟解析模式下队列中的帧，使每次迭代都包含完整的解析
+ */
+static inline void mg6010e_bench_rx_flush(void)
+{
+#if MG6010E_USE_DEFERRED_RX
+    mg6010e_process_pending();
+#endif
+}
+
+/**
+ * @brief 将一帧反馈交给驱动，使用HAL时经接收回调，否则经mg6010e_can_rx_frame
+ */
+static inline void mg6010e_bench_rx(const mg6010e_can_frame_t *frame)
+{
+#if MG6010E_USE_HAL
+    CAN_RxHeaderTypeDef rx_header = {.StdId = frame->std_id, .IDE = CAN_ID_STD, .RTR = CAN_RTR_DATA, .DLC = frame->dlc};
+    mg6010e_can_rx_callback_hook(&mg6010e_bench_can, &rx_header, (uint8_t *)frame->data);
+#else
+    mg6010e_can_rx_frame(&mg6010e_bench_can, frame);
+#endif
+    mg6010e_bench_rx_flush();
+}
+
+/**
+ * @brief 在第0条总线上初始化电机1~MG6010E_BENCH_MOTOR_NUM
+ */
+static void mg6010e_bench_setup(void)
+{
+#if MG6010E_USE_HAL
+    mock_hal_can_init(&mg6010e_bench_can);
+    mg6010e_set_transport(&mg6010e_hal_transport);
+#else
+    mg6010e_set_transport(&mg6010e_bench_transport);
+#endif
+    for (uint32_t id = 1; id <= MG6010E_BENCH_MOTOR_NUM; id++)
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_bench_can, .motor_id = id};
+        mg6010e_bench_errors += mg6010e_init(&config) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_teardown(void)
+{
+    for (uint8_t id = 1; id <= MG6010E_BENCH_MOTOR_NUM; id++)
+    {
+        mg6010e_deinit(id);
+    }
+}
+
+static void mg6010e_bench_encode_read_status_2(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_read_status_2(1) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_iq_control(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_iq_control(1, (int16_t)i) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_speed_control(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_speed_control(1, 500, (int32_t)i) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_angle_control_2(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_angle_control_2(1, (int32_t)i, 360) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_single_angle_control_2(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_single_angle_control_2(1, (int32_t)(i % 36000), 360, 0) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_write_control_param(uint64_t iterations)
+{
+    uint8_t param[6] = {100, 0, 20, 0, 0, 0};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        param[4] = (uint8_t)i;
+        mg6010e_bench_errors += mg6010e_write_control_param(1, 0x0A, param) != MG6010E_SUCCESS;
+    }
+}
+
+static void mg6010e_bench_encode_iq_control_group(uint64_t iterations)
+{
+    static const uint8_t motor_ids[4] = {1, 2, 3, 4};
+    int16_t iqs[4] = {0};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        iqs[i & 3] = (int16_t)i;
+        mg6010e_bench_errors += mg6010e_iq_control_group(motor_ids, iqs, 4) != MG6010E_SUCCESS;
+    }
+}
+
+/**
+ * @brief 反复解析电机1的同一种反馈，每次改变数据字节以免被优化
+ */
+static void mg6010e_bench_decode(uint8_t cmd, uint8_t param_id, uint64_t iterations)
+{
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(1), .dlc = 8, .data = {cmd, param_id, 0x19, 0x64, 0x00, 0x10, 0x27, 0x01}};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frame.data[4] = (uint8_t)i;
+        frame.data[6] = (uint8_t)(i >> 8);
+        mg6010e_bench_rx(&frame);
+    }
+}
+
+static void mg6010e_bench_decode_9a(uint64_t iterations) { mg6010e_bench_decode(0x9A, 0x00, iterations); }
+static void mg6010e_bench_decode_9c(uint64_t iterations) { mg6010e_bench_decode(0x9C, 0x19, iterations); }
+static void mg6010e_bench_decode_9d(uint64_t iterations) { mg6010e_bench_decode(0x9D, 0x19, iterations); }
+static void mg6010e_bench_decode_a1(uint64_t iterations) { mg6010e_bench_decode(0xA1, 0x19, iterations); }
+static void mg6010e_bench_decode_8c(uint64_t iterations) { mg6010e_bench_decode(0x8C, 0x00, iterations); }
+static void mg6010e_bench_decode_90(uint64_t iterations) { mg6010e_bench_decode(0x90, 0x00, iterations); }
+static void mg6010e_bench_decode_92(uint64_t iterations) { mg6010e_bench_decode(0x92, 0x00, iterations); }
+static void mg6010e_bench_decode_94(uint64_t iterations) { mg6010e_bench_decode(0x94, 0x00, iterations); }
+static void mg6010e_bench_decode_c0(uint64_t iterations) { mg6010e_bench_decode(0xC0, 0x0A, iterations); }
+static void mg6010e_bench_decode_80(uint64_t iterations) { mg6010e_bench_decode(0x80, 0x00, iterations); }
+
+/**
+ * @brief 未初始化电机ID的反馈，测量查找失败后丢弃的开销
+ */
+static void mg6010e_bench_decode_unregistered(uint64_t iterations)
+{
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(20), .dlc = 8, .data = {0x9C, 0x19}};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frame.data[4] = (uint8_t)i;
+        mg6010e_bench_rx(&frame);
+    }
+}
+
+/**
+ * @brief 4个电机交替回复0x9C，每次迭代批量解析MG6010E_RX_BURST_NUM帧
+ */
+static void mg6010e_bench_decode_burst(uint64_t iterations)
+{
+    mg6010e_can_frame_t frames[MG6010E_RX_BURST_NUM];
+    for (uint32_t i = 0; i < MG6010E_RX_BURST_NUM; i++)
+    {
+        frames[i] = (mg6010e_can_frame_t){.std_id = MG6010E_CAN_FEEDBACK_ID(1 + i % MG6010E_BENCH_MOTOR_NUM), .dlc = 8, .data = {0x9C, 0x19, 0x64, 0x00, 0x00, 0x10, 0x27, 0x01}};
+    }
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frames[i % MG6010E_RX_BURST_NUM].data[4] = (uint8_t)i;
+        mg6010e_bench_sink += mg6010e_can_rx_process_burst(&mg6010e_bench_can, frames, MG6010E_RX_BURST_NUM);
+    }
+}
+
+#define MG6010E_BENCH_ISR_FRAMES 4096 // 混合帧序列的长度，必须为2的幂
+
+static mg6010e_can_frame_t mg6010e_bench_isr_frames[MG6010E_BENCH_ISR_FRAMES]; // 接收中断混合帧序列
+
+/**
+ * @brief 生成固定的混合帧序列：一半为其他设备的ID，另一半为已初始化电机的各种反馈
+ */
+static void mg6010e_bench_isr_setup(void)
+{
+    static const uint8_t cmds[] = {0x9A, 0x9C, 0x9D, 0xA1, 0xA2, 0xA4, 0xA6, 0xA8, 0x8C, 0x90, 0x92, 0x94, 0xC0, 0x80, 0x81};
+    mg6010e_bench_setup();
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < MG6010E_BENCH_ISR_FRAMES; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        uint32_t r = seed >> 8;
+        mg6010e_can_frame_t *frame = &mg6010e_bench_isr_frames[i];
+        *frame = (mg6010e_can_frame_t){.dlc = 8, .data = {cmds[r % sizeof(cmds)], 0x0A, (uint8_t)r, (uint8_t)(r >> 4), (uint8_t)(r >> 8), 0x10, (uint8_t)(r >> 12), 0x01}};
+        if (i & 1)
+        {
+            frame->std_id = MG6010E_CAN_FEEDBACK_ID(1 + r % MG6010E_BENCH_MOTOR_NUM);
+        }
+        else
+        {
+            frame->std_id = (r & 0x100) ? 0x200 + (r & 0xFF) : 0x100 + (r & 0x3F); // 其他设备，不在0x141~0x160内
+        }
+    }
+}
+
+/**
+ * @brief 按顺序将混合帧序列交给接收中断，测量每帧的平均耗时（含其他设备帧的快速丢弃）
+ * @note 与解析表引入前的switch实现对比时使用同一序列，见MG6010E_BENCH_ISR_FRAMES
+ */
+static void mg6010e_bench_decode_isr_mixed(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_rx(&mg6010e_bench_isr_frames[i & (MG6010E_BENCH_ISR_FRAMES - 1)]);
+    }
+}
+
+static void mg6010e_bench_lookup_bus_index(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_sink += (uint32_t)mg6010e_get_bus_index(&mg6010e_bench_can);
+    }
+}
+
+static void mg6010e_bench_lookup_motor_status(uint64_t iterations)
+{
+    mg6010e_status_t status;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_get_motor_status((uint8_t)(1 + (i & 3)), &status) != MG6010E_SUCCESS;
+        mg6010e_bench_sink += (uint32_t)status.speed;
+    }
+}
+
+static void mg6010e_bench_lookup_not_initialized(uint64_t iterations)
+{
+    mg6010e_status_t status;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_sink += mg6010e_get_motor_status(20, &status);
+    }
+}
+
+#if MG6010E_USE_SOA_TELEMETRY
+/**
+ * @brief 在第0条总线上初始化全部32个电机，并写入各不相同的0x9C与0x92反馈
+ */
+static void mg6010e_bench_setup_32(void)
+{
+    mg6010e_bench_setup();
+    for (uint32_t id = MG6010E_BENCH_MOTOR_NUM + 1; id <= 32; id++)
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_bench_can, .motor_id = id};
+        mg6010e_bench_errors += mg6010e_init(&config) != MG6010E_SUCCESS;
+    }
+    for (uint8_t id = 1; id <= 32; id++)
+    {
+        mg6010e_can_frame_t status_2 = {.std_id = MG6010E_CAN_FEEDBACK_ID(id), .dlc = 8, .data = {0x9C, 30, id, 0x00, id, 0x01, id, 0x02}};
+        mg6010e_can_frame_t angle = {.std_id = MG6010E_CAN_FEEDBACK_ID(id), .dlc = 8, .data = {0x92, id, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}};
+        mg6010e_bench_rx(&status_2);
+        mg6010e_bench_rx(&angle);
+    }
+}
+
+static void mg6010e_bench_teardown_32(void)
+{
+    for (uint8_t id = 1; id <= 32; id++)
+    {
+        mg6010e_deinit(id);
+    }
+}
+
+/**
+ * @brief 逐个调用mg6010e_get_motor_status读取32个电机的速度，与mg6010e_bench_lookup_speeds_32对照
+ */
+static void mg6010e_bench_lookup_motor_status_32(uint64_t iterations)
+{
+    mg6010e_status_t status;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int32_t sum = 0;
+        for (uint8_t id = 1; id <= 32; id++)
+        {
+            mg6010e_bench_errors += mg6010e_get_motor_status(id, &status) != MG6010E_SUCCESS;
+            sum += status.speed;
+        }
+        mg6010e_bench_sink += (uint32_t)sum;
+    }
+}
+
+/**
+ * @brief 一次mg6010e_get_speeds读取32个电机的速度
+ */
+static void mg6010e_bench_lookup_speeds_32(uint64_t iterations)
+{
+    int16_t speeds[32];
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_get_speeds(0, speeds, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        int32_t sum = 0;
+        for (uint32_t n = 0; n < 32; n++)
+        {
+            sum += speeds[n];
+        }
+        mg6010e_bench_sink += (uint32_t)sum;
+    }
+}
+
+/**
+ * @brief 批量读取32个电机的速度、转矩电流、编码器值、温度与多圈角度，即状态估计所需的全部遥测
+ */
+static void mg6010e_bench_lookup_telemetry_32(uint64_t iterations)
+{
+    int16_t speeds[32];
+    int16_t iqs[32];
+    uint16_t encoders[32];
+    int8_t temperatures[32];
+    int64_t angles[32];
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_get_speeds(0, speeds, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_get_iqs(0, iqs, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_get_encoders(0, encoders, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_get_temperatures(0, temperatures, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_get_angles(0, angles, 0xFFFFFFFFUL) != MG6010E_SUCCESS;
+        mg6010e_bench_sink += (uint32_t)(speeds[i & 31] + iqs[i & 31] + encoders[i & 31] + temperatures[i & 31] + angles[i & 31]);
+    }
+}
+#endif
+
+#if MG6010E_USE_TRAJECTORY
+/**
+ * @brief 4个电机同步执行三次插值角度轨迹，每次迭代为一次mg6010e_traj_tick（每个电机发出一个设定值）
+ */
+static void mg6010e_bench_trajectory_tick(uint64_t iterations)
+{
+    static const uint8_t motor_ids[4] = {1, 2, 3, 4};
+    const mg6010e_traj_point_t points[] = {
+        {.time_ms = 0, .value = 0, .velocity = 0},
+        {.time_ms = 2000000000U, .value = 1000000000, .velocity = 36000},
+        {.time_ms = 4000000000U, .value = 0, .velocity = 0},
+    };
+    const mg6010e_traj_config_t config = {.mode = MG6010E_TRAJ_ANGLE_CUBIC, .speed_margin = 20, .rate_hz = MG6010E_TRAJ_TICK_HZ, .min_speed = 30};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        mg6010e_bench_errors += mg6010e_traj_load(motor_ids[i], &config, points, 3) != MG6010E_SUCCESS;
+    }
+    mg6010e_bench_errors += mg6010e_traj_start(motor_ids, 4) != MG6010E_SUCCESS;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_traj_tick();
+    }
+}
+#endif
+
+#if MG6010E_USE_COALESCE
+/**
+ * @brief 4个电机每周期各写入3次转矩电流后合并发出，每次迭代为一个周期
+ */
+static void mg6010e_bench_coalesce_flush(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        for (uint8_t motor_id = 1; motor_id <= 4; motor_id++)
+        {
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                mg6010e_bench_errors += mg6010e_iq_control(motor_id, (int16_t)(i + k)) != MG6010E_SUCCESS;
+            }
+        }
+        mg6010e_coalesce_flush();
+    }
+}
+#endif
+
+#if MG6010E_USE_GROUP
+static void mg6010e_bench_group_commit(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_group_begin() != MG6010E_SUCCESS;
+        for (uint8_t motor_id = 1; motor_id <= MG6010E_BENCH_MOTOR_NUM; motor_id++)
+        {
+            mg6010e_bench_errors += mg6010e_angle_control_2(motor_id, (int32_t)i, 360) != MG6010E_SUCCESS;
+        }
+        mg6010e_bench_errors += mg6010e_group_commit() != MG6010E_SUCCESS;
+    }
+}
+#endif
+
+#if MG6010E_USE_RECORDER
+static void mg6010e_bench_recorder_setup(void)
+{
+    mg6010e_bench_setup();
+    mg6010e_recorder_start();
+}
+
+static void mg6010e_bench_recorder_teardown(void)
+{
+    mg6010e_recorder_stop();
+    mg6010e_bench_teardown();
+}
+
+/**
+ * @brief 记录0x9C反馈（转矩电流、速度与编码器每帧变化），每64帧导出一次，测量记录与导出的开销
+ */
+static void mg6010e_bench_recorder_9c(uint64_t iterations)
+{
+    static uint8_t buffer[MG6010E_RECORDER_SIZE];
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(1), .dlc = 8, .data = {0x9C, 0x19, 0x64, 0x00, 0x00, 0x10, 0x27, 0x01}};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frame.std_id = MG6010E_CAN_FEEDBACK_ID(1 + i % MG6010E_BENCH_MOTOR_NUM);
+        frame.data[2] = (uint8_t)(i >> 2);
+        frame.data[4] = (uint8_t)i;
+        frame.data[6] = (uint8_t)(i >> 3);
+        mg6010e_bench_rx(&frame);
+        if ((i & 63) == 63)
+        {
+            mg6010e_bench_sink += mg6010e_recorder_read(buffer, sizeof(buffer));
+        }
+    }
+    mg6010e_recorder_stats_t stats;
+    mg6010e_bench_errors += mg6010e_get_recorder_stats(&mg6010e_bench_can, &stats) != MG6010E_SUCCESS || stats.dropped != 0;
+}
+#endif
+
+#if MG6010E_USE_HEALTH
+static void mg6010e_bench_health_setup(void)
+{
+    mg6010e_bench_setup();
+    const mg6010e_health_config_t config = {
+        .timeout_us = 1000000,
+        .max_temperature = 80,
+        .min_voltage = 2000,
+        .error_mask = 0xFF,
+        .reaction = MG6010E_HEALTH_REACT_STOP,
+    };
+    for (uint8_t motor_id = 1; motor_id <= MG6010E_BENCH_MOTOR_NUM; motor_id++)
+    {
+        mg6010e_bench_errors += mg6010e_set_health_config(motor_id, &config) != MG6010E_SUCCESS;
+    }
+}
+
+/**
+ * @brief 4个电机轮流回复0x9C，每16帧调用一次mg6010e_health_tick，测量接收路径中健康监测与超时检查的开销
+ */
+static void mg6010e_bench_health_9c(uint64_t iterations)
+{
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(1), .dlc = 8, .data = {0x9C, 0x19, 0x64, 0x00, 0x00, 0x10, 0x27, 0x01}};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frame.std_id = MG6010E_CAN_FEEDBACK_ID(1 + i % MG6010E_BENCH_MOTOR_NUM);
+        mg6010e_bench_rx(&frame);
+        if ((i & 15) == 15)
+        {
+            mg6010e_health_tick();
+        }
+    }
+    mg6010e_health_t health;
+    mg6010e_bench_errors += mg6010e_get_health(1, &health) != MG6010E_SUCCESS || health.faults != 0;
+}
+#endif
+
+#if MG6010E_USE_ADAPTIVE_POLL
+static void mg6010e_bench_adaptive_setup(void)
+{
+    mg6010e_bench_setup();
+    for (uint8_t motor_id = 1; motor_id <= MG6010E_BENCH_MOTOR_NUM; motor_id++)
+    {
+        mg6010e_bench_errors += mg6010e_poll_adaptive(motor_id, MG6010E_POLL_STATUS_1, 10, 100) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_poll_adaptive(motor_id, MG6010E_POLL_STATUS_2, 20, 500) != MG6010E_SUCCESS;
+        mg6010e_bench_errors += mg6010e_poll_adaptive(motor_id, MG6010E_POLL_ANGLE, 10, 200) != MG6010E_SUCCESS;
+    }
+}
+
+/**
+ * @brief 4个电机轮流回复转速与转矩电流变化的0x9C，每64帧调用一次mg6010e_poll_adapt，测量接收路径中峰值记录与频率调整的开销
+ */
+static void mg6010e_bench_adaptive_9c(uint64_t iterations)
+{
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(1), .dlc = 8, .data = {0x9C, 0x19, 0x64, 0x00, 0x00, 0x10, 0x27, 0x01}};
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        frame.std_id = MG6010E_CAN_FEEDBACK_ID(1 + i % MG6010E_BENCH_MOTOR_NUM);
+        frame.data[2] = (uint8_t)(i >> 2);
+        frame.data[4] = (uint8_t)(i >> 4);
+        mg6010e_bench_rx(&frame);
+        if ((i & 63) == 63)
+        {
+            mg6010e_poll_adapt();
+        }
+    }
+    mg6010e_poll_rates_t rates;
+    mg6010e_bench_errors += mg6010e_get_poll_rates(1, &rates) != MG6010E_SUCCESS || rates.rate_hz[MG6010E_POLL_STATUS_2] == 0;
+}
+#endif
+
+#if !MG6010E_USE_HAL
+/**
+ * @brief 在仿真总线上初始化count个电机（ID 1~count）
+ */
+static void mg6010e_bench_sim_setup(uint32_t count, uint8_t rx_interrupt)
+{
+    mg6010e_set_transport(&mg6010e_sim_transport);
+    mg6010e_bench_errors += mg6010e_sim_init(&mg6010e_bench_sim) != MG6010E_SUCCESS;
+    mg6010e_bench_sim.rx_interrupt = rx_interrupt;
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_bench_sim, .motor_id = id};
+        mg6010e_bench_errors += mg6010e_init(&config) != MG6010E_SUCCESS;
+        mg6010e_bench_sim_motor[id - 1] = MG6010E_MOTOR(mg6010e_get_bus_index(&mg6010e_bench_sim), id);
+    }
+    mg6010e_bench_sim_motor_num = count;
+}
+
+static void mg6010e_bench_sim_setup_1(void) { mg6010e_bench_sim_setup(1, 1); }
+static void mg6010e_bench_sim_setup_1_poll(void) { mg6010e_bench_sim_setup(1, 0); }
+static void mg6010e_bench_sim_setup_4(void) { mg6010e_bench_sim_setup(4, 1); }
+static void mg6010e_bench_sim_setup_16(void) { mg6010e_bench_sim_setup(16, 1); }
+
+static void mg6010e_bench_sim_teardown(void)
+{
+    for (uint32_t i = 0; i < mg6010e_bench_sim_motor_num; i++)
+    {
+        mg6010e_deinit(mg6010e_bench_sim_motor[i]);
+    }
+}
+
+/**
+ * @brief 检查仿真电机回复了期望数量的帧，未回复说明往返没有完成
+ */
+static void mg6010e_bench_sim_check(const mg6010e_sim_stats_t *before, uint64_t replies)
+{
+    mg6010e_sim_stats_t after;
+    mg6010e_sim_get_stats(&mg6010e_bench_sim, &after);
+    mg6010e_bench_errors += (uint64_t)(after.frames_rx - before->frames_rx) < replies;
+}
+
+/**
+ * @brief 读取状态2并推进虚拟时间直到回复被解析
+ */
+static void mg6010e_bench_roundtrip_read_status_2(uint64_t iterations)
+{
+    mg6010e_sim_stats_t before;
+    mg6010e_sim_get_stats(&mg6010e_bench_sim, &before);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        mg6010e_bench_errors += mg6010e_read_status_2(mg6010e_bench_sim_motor[0]) != MG6010E_SUCCESS;
+        mg6010e_sim_advance(300);
+        if (!mg6010e_bench_sim.rx_interrupt)
+        {
+            mg6010e_can_rx_poll(&mg6010e_bench_sim);
+        }
+        mg6010e_bench_rx_flush();
+    }
+    mg6010e_bench_sim_check(&before, iterations);
+}
+
+/**
+ * @brief 1kHz控制周期：一帧0x280广播控制4个电机，4帧回复
+ */
+static void mg6010e_bench_roundtrip_iq_control_group(uint64_t iterations)
+{
+    static const uint8_t motor_ids[4] = {1, 2, 3, 4};
+    int16_t iqs[4] = {100, -100, 200, -200};
+    uint8_t ids[4];
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ids[i] = mg6010e_bench_sim_motor[motor_ids[i] - 1];
+    }
+    mg6010e_sim_stats_t before;
+    mg6010e_sim_get_stats(&mg6010e_bench_sim, &before);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        iqs[i & 3] = (int16_t)(i & 0xFF);
+        mg6010e_bench_errors += mg6010e_iq_control_group(ids, iqs, 4) != MG6010E_SUCCESS;
+        mg6010e_sim_advance(1000);
+        mg6010e_bench_rx_flush();
+    }
+    mg6010e_bench_sim_check(&before, iterations * 4);
+}
+
+/**
+ * @brief 100Hz控制周期：16个电机各发一条0xA4并收到回复
+ */
+static void mg6010e_bench_roundtrip_angle_control_2(uint64_t iterations)
+{
+    mg6010e_sim_stats_t before;
+    mg6010e_sim_get_stats(&mg6010e_bench_sim, &before);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        for (uint32_t m = 0; m < mg6010e_bench_sim_motor_num; m++)
+        {
+            mg6010e_bench_errors += mg6010e_angle_control_2(mg6010e_bench_sim_motor[m], (int32_t)(i % 36000), 360) != MG6010E_SUCCESS;
+        }
+#if MG6010E_USE_COALESCE
+        mg6010e_coalesce_flush();
+#endif
+        mg6010e_sim_advance(10000);
+        mg6010e_bench_rx_flush();
+    }
+    mg6010e_bench_sim_check(&before, iterations * mg6010e_bench_sim_motor_num);
+}
+#endif
+
+#define MG6010E_BENCH(name, setup, run, teardown, items) {name, setup, run, teardown, items}
+#define MG6010E_BENCH_DRIVER(name, run, items) MG6010E_BENCH(name, mg6010e_bench_setup, run, mg6010e_bench_teardown, items)
+
+static const mg6010e_bench_t mg6010e_bench_list[] = {
+    MG6010E_BENCH_DRIVER("encode/read_status_2", mg6010e_bench_encode_read_status_2, 1),
+    MG6010E_BENCH_DRIVER("encode/iq_control", mg6010e_bench_encode_iq_control, 1),
+    MG6010E_BENCH_DRIVER("encode/speed_control", mg6010e_bench_encode_speed_control, 1),
+    MG6010E_BENCH_DRIVER("encode/angle_control_2", mg6010e_bench_encode_angle_control_2, 1),
+    MG6010E_BENCH_DRIVER("encode/single_angle_control_2", mg6010e_bench_encode_single_angle_control_2, 1),
+    MG6010E_BENCH_DRIVER("encode/write_control_param", mg6010e_bench_encode_write_control_param, 1),
+    MG6010E_BENCH_DRIVER("encode/iq_control_group", mg6010e_bench_encode_iq_control_group, 1),
+    MG6010E_BENCH_DRIVER("decode/0x9A", mg6010e_bench_decode_9a, 1),
+    MG6010E_BENCH_DRIVER("decode/0x9C", mg6010e_bench_decode_9c, 1),
+    MG6010E_BENCH_DRIVER("decode/0x9D", mg6010e_bench_decode_9d, 1),
+    MG6010E_BENCH_DRIVER("decode/0xA1", mg6010e_bench_decode_a1, 1),
+    MG6010E_BENCH_DRIVER("decode/0x8C", mg6010e_bench_decode_8c, 1),
+    MG6010E_BENCH_DRIVER("decode/0x90", mg6010e_bench_decode_90, 1),
+    MG6010E_BENCH_DRIVER("decode/0x92", mg6010e_bench_decode_92, 1),
+    MG6010E_BENCH_DRIVER("decode/0x94", mg6010e_bench_decode_94, 1),
+    MG6010E_BENCH_DRIVER("decode/0xC0", mg6010e_bench_decode_c0, 1),
+    MG6010E_BENCH_DRIVER("decode/0x80", mg6010e_bench_decode_80, 1),
+    MG6010E_BENCH_DRIVER("decode/unregistered", mg6010e_bench_decode_unregistered, 1),
+    MG6010E_BENCH_DRIVER("decode/burst_0x9C", mg6010e_bench_decode_burst, MG6010E_RX_BURST_NUM),
+    MG6010E_BENCH("decode/isr_mixed", mg6010e_bench_isr_setup, mg6010e_bench_decode_isr_mixed, mg6010e_bench_teardown, 1),
+    MG6010E_BENCH_DRIVER("lookup/bus_index", mg6010e_bench_lookup_bus_index, 1),
+    MG6010E_BENCH_DRIVER("lookup/motor_status", mg6010e_bench_lookup_motor_status, 1),
+    MG6010E_BENCH_DRIVER("lookup/not_initialized", mg6010e_bench_lookup_not_initialized, 1),
+#if MG6010E_USE_SOA_TELEMETRY
+    MG6010E_BENCH("lookup/motor_status_32", mg6010e_bench_setup_32, mg6010e_bench_lookup_motor_status_32, mg6010e_bench_teardown_32, 32),
+    MG6010E_BENCH("lookup/get_speeds_32", mg6010e_bench_setup_32, mg6010e_bench_lookup_speeds_32, mg6010e_bench_teardown_32, 32),
+    MG6010E_BENCH("lookup/get_telemetry_32", mg6010e_bench_setup_32, mg6010e_bench_lookup_telemetry_32, mg6010e_bench_teardown_32, 32),
+#endif
+#if MG6010E_USE_TRAJECTORY
+    MG6010E_BENCH_DRIVER("trajectory/tick_cubic_4", mg6010e_bench_trajectory_tick, 4),
+#endif
+#if MG6010E_USE_COALESCE
+    MG6010E_BENCH_DRIVER("coalesce/iq_control_3x_flush_4", mg6010e_bench_coalesce_flush, 12),
+#endif
+#if MG6010E_USE_GROUP
+    MG6010E_BENCH_DRIVER("group/angle_control_2_x4_commit", mg6010e_bench_group_commit, MG6010E_BENCH_MOTOR_NUM),
+#endif
+#if MG6010E_USE_HEALTH
+    MG6010E_BENCH("health/0x9C_tick_every_16", mg6010e_bench_health_setup, mg6010e_bench_health_9c, mg6010e_bench_teardown, 1),
+#endif
+#if MG6010E_USE_ADAPTIVE_POLL
+    MG6010E_BENCH("adaptive/0x9C_adapt_every_64", mg6010e_bench_adaptive_setup, mg6010e_bench_adaptive_9c, mg6010e_bench_teardown, 1),
+#endif
+#if MG6010E_USE_RECORDER
+    MG6010E_BENCH("recorder/0x9C_read_every_64", mg6010e_bench_recorder_setup, mg6010e_bench_recorder_9c, mg6010e_bench_recorder_teardown, 1),
+#endif
+#if !MG6010E_USE_HAL
+    MG6010E_BENCH("roundtrip/read_status_2", mg6010e_bench_sim_setup_1, mg6010e_bench_roundtrip_read_status_2, mg6010e_bench_sim_teardown, 1),
+    MG6010E_BENCH("roundtrip/read_status_2_poll", mg6010e_bench_sim_setup_1_poll, mg6010e_bench_roundtrip_read_status_2, mg6010e_bench_sim_teardown, 1),
+    MG6010E_BENCH("roundtrip/iq_control_group_1khz", mg6010e_bench_sim_setup_4, mg6010e_bench_roundtrip_iq_control_group, mg6010e_bench_sim_teardown, 4),
+    MG6010E_BENCH("roundtrip/angle_control_2_16x100hz", mg6010e_bench_sim_setup_16, mg6010e_bench_roundtrip_angle_control_2, mg6010e_bench_sim_teardown, 16),
+#endif
+};
+
+static double mg6010e_bench_now(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief 执行一次测量
+ *
+ * @param real_ns 墙钟时间输出，单位ns
+ * @param cpu_ns CPU时间输出，单位ns
+ */
+static void mg6010e_bench_measure(const mg6010e_bench_t *bench, uint64_t iterations, double *real_ns, double *cpu_ns)
+{
+    if (bench->setup != NULL)
+    {
+        bench->setup();
+    }
+    double real_start = mg6010e_bench_now(CLOCK_MONOTONIC);
+    double cpu_start = mg6010e_bench_now(CLOCK_PROCESS_CPUTIME_ID);
+    bench->run(iterations);
+    *cpu_ns = mg6010e_bench_now(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    *real_ns = mg6010e_bench_now(CLOCK_MONOTONIC) - real_start;
+    if (bench->teardown != NULL)
+    {
+        bench->teardown();
+    }
+}
+
+static int mg6010e_bench_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double mg6010e_bench_median(double *values, uint32_t count)
+{
+    qsort(values, count, sizeof(double), mg6010e_bench_compare);
+    return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/**
+ * @brief 以倍增的迭代次数试运行，直到单次测量不短于min_time，再重复测量repetitions次
+ */
+static void mg6010e_bench_run(const mg6010e_bench_t *bench, double min_time, uint32_t repetitions, mg6010e_bench_result_t *result)
+{
+    uint64_t iterations = 1;
+    double real_ns;
+    double cpu_ns;
+    for (;;)
+    {
+        mg6010e_bench_measure(bench, iterations, &real_ns, &cpu_ns);
+        if (real_ns >= min_time * 1e9 || iterations >= 1000000000ULL)
+        {
+            break;
+        }
+        double scale = real_ns > 0 ? min_time * 1e9 * 1.4 / real_ns : 10;
+        scale = scale < 2 ? 2 : (scale > 10 ? 10 : scale);
+        iterations = (uint64_t)((double)iterations * scale);
+    }
+    double real[MG6010E_BENCH_REPETITIONS_MAX];
+    double cpu[MG6010E_BENCH_REPETITIONS_MAX];
+    for (uint32_t i = 0; i < repetitions; i++)
+    {
+        mg6010e_bench_measure(bench, iterations, &real[i], &cpu[i]);
+        real[i] /= (double)iterations;
+        cpu[i] /= (double)iterations;
+    }
+    result->iterations = iterations;
+    result->real_ns = mg6010e_bench_median(real, repetitions);
+    result->cpu_ns = mg6010e_bench_median(cpu, repetitions);
+    result->real_min_ns = real[0];
+    result->real_max_ns = real[repetitions - 1];
+}
+
+/**
+ * @brief 以Google Benchmark的JSON格式输出上下文
+ */
+static void mg6010e_bench_json_begin(FILE *out, uint32_t repetitions)
+{
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    fprintf(out, "{\n  \"context\": {\n");
+    fprintf(out, "    \"date\": \"%s\",\n", date);
+    fprintf(out, "    \"library\": \"mg6010e\",\n");
+    fprintf(out, "    \"library_version\": \"%s\",\n", MG6010E_BENCH_VERSION);
+#ifdef __VERSION__
+    fprintf(out, "    \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+#ifdef NDEBUG
+    fprintf(out, "    \"library_build_type\": \"release\",\n");
+#else
+    fprintf(out, "    \"library_build_type\": \"debug\",\n");
+#endif
+    fprintf(out, "    \"repetitions\": %u,\n", repetitions);
+    fprintf(out, "    \"options\": {\"MG6010E_USE_HAL\": %d, \"MG6010E_USE_SOA_TELEMETRY\": %d, \"MG6010E_USE_POLL_SCHEDULER\": %d, "
+                 "\"MG6010E_USE_REQUEST_TRACKING\": %d, \"MG6010E_USE_BUS_BUDGET\": %d, \"MG6010E_USE_DEFERRED_RX\": %d, "
+                 "\"MG6010E_USE_STATS\": %d, \"MG6010E_USE_TRACE\": %d, \"MG6010E_USE_TRAJECTORY\": %d, \"MG6010E_USE_COALESCE\": %d, \"MG6010E_USE_PARAMS_SNAPSHOT\": %d, "
+                 "\"MG6010E_USE_ENCODER_UNWRAP\": %d, \"MG6010E_USE_RECORDER\": %d, \"MG6010E_USE_GROUP\": %d, \"MG6010E_USE_HEALTH\": %d, "
+                 "\"MG6010E_USE_ADAPTIVE_POLL\": %d, \"MG6010E_TX_QUEUE_DEPTH\": %d, \"MG6010E_RX_BURST_NUM\": %d}\n",
+            MG6010E_USE_HAL, MG6010E_USE_SOA_TELEMETRY, MG6010E_USE_POLL_SCHEDULER, MG6010E_USE_REQUEST_TRACKING, MG6010E_USE_BUS_BUDGET,
+            MG6010E_USE_DEFERRED_RX, MG6010E_USE_STATS, MG6010E_USE_TRACE, MG6010E_USE_TRAJECTORY, MG6010E_USE_COALESCE, MG6010E_USE_PARAMS_SNAPSHOT,
+            MG6010E_USE_ENCODER_UNWRAP, MG6010E_USE_RECORDER, MG6010E_USE_GROUP, MG6010E_USE_HEALTH, MG6010E_USE_ADAPTIVE_POLL, MG6010E_TX_QUEUE_DEPTH, MG6010E_RX_BURST_NUM);
+    fprintf(out, "  },\n  \"benchmarks\": [");
+}
+
+static void mg6010e_bench_json_result(FILE *out, const mg6010e_bench_t *bench, const mg6010e_bench_result_t *result, uint32_t index)
+{
+    fprintf(out, "%s\n    {\n", index ? "," : "");
+    fprintf(out, "      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n", bench->name, bench->name);
+    fprintf(out, "      \"iterations\": %llu,\n", (unsigned long long)result->iterations);
+    fprintf(out, "      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n      \"time_unit\": \"ns\",\n", result->real_ns, result->cpu_ns);
+    fprintf(out, "      \"real_time_min\": %.3f,\n      \"real_time_max\": %.3f,\n", result->real_min_ns, result->real_max_ns);
+    fprintf(out, "      \"items_per_second\": %.1f\n    }", bench->items * 1e9 / result->cpu_ns);
+}
+
+static void mg6010e_bench_usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--benchmark_filter=REGEX] [--benchmark_min_time=SECONDS] [--benchmark_repetitions=N]\n"
+            "          [--benchmark_format=console|json|csv] [--benchmark_out=FILE] [--benchmark_list_tests]\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *format = "console";
+    const char *out_path = NULL;
+    double min_time = 0.2;
+    uint32_t repetitions = 3;
+    uint8_t list_only = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--benchmark_filter=", 19) == 0)
+        {
+            filter = arg + 19;
+        }
+        else if (strncmp(arg, "--benchmark_min_time=", 21) == 0)
+        {
+            min_time = atof(arg + 21); // 兼容"0.5s"写法
+        }
+        else if (strncmp(arg, "--benchmark_repetitions=", 24) == 0)
+        {
+            repetitions = (uint32_t)atoi(arg + 24);
+        }
+        else if (strncmp(arg, "--benchmark_format=", 19) == 0)
+        {
+            format = arg + 19;
+        }
+        else if (strncmp(arg, "--benchmark_out=", 16) == 0)
+        {
+            out_path = arg + 16;
+        }
+        else if (strcmp(arg, "--benchmark_list_tests") == 0 || strcmp(arg, "--benchmark_list_tests=true") == 0)
+        {
+            list_only = 1;
+        }
+        else
+        {
+            mg6010e_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (repetitions == 0 || repetitions > MG6010E_BENCH_REPETITIONS_MAX || min_time <= 0 || (strcmp(format, "console") && strcmp(format, "json") && strcmp(format, "csv")))
+    {
+        mg6010e_bench_usage(argv[0]);
+        return 2;
+    }
+    regex_t regex;
+    if (filter != NULL && regcomp(&regex, filter, REG_EXTENDED | REG_NOSUB) != 0)
+    {
+        fprintf(stderr, "invalid filter: %s\n", filter);
+        return 2;
+    }
+    // --benchmark_out写入的文件格式固定为JSON，控制台仍输出表格
+    FILE *json = NULL;
+    if (out_path != NULL)
+    {
+        json = fopen(out_path, "w");
+        if (json == NULL)
+        {
+            perror(out_path);
+            return 2;
+        }
+    }
+    else if (strcmp(format, "json") == 0)
+    {
+        json = stdout;
+    }
+    uint8_t csv = strcmp(format, "csv") == 0;
+    uint8_t console = json != stdout && !csv;
+
+    if (json != NULL && !list_only)
+    {
+        mg6010e_bench_json_begin(json, repetitions);
+    }
+    if (csv && !list_only)
+    {
+        printf("name,iterations,real_time,cpu_time,time_unit,items_per_second\n");
+    }
+    if (console && !list_only)
+    {
+        printf("%-40s %14s %14s %12s %14s\n", "Benchmark", "Time", "CPU", "Iterations", "Frames/s");
+    }
+    uint32_t count = 0;
+    int status = 0;
+    for (uint32_t i = 0; i < sizeof(mg6010e_bench_list) / sizeof(mg6010e_bench_list[0]); i++)
+    {
+        const mg6010e_bench_t *bench = &mg6010e_bench_list[i];
+        if (filter != NULL && regexec(&regex, bench->name, 0, NULL, 0) != 0)
+        {
+            continue;
+        }
+        if (list_only)
+        {
+            printf("%s\n", bench->name);
+            continue;
+        }
+        mg6010e_bench_result_t result;
+        mg6010e_bench_errors = 0;
+        mg6010e_bench_run(bench, min_time, repetitions, &result);
+        if (mg6010e_bench_errors != 0)
+        {
+            fprintf(stderr, "%s: %u calls failed\n", bench->name, mg6010e_bench_errors);
+            status = 1;
+        }
+        if (json != NULL)
+        {
+            mg6010e_bench_json_result(json, bench, &result, count);
+        }
+        if (csv)
+        {
+            printf("%s,%llu,%.3f,%.3f,ns,%.1f\n", bench->name, (unsigned long long)result.iterations, result.real_ns, result.cpu_ns,
+                   bench->items * 1e9 / result.cpu_ns);
+        }
+        if (console)
+        {
+            printf("%-40s %11.1f ns %11.1f ns %12llu %13.3fM\n", bench->name, result.real_ns, result.cpu_ns,
+                   (unsigned long long)result.iterations, bench->items * 1e3 / result.cpu_ns);
+        }
+        fflush(stdout);
+        count++;
+    }
+    if (json != NULL && !list_only)
+    {
+        fprintf(json, "\n  ]\n}\n");
+    }
+    if (json != NULL && json != stdout)
+    {
+        fclose(json);
+    }
+    if (filter != NULL)
+    {
+        regfree(&regex);
+    }
+    return status;
+}
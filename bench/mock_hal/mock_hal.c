@@ -0,0 +1,101 @@
+/**
+ * @file mock_hal.c
+ * @brief 上位机模拟的STM32 HAL库源文件
+ * @note 发送邮箱写入即视为发送完成（始终保留tx_free个空闲邮箱，tx_limit可使写入失败），HAL_GetTick由CLOCK_MONOTONIC换算，DWT->CYCCNT恒为0。
+ */
+#define _POSIX_C_SOURCE 199309L
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+static DWT_Type mock_hal_dwt;
+DWT_Type *DWT = &mock_hal_dwt;
+
+/**
+ * @brief 初始化模拟的CAN句柄
+ *
+ * @param hcan CAN句柄
+ */
+void mock_hal_can_init(CAN_HandleTypeDef *hcan)
+{
+    memset(hcan, 0, sizeof(CAN_HandleTypeDef));
+    hcan->tx_free = 3;
+}
+
+/**
+ * @brief 向接收FIFO0放入一帧标准数据帧
+ *
+ * @param hcan CAN句柄
+ * @param std_id 标准帧ID
+ * @param data 8字节数据
+ * @return uint8_t 1表示成功，0表示FIFO已满
+ */
+uint8_t mock_hal_rx_push(CAN_HandleTypeDef *hcan, uint32_t std_id, const uint8_t *data)
+{
+    if (hcan->rx_count >= MOCK_HAL_RX_FIFO_DEPTH)
+    {
+        return 0;
+    }
+    CAN_RxHeaderTypeDef *header = &hcan->rx_header[hcan->rx_count];
+    memset(header, 0, sizeof(CAN_RxHeaderTypeDef));
+    header->StdId = std_id;
+    header->IDE = CAN_ID_STD;
+    header->RTR = CAN_RTR_DATA;
+    header->DLC = 8;
+    memcpy(hcan->rx_data[hcan->rx_count], data, 8);
+    hcan->rx_count++;
+    return 1;
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox)
+{
+    if (hcan == NULL || pHeader == NULL || aData == NULL || hcan->tx_free == 0 || (hcan->tx_limit != 0 && hcan->tx_frames >= hcan->tx_limit))
+    {
+        return HAL_ERROR;
+    }
+    uint32_t index = hcan->tx_frames % MOCK_HAL_TX_LOG_DEPTH;
+    hcan->tx_log_id[index] = pHeader->StdId;
+    memcpy(hcan->tx_log_data[index], aData, 8);
+    hcan->tx_frames++;
+    *pTxMailbox = hcan->tx_frames % 3;
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan)
+{
+    return hcan->tx_free;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[])
+{
+    if (RxFifo != CAN_RX_FIFO0 || hcan->rx_count == 0)
+    {
+        return HAL_ERROR;
+    }
+    *pHeader = hcan->rx_header[0];
+    memcpy(aData, hcan->rx_data[0], 8);
+    hcan->rx_count--;
+    memmove(&hcan->rx_header[0], &hcan->rx_header[1], sizeof(CAN_RxHeaderTypeDef) * hcan->rx_count);
+    memmove(&hcan->rx_data[0], &hcan->rx_data[1], 8 * hcan->rx_count);
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo)
+{
+    return RxFifo == CAN_RX_FIFO0 ? hcan->rx_count : 0;
+}
+
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs)
+{
+    (void)hcan;
+    (void)ActiveITs;
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
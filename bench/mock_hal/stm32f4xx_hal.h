@@ -0,0 +1,89 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief 上位机模拟的STM32 HAL库头文件
+ * @note 只声明驱动用到的CAN接口、HAL_GetTick与DWT，用于在Linux上以MG6010E_USE_HAL为1编译并测试HAL传输层。
+ * 发送的帧被计数并记录在tx_log中，接收FIFO由mock_hal_rx_push填充。
+ */
+#ifndef __STM32F4XX_HAL_H__
+#define __STM32F4XX_HAL_H__
+
+#include <stdint.h>
+
+#ifndef __weak
+#define __weak __attribute__((weak))
+#endif
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t Timestamp;
+    uint32_t FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+#define MOCK_HAL_RX_FIFO_DEPTH 3 // 与bxCAN相同，每个接收FIFO 3帧
+#define MOCK_HAL_TX_LOG_DEPTH 64 // 记录最近写入发送邮箱的帧数，必须为2的幂
+
+// 模拟的CAN句柄
+typedef struct
+{
+    uint32_t tx_frames;                                    // 写入发送邮箱的帧数
+    uint32_t tx_free;                                      // 空闲发送邮箱数，初始化为3
+    uint32_t tx_limit;                                     // 为非0时写入的帧数达到该值后邮箱写入失败，用于模拟部分发送
+    uint32_t tx_log_id[MOCK_HAL_TX_LOG_DEPTH];             // 写入发送邮箱的帧ID，第n帧位于n % MOCK_HAL_TX_LOG_DEPTH
+    uint8_t tx_log_data[MOCK_HAL_TX_LOG_DEPTH][8];         // 写入发送邮箱的帧数据
+    CAN_RxHeaderTypeDef rx_header[MOCK_HAL_RX_FIFO_DEPTH]; // 接收FIFO0中的帧头
+    uint8_t rx_data[MOCK_HAL_RX_FIFO_DEPTH][8];            // 接收FIFO0中的数据
+    uint32_t rx_count;                                     // 接收FIFO0中的帧数
+} CAN_HandleTypeDef;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+extern DWT_Type *DWT;
+
+#define DISABLE 0U
+#define ENABLE 1U
+#define CAN_ID_STD 0x00000000U
+#define CAN_ID_EXT 0x00000004U
+#define CAN_RTR_DATA 0x00000000U
+#define CAN_RTR_REMOTE 0x00000002U
+#define CAN_RX_FIFO0 0x00000000U
+#define CAN_RX_FIFO1 0x00000001U
+#define CAN_IT_TX_MAILBOX_EMPTY 0x00000001U
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs);
+uint32_t HAL_GetTick(void);
+
+void mock_hal_can_init(CAN_HandleTypeDef *hcan);
+uint8_t mock_hal_rx_push(CAN_HandleTypeDef *hcan, uint32_t std_id, const uint8_t *data);
+
+#endif /* __STM32F4XX_HAL_H__ */
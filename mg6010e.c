@@ -5,660 +5,5844 @@
  * @date 2026-01-21
  */
 #include "mg6010e.h"
+#include <stdatomic.h>
 
-static mg6010e_handle_t *mg6010e_handle_table[32] = {0}; // 电机句柄表
+#ifndef __weak
+#define __weak __attribute__((weak))
+#endif
+
+_Static_assert((MG6010E_TX_QUEUE_DEPTH & (MG6010E_TX_QUEUE_DEPTH - 1)) == 0, "MG6010E_TX_QUEUE_DEPTH must be a power of 2");
+
+#define MG6010E_TX_QUEUE_MASK (MG6010E_TX_QUEUE_DEPTH - 1)
+#define MG6010E_TX_HELD_NUM (MG6010E_TX_QUEUE_DEPTH > MG6010E_CAN_BATCH_NUM ? MG6010E_TX_QUEUE_DEPTH : MG6010E_CAN_BATCH_NUM) // tx_held的容量
+
+#if MG6010E_USE_DEFERRED_RX
+_Static_assert((MG6010E_RX_RING_DEPTH & (MG6010E_RX_RING_DEPTH - 1)) == 0, "MG6010E_RX_RING_DEPTH must be a power of 2");
+
+#define MG6010E_RX_RING_MASK (MG6010E_RX_RING_DEPTH - 1)
+
+// 接收中断放入队列、待解析的一帧反馈
+typedef struct mg6010e_rx_entry
+{
+    uint32_t timestamp; // 接收时间戳，单位us
+    uint8_t index;      // 电机ID-1
+    uint8_t data[8];    // 反馈数据
+} mg6010e_rx_entry_t;
+#endif
+
+#if MG6010E_USE_TRACE
+_Static_assert((MG6010E_TRACE_DEPTH & (MG6010E_TRACE_DEPTH - 1)) == 0, "MG6010E_TRACE_DEPTH must be a power of 2");
+
+// 跟踪记录，导出时按MG6010E_TRACE_ENTRY_SIZE字节小端序列化
+typedef struct mg6010e_trace_entry
+{
+    uint32_t timestamp; // 时间戳，单位us
+    uint16_t id;        // bit11~13为总线编号，bit0~10为标准帧ID
+    uint8_t opcode;     // 命令字节
+    uint8_t event;      // 事件类型，MG6010E_TRACE_*
+} mg6010e_trace_entry_t;
+
+static mg6010e_trace_entry_t mg6010e_trace_ring[MG6010E_TRACE_DEPTH]; // 跟踪环形缓冲区，写满后覆盖最早的记录
+static _Atomic uint32_t mg6010e_trace_pos;                           // 累计记录数，也是下一条记录的写位置
+
+/**
+ * @brief 写入一条跟踪记录
+ *
+ * @note 可在任务与中断中并发调用，每条记录占用独立的槽位
+ */
+static void mg6010e_trace_record(uint8_t event, uint32_t bus_index, uint32_t std_id, uint8_t opcode, uint32_t timestamp)
+{
+    uint32_t pos = atomic_fetch_add_explicit(&mg6010e_trace_pos, 1, memory_order_relaxed);
+    mg6010e_trace_entry_t *entry = &mg6010e_trace_ring[pos & (MG6010E_TRACE_DEPTH - 1)];
+    entry->timestamp = timestamp;
+    entry->id = (uint16_t)((bus_index << 11) | (std_id & 0x7FF));
+    entry->opcode = opcode;
+    entry->event = event;
+}
+
+#define MG6010E_TRACE(event, bus_index, std_id, opcode, timestamp) mg6010e_trace_record((event), (uint32_t)(bus_index), (std_id), (opcode), (timestamp))
+#else
+#define MG6010E_TRACE(event, bus_index, std_id, opcode, timestamp) ((void)0) // 未启用时不产生任何代码
+#endif
+
+// 发送队列中的一帧命令
+typedef struct mg6010e_tx_frame
+{
+    uint16_t std_id;   // 标准帧ID
+    uint8_t cmd_class; // 命令类别
+    uint8_t data[8];   // 命令数据
+} mg6010e_tx_frame_t;
+
+// 发送队列槽位，sequence用于无锁多生产者/多消费者同步
+typedef struct mg6010e_tx_slot
+{
+    _Atomic uint32_t sequence;
+    mg6010e_tx_frame_t frame;
+} mg6010e_tx_slot_t;
+
+// 每条CAN总线的发送上下文
+typedef struct mg6010e_bus
+{
+    mg6010e_can_t *can_handle;                         // CAN句柄，为NULL表示未使用
+    mg6010e_handle_t *handle_table[32];                // 该总线上的电机句柄表，按电机ID-1索引
+    mg6010e_tx_slot_t tx_slots[MG6010E_TX_QUEUE_DEPTH]; // 发送队列
+    _Atomic uint32_t tx_enqueue_pos;                   // 入队位置
+    _Atomic uint32_t tx_dequeue_pos;                   // 出队位置
+    atomic_flag tx_draining;                           // 是否有上下文正在向邮箱写入
+    mg6010e_can_frame_t tx_held[MG6010E_TX_HELD_NUM];  // 已出队尚未发出的帧（传输层未能发送的帧、为丢弃其后的帧而移出的不可丢弃帧），下次发送时按原顺序最先发出，仅持有tx_draining的上下文访问
+    _Atomic uint32_t tx_held_count;                    // tx_held中的帧数
+    _Atomic uint32_t tx_dropped;                       // 被丢弃的帧数
+#if MG6010E_USE_BUS_BUDGET
+    uint32_t cycle_us;                                 // 预算周期，单位us
+    uint32_t budget_bits;                              // 每周期预算，0表示不限制
+    _Atomic uint32_t reserved_bits;                    // 本周期已准入的帧及其预期回复占用的位数
+    _Atomic uint32_t measured_bits;                    // 本周期实际发送与接收的帧占用的位数
+    uint32_t last_reserved_bits;                       // 上一周期的reserved_bits
+    uint32_t last_measured_bits;                       // 上一周期的measured_bits
+    uint32_t peak_bits;                                // measured_bits的历史最大值
+    _Atomic uint32_t deferred;                         // 推迟发送的累计帧数
+#endif
+#if MG6010E_USE_DEFERRED_RX
+    mg6010e_rx_entry_t rx_ring[MG6010E_RX_RING_DEPTH]; // 待解析帧队列，接收中断为唯一写者，mg6010e_process_pending为唯一读者
+    _Atomic uint32_t rx_head;                          // 写位置
+    _Atomic uint32_t rx_tail;                          // 读位置
+    uint32_t rx_high_water;                            // 待解析帧数的历史最大值
+    uint32_t rx_overrun;                               // 因队列已满丢弃的帧数
+    uint32_t rx_isr_count;                             // 入队的帧数
+    uint32_t rx_isr_last_cycles;                       // 最近一帧入队的耗时
+    uint32_t rx_isr_max_cycles;                        // 单帧入队的最大耗时
+#endif
+#if MG6010E_USE_STATS
+    mg6010e_bus_stats_t stats;                         // 收发统计，tx_dropped与isr_avg_cycles在读取时填入
+    uint64_t isr_cycles_total;                         // 接收中断累计耗时
+#endif
+#if MG6010E_USE_RECORDER
+    uint8_t record_ring[MG6010E_RECORDER_SIZE];        // 遥测记录缓冲区，接收路径为唯一写者，mg6010e_recorder_read为唯一读者
+    _Atomic uint32_t record_head;                      // 写位置
+    _Atomic uint32_t record_tail;                      // 读位置
+    _Atomic uint8_t record_sync;                       // 下一条记录前需写入同步记录
+    uint32_t record_time;                              // 上一条记录的时间戳
+    uint8_t record_ref[32][MG6010E_RECORDER_CLASS_NUM][7]; // 各电机各类反馈上一条记录的数据1~7，按电机ID-1索引
+    mg6010e_recorder_stats_t record_stats;             // 记录统计
+#endif
+#if MG6010E_USE_HEALTH
+    _Atomic uint32_t health_monitored;                 // 检测回复超时的电机位图，按电机ID-1
+    _Atomic uint32_t health_stale;                     // 已锁存回复超时故障的电机位图
+    _Atomic uint32_t health_seen[MG6010E_HEALTH_SLICE_NUM]; // 各时间片内有回复的电机位图，按时间片序号取模索引
+    _Atomic uint32_t health_slice;                     // 当前时间片序号，只由mg6010e_health_tick推进
+    uint32_t health_slice_start;                       // 当前时间片的起始时间戳
+    uint32_t health_window;                            // 超时时间最短的电机的超时时间包含的完整时间片数
+#endif
+} mg6010e_bus_t;
+
+_Static_assert(MG6010E_MAX_CAN_BUS >= 1 && MG6010E_MAX_CAN_BUS <= 7, "MG6010E_MAX_CAN_BUS must be within 1-7");
+_Static_assert(MG6010E_MAX_MOTOR_NUM >= 1 && MG6010E_MAX_MOTOR_NUM <= MG6010E_MAX_CAN_BUS * 32, "MG6010E_MAX_MOTOR_NUM must be within 1-(MG6010E_MAX_CAN_BUS * 32)");
+
+static mg6010e_handle_t mg6010e_handle_pool[MG6010E_MAX_MOTOR_NUM]; // 电机句柄静态池，initialized为0表示空闲
+static mg6010e_bus_t mg6010e_bus_table[MG6010E_MAX_CAN_BUS];       // 总线表
+#if MG6010E_USE_HAL
+static const mg6010e_transport_t *mg6010e_transport = &mg6010e_hal_transport; // 传输层
+#else
+static const mg6010e_transport_t *mg6010e_transport = NULL; // 传输层，需通过mg6010e_set_transport设置
+#endif
+static uint8_t mg6010e_tx_policy[MG6010E_CMD_CLASS_NUM] = {
+    [MG6010E_CMD_CLASS_SETPOINT] = MG6010E_TX_POLICY_DROP_OLDEST,
+    [MG6010E_CMD_CLASS_READ] = MG6010E_TX_POLICY_DROP_OLDEST,
+    [MG6010E_CMD_CLASS_CONFIG] = MG6010E_TX_POLICY_NEVER_DROP,
+}; // 各命令类别的丢弃策略
+
+#if MG6010E_USE_SOA_TELEMETRY
+// 按电机ID连续存放的遥测数据（结构体数组转为数组结构体），下标为电机ID-1，便于一次线性扫描读取所有电机
+typedef struct mg6010e_telemetry
+{
+    int16_t speed[32];                   // 电机实际速度
+    int16_t iqActual[32];                // 实际转矩电流
+    uint16_t encoder[32];                // 编码器值
+    int8_t temperature[32];              // 电机温度
+    int64_t angle[32];                   // 多圈角度
+    _Atomic uint32_t angle_sequence[32]; // 多圈角度的顺序锁计数
+} mg6010e_telemetry_t;
+
+static mg6010e_telemetry_t mg6010e_telemetry[MG6010E_MAX_CAN_BUS]; // 各总线的遥测数据
+
+/**
+ * @brief 在接收中断中更新多圈角度，使用顺序锁避免读到写了一半的64位数据
+ */
+static inline void mg6010e_telemetry_set_angle(mg6010e_telemetry_t *telemetry, uint32_t index, int64_t angle)
+{
+    uint32_t seq = atomic_load_explicit(&telemetry->angle_sequence[index], memory_order_relaxed);
+    atomic_store_explicit(&telemetry->angle_sequence[index], seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    telemetry->angle[index] = angle;
+    atomic_store_explicit(&telemetry->angle_sequence[index], seq + 2, memory_order_release);
+}
+#endif /* MG6010E_USE_SOA_TELEMETRY */
+
+#if MG6010E_USE_POLL_SCHEDULER
+// 自动轮询项
+typedef struct mg6010e_poll_item
+{
+    uint16_t period;    // 轮询周期，单位tick，0表示未启用
+    uint16_t phase;     // 在负载窗口中的相位，单位tick
+    uint16_t countdown; // 距下次轮询的tick数
+} mg6010e_poll_item_t;
+
+// 每个电机的自动轮询状态
+typedef struct mg6010e_poll
+{
+    mg6010e_poll_item_t items[MG6010E_POLL_ITEM_NUM];
+    uint8_t setpoint_sent; // 自上次轮询状态2以来是否发送过控制命令
+} mg6010e_poll_t;
+
+static mg6010e_poll_t mg6010e_poll_table[MG6010E_MAX_MOTOR_NUM];             // 与句柄池一一对应
+static uint8_t mg6010e_poll_load[MG6010E_MAX_CAN_BUS][MG6010E_POLL_WINDOW]; // 负载窗口内每个tick已安排的读取帧数
+static uint32_t mg6010e_poll_tick_count;                                     // 全局tick计数
+static uint8_t mg6010e_poll_first[MG6010E_MAX_CAN_BUS];                      // 各总线下一个tick最先发出读取请求的句柄序号
+
+// 每条总线每个tick最多发出的读取请求数：按最坏情况的帧长，读取命令及其回复不超过一个tick的总线容量
+#define MG6010E_POLL_TICK_READS                                                                          \
+    (MG6010E_CAN_BITRATE / MG6010E_POLL_TICK_HZ >= 2U * MG6010E_CAN_FRAME_BITS_MAX(8)                     \
+         ? (uint32_t)(MG6010E_CAN_BITRATE / MG6010E_POLL_TICK_HZ / (2U * MG6010E_CAN_FRAME_BITS_MAX(8))) \
+         : 1U)
+
+static void mg6010e_poll_release(mg6010e_handle_t *mg6010e_handle);
+#endif /* MG6010E_USE_POLL_SCHEDULER */
+
+#if MG6010E_USE_ADAPTIVE_POLL
+_Static_assert(MG6010E_USE_POLL_SCHEDULER, "MG6010E_USE_ADAPTIVE_POLL requires MG6010E_USE_POLL_SCHEDULER");
+
+// 每个电机的自适应轮询状态，峰值由接收路径写入，由mg6010e_poll_adapt取走并清零
+typedef struct mg6010e_adapt
+{
+    uint8_t adaptive;                          // 自适应轮询项的位图
+    uint16_t min_hz[MG6010E_POLL_ITEM_NUM];    // 最低频率
+    uint16_t max_hz[MG6010E_POLL_ITEM_NUM];    // 最高频率
+    uint16_t demand_hz[MG6010E_POLL_ITEM_NUM]; // 期望频率
+    uint16_t activity[MG6010E_POLL_ITEM_NUM];  // 活动度，单位0.1%
+    _Atomic uint32_t samples;                  // 自上次调整以来收到的带转速与转矩电流的反馈数（0x9C、0xA1~0xA8）
+    _Atomic uint32_t speed_peak;               // 自上次调整以来转速绝对值的最大值，单位dps
+    _Atomic uint32_t slew_peak;                // 自上次调整以来转矩电流变化率的最大值，单位LSB/s
+    _Atomic uint32_t iq_peak;                  // 自上次调整以来转矩电流绝对值的最大值
+    _Atomic uint8_t error_state;               // 最近一次状态1回复（0x9A、0x9B）中的errorState
+    int16_t last_iq;                           // 上一次的转矩电流，只由接收路径读写
+    uint32_t last_iq_time;                     // 上一次转矩电流的时间戳，单位us
+    uint8_t iq_valid;                          // last_iq是否有效
+    uint32_t sample_tick;                      // 最近一次有反馈的调整时的tick计数
+} mg6010e_adapt_t;
+
+static mg6010e_adapt_t mg6010e_adapt_table[MG6010E_MAX_MOTOR_NUM];    // 与句柄池一一对应
+static uint8_t mg6010e_adapt_budget_percent[MG6010E_MAX_CAN_BUS];       // 各总线的轮询预算，0表示MG6010E_POLL_BUDGET_PERCENT
+static mg6010e_poll_budget_t mg6010e_adapt_budget[MG6010E_MAX_CAN_BUS]; // 各总线最近一次调整的结果
+#endif /* MG6010E_USE_ADAPTIVE_POLL */
+
+#if MG6010E_USE_REQUEST_TRACKING
+// 请求槽位状态
+#define MG6010E_REQUEST_FREE 0    // 空闲
+#define MG6010E_REQUEST_FILLING 1 // 正在登记
+#define MG6010E_REQUEST_PENDING 2 // 等待回复
+
+// 等待回复的请求，按（电机，命令字节，参数ID）匹配回复
+typedef struct mg6010e_request
+{
+    _Atomic uint8_t state; // 槽位状态
+    uint8_t cmd;           // 命令字节
+    uint8_t param_id;      // 控制参数ID，非0xC0/0xC1命令为0
+    uint32_t sent_time;    // 发送时间戳，单位us
+} mg6010e_request_t;
+
+// 每个电机的请求跟踪状态
+typedef struct mg6010e_request_state
+{
+    mg6010e_request_t pending[MG6010E_REQUEST_PENDING_NUM]; // 等待回复的请求
+    mg6010e_latency_stats_t stats;                          // 往返延迟统计
+} mg6010e_request_state_t;
+
+static mg6010e_request_state_t mg6010e_request_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+static mg6010e_request_callback_t mg6010e_request_callback = NULL;           // 请求完成回调
+static uint32_t mg6010e_request_timeout_us = MG6010E_REQUEST_TIMEOUT_US;     // 请求超时时间
+static uint8_t mg6010e_request_tracked[MG6010E_CMD_CLASS_NUM] = {
+    [MG6010E_CMD_CLASS_READ] = 1,
+    [MG6010E_CMD_CLASS_CONFIG] = 1,
+}; // 各命令类别是否登记请求
+#endif /* MG6010E_USE_REQUEST_TRACKING */
+
+#if MG6010E_USE_STATS
+static mg6010e_motor_stats_t mg6010e_motor_stats_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+#endif
+
+#if MG6010E_USE_TRAJECTORY
+// 换算为tick的轨迹路点
+typedef struct mg6010e_traj_knot
+{
+    uint32_t tick;    // 相对起点的tick数
+    int32_t value;    // 路点值
+    int32_t velocity; // 路点速度，单位0.01dps
+} mg6010e_traj_knot_t;
+
+// 每个电机的轨迹状态，由mg6010e_traj_tick写入，接收中断只读取设定值并写入跟踪误差统计
+typedef struct mg6010e_traj
+{
+    mg6010e_traj_config_t config;
+    mg6010e_traj_knot_t knots[MG6010E_TRAJ_POINT_NUM];
+    uint8_t count;         // 路点数
+    uint8_t segment;       // 当前段起点的路点序号
+    uint8_t start_pending; // 为1时在下一次tick启动
+    _Atomic uint8_t state; // 轨迹状态
+    uint16_t period;       // 发送周期，单位tick
+    uint32_t tick;         // 自启动起的tick数
+    uint32_t inv_duration; // 当前段：UINT32_MAX / 段时长，用乘法代替每tick一次的除法
+    int32_t delta;         // 当前段：终点值 - 起点值
+    int32_t m0;            // 当前段：三次插值的起点切线（路点速度 × 段时长），单位同路点值
+    int32_t m1;            // 当前段：三次插值的终点切线
+    uint32_t speed_scale;  // 当前段：将对归一化时间的导数换算为dps的系数，Q24
+    int32_t cmd_value;     // 最近发出的设定值
+    int32_t cmd_speed;     // 最近发出设定值处的轨迹速度，单位dps
+    mg6010e_traj_stats_t stats;
+} mg6010e_traj_t;
+
+static mg6010e_traj_t mg6010e_traj_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+#endif /* MG6010E_USE_TRAJECTORY */
+
+#if MG6010E_USE_COALESCE
+// 待发槽位sequence的低两位，其余位为写入计数
+#define MG6010E_COALESCE_WRITING 1U // 正在写入，由写者以CAS置位，同一电机的另一写者返回MG6010E_ERROR_BUSY
+#define MG6010E_COALESCE_PENDING 2U // 有待发命令，由写者置位，mg6010e_coalesce_flush以CAS清除
+
+// 每个电机的控制命令待发槽位，写者为控制命令接口，读者为mg6010e_coalesce_flush
+typedef struct mg6010e_coalesce
+{
+    mg6010e_tx_slot_t slot;         // 待发命令
+    uint8_t last_data[8];           // 最近发出的命令数据
+    uint8_t last_valid;             // last_data是否有效
+    uint32_t last_cycle;            // 最近发出命令时的mg6010e_coalesce_cycle
+    mg6010e_coalesce_stats_t stats; // written与overwritten由写者更新，其余由mg6010e_coalesce_flush更新
+} mg6010e_coalesce_t;
+
+static mg6010e_coalesce_t mg6010e_coalesce_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+static uint8_t mg6010e_coalesce_skip_unchanged = 0;                       // 是否跳过与上次发出相同的命令
+static uint16_t mg6010e_coalesce_keepalive = 0;                           // 相同命令至少每隔多少周期重发一次，0表示不重发
+static uint32_t mg6010e_coalesce_cycle = 0;                               // mg6010e_coalesce_flush的调用次数
+#endif /* MG6010E_USE_COALESCE */
+
+#if MG6010E_USE_PARAMS_SNAPSHOT
+// 单个控制参数在快照/恢复中的阶段
+#define MG6010E_PARAMS_IDLE 0       // 不参与
+#define MG6010E_PARAMS_WRITE 1      // 等待发送0xC1
+#define MG6010E_PARAMS_WRITE_SENT 2 // 等待0xC1回复
+#define MG6010E_PARAMS_READ 3       // 等待发送0xC0
+#define MG6010E_PARAMS_READ_SENT 4  // 等待0xC0回复
+#define MG6010E_PARAMS_DONE 5       // 已完成
+#define MG6010E_PARAMS_FAILED 6     // 重发MG6010E_PARAMS_RETRY次后仍无回复
+#define MG6010E_PARAMS_MISMATCH 7   // 恢复：读回值与写入值不一致
+
+// 快照/恢复的操作
+#define MG6010E_PARAMS_OP_NONE 0
+#define MG6010E_PARAMS_OP_SNAPSHOT 1
+#define MG6010E_PARAMS_OP_RESTORE 2
+
+// 每个电机的快照/恢复状态，value与两个掩码由接收中断写入，其余仅在任务上下文中访问
+typedef struct mg6010e_params_entry
+{
+    uint8_t value[MG6010E_PARAMS_NUM][6];   // 0xC0回复的数据2~7
+    uint8_t target[MG6010E_PARAMS_NUM][6];  // 恢复：要写入的数据
+    _Atomic uint8_t read_mask;              // bit n：收到第n个参数的0xC0回复
+    _Atomic uint8_t write_mask;             // bit n：收到第n个参数的0xC1回复
+    uint8_t stage[MG6010E_PARAMS_NUM];      // 各参数的阶段，MG6010E_PARAMS_IDLE等
+    uint8_t attempts[MG6010E_PARAMS_NUM];   // 当前阶段已发送的次数
+    uint32_t sent_time[MG6010E_PARAMS_NUM]; // 最近一次发送的时间戳，单位us
+} mg6010e_params_entry_t;
+
+static mg6010e_params_entry_t mg6010e_params_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+static const uint8_t mg6010e_params_id[MG6010E_PARAMS_NUM] = {0x0A, 0x0B, 0x0C, 0x1E, 0x20, 0x22, 0x24, 0x26};
+static uint8_t mg6010e_params_op = MG6010E_PARAMS_OP_NONE;  // 当前或最近一次操作
+static uint8_t mg6010e_params_result = MG6010E_SUCCESS;     // 操作结果，进行中为MG6010E_ERROR_BUSY
+static uint32_t mg6010e_params_start_time;                  // 开始时间戳，单位us
+static uint32_t mg6010e_params_elapsed_us;                  // 结束时的耗时
+#endif /* MG6010E_USE_PARAMS_SNAPSHOT */
+
+#if MG6010E_USE_ENCODER_UNWRAP
+_Static_assert(MG6010E_ENCODER_BITS >= 14 && MG6010E_ENCODER_BITS <= 16, "MG6010E_ENCODER_BITS must be within 14-16");
+
+// 每个电机的编码器累计状态，接收路径为唯一写者
+typedef struct mg6010e_unwrap
+{
+    _Atomic uint32_t sequence; // 顺序锁计数，奇数表示接收路径正在写入
+    uint8_t primed;            // 是否已有编码器采样
+    uint8_t resync;            // 编码器零点已改变，下一次采样不计入增量
+    uint8_t anchored;          // 是否已校准
+    uint8_t anchor_pending;    // 收到多圈角度时累计计数已过时，待下一次采样时校准
+    uint16_t last_encoder;     // 上一次的编码器值
+    uint32_t last_time;        // 上一次采样的时间戳，单位us
+    uint32_t samples;          // 累计的编码器采样数
+    int64_t counts;            // 累计的编码器计数
+    int64_t anchor_counts;     // 校准时的累计计数
+    int64_t anchor_angle;      // 校准时的多圈角度，单位0.01°
+    int64_t pending_angle;     // 待校准的多圈角度，单位0.01°
+    uint32_t pending_time;     // 待校准的多圈角度的接收时间戳，单位us
+    int32_t delta_avg;         // 每次采样计数增量的滑动平均，Q8
+    int32_t interval_avg;      // 采样间隔的滑动平均，单位us，Q8
+    uint32_t anchors;          // 校准次数
+    int32_t last_correction;   // 最近一次校准差，单位0.01°
+    uint32_t max_correction;   // 校准差绝对值的最大值
+} mg6010e_unwrap_t;
+
+static mg6010e_unwrap_t mg6010e_unwrap_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+#endif /* MG6010E_USE_ENCODER_UNWRAP */
+
+#if MG6010E_USE_GROUP
+// 每个电机在命令组中暂存的控制命令
+typedef struct mg6010e_group_entry
+{
+    mg6010e_tx_slot_t slot;       // 暂存的命令，只使用frame
+    uint8_t staged;               // 本组是否已暂存命令
+    mg6010e_tx_slot_t *claimed;   // 提交时在发送队列中占用的槽位
+    _Atomic uint32_t await_cycle; // 等待回复的命令组序号，0表示不等待
+} mg6010e_group_entry_t;
+
+static mg6010e_group_entry_t mg6010e_group_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+static uint8_t mg6010e_group_open;                                       // 是否处于mg6010e_group_begin与提交之间
+static _Atomic uint32_t mg6010e_group_cycle;                             // 最近一次提交的命令组序号，从1开始
+static uint32_t mg6010e_group_commit_time;                               // 最近一次提交的时间戳，单位us
+static uint8_t mg6010e_group_motors;                                     // 最近一次提交的电机数
+static _Atomic uint32_t mg6010e_group_replies;                           // 最近一次提交已收到的回复数
+static _Atomic uint32_t mg6010e_group_first;                             // 第一帧回复相对提交的时间，单位us
+static _Atomic uint32_t mg6010e_group_last;                              // 最后一帧回复相对提交的时间，单位us
+static _Atomic uint8_t mg6010e_group_closed = 1;                         // 最近一次提交的偏差是否已计入统计
+static mg6010e_group_stats_t mg6010e_group_stats;                        // 命令组统计
+static uint32_t mg6010e_group_complete;                                  // 回复齐全的命令组数
+static uint64_t mg6010e_group_skew_total;                                // 回复齐全的命令组的偏差之和
+#endif /* MG6010E_USE_GROUP */
+
+#if MG6010E_USE_HEALTH
+_Static_assert((MG6010E_HEALTH_SLICE_NUM & (MG6010E_HEALTH_SLICE_NUM - 1)) == 0, "MG6010E_HEALTH_SLICE_NUM must be a power of 2");
+
+// 每个电机的健康监测状态
+typedef struct mg6010e_health_entry
+{
+    mg6010e_health_config_t config; // 监测配置
+    uint8_t enabled;                // 是否监测
+    _Atomic uint32_t last_reply;    // 最近一次回复的时间戳，开始监测时为当时的时间戳
+    uint32_t max_interval;          // 相邻两次回复间隔的最大值，接收路径为唯一写者
+    _Atomic uint8_t faults;         // 已锁存的故障
+    uint32_t fault_time;            // 最近一次由无故障变为有故障的时间戳
+    uint32_t trips;                 // 由无故障变为有故障的次数
+    uint8_t reaction_result;        // 最近一次故障动作的发送结果
+} mg6010e_health_entry_t;
+
+static mg6010e_health_entry_t mg6010e_health_table[MG6010E_MAX_MOTOR_NUM]; // 与句柄池一一对应
+static mg6010e_health_callback_t mg6010e_health_callback = NULL;            // 故障回调
+
+/**
+ * @brief 电机是否因故障锁存而拒绝控制命令（仅配置了故障动作的电机）
+ */
+static inline uint8_t mg6010e_health_blocked(const mg6010e_handle_t *mg6010e_handle)
+{
+    const mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    return entry->config.reaction != MG6010E_HEALTH_REACT_NONE && atomic_load_explicit(&entry->faults, memory_order_relaxed) != 0;
+}
+
+/**
+ * @brief 按总线上检测回复超时的电机中最短的超时时间重新计算时间片窗口
+ */
+static void mg6010e_health_update_window(mg6010e_bus_t *bus)
+{
+    uint32_t window = MG6010E_HEALTH_SLICE_NUM;
+    uint32_t monitored = atomic_load_explicit(&bus->health_monitored, memory_order_relaxed);
+    for (uint32_t index = 0; index < 32; index++)
+    {
+        if ((monitored & (1UL << index)) && bus->handle_table[index] != NULL)
+        {
+            uint32_t slices = mg6010e_health_table[bus->handle_table[index] - mg6010e_handle_pool].config.timeout_us / MG6010E_HEALTH_SLICE_US;
+            window = slices < window ? slices : window;
+        }
+    }
+    bus->health_window = window;
+}
+
+/**
+ * @brief 停止监测电机并清除其健康状态
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param bus 电机所在总线
+ * @param motor_id 电机ID（1-32）
+ */
+static void mg6010e_health_release(mg6010e_handle_t *mg6010e_handle, mg6010e_bus_t *bus, uint32_t motor_id)
+{
+    atomic_fetch_and_explicit(&bus->health_monitored, ~(1UL << (motor_id - 1)), memory_order_relaxed);
+    atomic_fetch_and_explicit(&bus->health_stale, ~(1UL << (motor_id - 1)), memory_order_relaxed);
+    memset(&mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_health_entry_t));
+}
+#endif /* MG6010E_USE_HEALTH */
+
+/**
+ * @brief 设置驱动使用的CAN传输层
+ *
+ * @param transport 传输层，需在程序运行期间保持有效
+ * @note 需在mg6010e_init之前调用，所有总线共用同一传输层。MG6010E_USE_HAL为1时默认为mg6010e_hal_transport。
+ */
+void mg6010e_set_transport(const mg6010e_transport_t *transport)
+{
+    mg6010e_transport = transport;
+}
+
+/**
+ * @brief 通过CAN句柄查找总线上下文
+ *
+ * @param can_handle CAN句柄
+ * @return mg6010e_bus_t* 总线上下文指针，未注册则返回NULL
+ */
+static mg6010e_bus_t *mg6010e_get_bus(mg6010e_can_t *can_handle)
+{
+    if (can_handle == NULL)
+    {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS; i++)
+    {
+        if (mg6010e_bus_table[i].can_handle == can_handle)
+        {
+            return &mg6010e_bus_table[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 注册CAN总线，已注册则直接返回
+ *
+ * @param can_handle CAN句柄
+ * @return mg6010e_bus_t* 总线上下文指针，总线表已满则返回NULL
+ * @note 总线编号按首次注册的顺序从0开始分配。仅在初始化阶段调用，不可与发送并发
+ */
+static mg6010e_bus_t *mg6010e_register_bus(mg6010e_can_t *can_handle)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus != NULL)
+    {
+        return bus;
+    }
+    for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS && bus == NULL; i++)
+    {
+        if (mg6010e_bus_table[i].can_handle == NULL)
+        {
+            bus = &mg6010e_bus_table[i];
+        }
+    }
+    if (bus == NULL)
+    {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH; i++)
+    {
+        atomic_init(&bus->tx_slots[i].sequence, i);
+    }
+    atomic_init(&bus->tx_enqueue_pos, 0);
+    atomic_init(&bus->tx_dequeue_pos, 0);
+    atomic_flag_clear(&bus->tx_draining);
+    atomic_init(&bus->tx_held_count, 0);
+    atomic_init(&bus->tx_dropped, 0);
+    memset(bus->handle_table, 0, sizeof(bus->handle_table));
+#if MG6010E_USE_BUS_BUDGET
+    bus->cycle_us = 0;
+    bus->budget_bits = 0;
+    atomic_init(&bus->reserved_bits, 0);
+    atomic_init(&bus->measured_bits, 0);
+    bus->last_reserved_bits = 0;
+    bus->last_measured_bits = 0;
+    bus->peak_bits = 0;
+    atomic_init(&bus->deferred, 0);
+#endif
+#if MG6010E_USE_DEFERRED_RX
+    atomic_init(&bus->rx_head, 0);
+    atomic_init(&bus->rx_tail, 0);
+    bus->rx_high_water = 0;
+    bus->rx_overrun = 0;
+    bus->rx_isr_count = 0;
+    bus->rx_isr_last_cycles = 0;
+    bus->rx_isr_max_cycles = 0;
+#endif
+#if MG6010E_USE_STATS
+    bus->stats = (mg6010e_bus_stats_t){0};
+    bus->isr_cycles_total = 0;
+#endif
+    bus->can_handle = can_handle;
+    return bus;
+}
+
+/**
+ * @brief 获取CAN总线的编号
+ *
+ * @param can_handle CAN句柄
+ * @return int8_t 总线编号（0 ~ MG6010E_MAX_CAN_BUS-1），按该总线上第一个电机初始化的顺序分配，未注册则返回-1
+ * @note 与MG6010E_MOTOR配合使用，用于寻址非第0条总线上的电机
+ */
+int8_t mg6010e_get_bus_index(mg6010e_can_t *can_handle)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return -1;
+    }
+    return (int8_t)(bus - mg6010e_bus_table);
+}
+
+/**
+ * @brief 从发送队列头部取出一帧
+ *
+ * @param bus 总线上下文
+ * @param frame 取出的帧，为NULL时仅丢弃
+ * @param droppable_only 为1时仅当队头命令类别的策略为MG6010E_TX_POLICY_DROP_OLDEST时才取出
+ * @return uint8_t 1表示取出成功，0表示队列为空或队头不可丢弃
+ * @note 可在任务与中断中并发调用
+ */
+static uint8_t mg6010e_tx_dequeue(mg6010e_bus_t *bus, mg6010e_tx_frame_t *frame, uint8_t droppable_only)
+{
+    uint32_t pos = atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        mg6010e_tx_slot_t *slot = &bus->tx_slots[pos & MG6010E_TX_QUEUE_MASK];
+        uint32_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - (pos + 1));
+        if (diff < 0)
+        {
+            return 0; // 队列为空
+        }
+        if (diff == 0)
+        {
+            if (droppable_only && mg6010e_tx_policy[slot->frame.cmd_class] != MG6010E_TX_POLICY_DROP_OLDEST)
+            {
+                return 0; // 队头命令不允许丢弃
+            }
+            if (atomic_compare_exchange_weak_explicit(&bus->tx_dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                if (frame != NULL)
+                {
+                    *frame = slot->frame;
+                }
+                atomic_store_explicit(&slot->sequence, pos + MG6010E_TX_QUEUE_DEPTH, memory_order_release);
+                return 1;
+            }
+        }
+        else
+        {
+            pos = atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 将发送队列中的一帧转为传输层的帧格式，追加到tx_held末尾
+ * @note 仅在持有tx_draining的上下文中调用
+ */
+static inline void mg6010e_tx_hold(mg6010e_bus_t *bus, const mg6010e_tx_frame_t *frame)
+{
+    uint32_t count = atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed);
+    bus->tx_held[count].std_id = frame->std_id;
+    bus->tx_held[count].dlc = 8;
+    memcpy(bus->tx_held[count].data, frame->data, 8);
+    atomic_store_explicit(&bus->tx_held_count, count + 1, memory_order_relaxed);
+}
+
+/**
+ * @brief 统计发送队列中可为新命令腾出的槽位数，即mg6010e_tx_evict可丢弃的帧数
+ *
+ * @param bus 总线上下文
+ * @return uint32_t 最早入队的不可丢弃帧移入tx_held后，仍可丢弃的帧数
+ * @note 只读，结果可能因其他上下文并发入队、出队而过时
+ */
+static uint32_t mg6010e_tx_evictable(mg6010e_bus_t *bus)
+{
+    uint32_t room = MG6010E_TX_HELD_NUM - atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed);
+    uint32_t pos = atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed);
+    uint32_t end = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed);
+    uint32_t kept = 0;  // 需移入tx_held的不可丢弃帧数
+    uint32_t count = 0; // 可丢弃帧数
+    for (; pos != end; pos++)
+    {
+        mg6010e_tx_slot_t *slot = &bus->tx_slots[pos & MG6010E_TX_QUEUE_MASK];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != pos + 1)
+        {
+            break; // 尚未发布或已被取出
+        }
+        if (mg6010e_tx_policy[slot->frame.cmd_class] == MG6010E_TX_POLICY_DROP_OLDEST)
+        {
+            count += kept <= room;
+        }
+        else
+        {
+            kept++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 丢弃发送队列中最早入队的可丢弃帧，为新命令腾出一个槽位
+ *
+ * @param bus 总线上下文
+ * @return uint8_t 1表示已丢弃一帧并计入丢弃数，0表示没有可丢弃的帧，或队头不可丢弃且其他上下文正在发送
+ * @note 队头可丢弃时直接丢弃，可在任务与中断中并发调用。队头不可丢弃时，在持有tx_draining期间将可丢弃帧之前的不可丢弃帧
+ * 按原顺序移入tx_held（下次发送时最先发出，与队列中其余帧的先后顺序不变），再丢弃该可丢弃帧；tx_held容纳不下时不移动任何帧。
+ * 只有持有tx_draining的上下文会取出不可丢弃的队头，因此查找期间这些帧保持在原位。
+ */
+static uint8_t mg6010e_tx_evict(mg6010e_bus_t *bus)
+{
+    if (mg6010e_tx_dequeue(bus, NULL, 1))
+    {
+        atomic_fetch_add_explicit(&bus->tx_dropped, 1, memory_order_relaxed);
+        return 1;
+    }
+    if (atomic_flag_test_and_set_explicit(&bus->tx_draining, memory_order_acquire))
+    {
+        return 0; // 被抢占的上下文正在发送，队头即将取出
+    }
+    uint8_t dropped = 0;
+    if (mg6010e_tx_evictable(bus) != 0)
+    {
+        mg6010e_tx_frame_t frame;
+        while (atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed) < MG6010E_TX_HELD_NUM && mg6010e_tx_dequeue(bus, &frame, 0))
+        {
+            if (mg6010e_tx_policy[frame.cmd_class] == MG6010E_TX_POLICY_DROP_OLDEST)
+            {
+                atomic_fetch_add_explicit(&bus->tx_dropped, 1, memory_order_relaxed);
+                dropped = 1;
+                break;
+            }
+            mg6010e_tx_hold(bus, &frame);
+        }
+    }
+    atomic_flag_clear_explicit(&bus->tx_draining, memory_order_release);
+    return dropped;
+}
+
+/**
+ * @brief 在发送队列尾部占用一个槽位
+ *
+ * @param bus 总线上下文
+ * @return mg6010e_tx_slot_t* 占用的槽位，NULL表示队列已满且无法丢弃任何帧
+ * @note 队列满时由mg6010e_tx_evict丢弃最早入队的可丢弃帧后重试，可在任务与中断中并发调用。
+ * 调用者直接在槽位中编码命令，再通过mg6010e_tx_publish交给消费者，发布前该槽位之后的帧不会被取出，因此两者之间不应有耗时操作
+ */
+static mg6010e_tx_slot_t *mg6010e_tx_claim(mg6010e_bus_t *bus)
+{
+    uint32_t pos = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        mg6010e_tx_slot_t *slot = &bus->tx_slots[pos & MG6010E_TX_QUEUE_MASK];
+        uint32_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&bus->tx_enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                return slot;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 队列已满，尝试丢弃最早入队的可丢弃命令
+            if (!mg6010e_tx_evict(bus) && atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed) + MG6010E_TX_QUEUE_DEPTH == pos)
+            {
+                return NULL;
+            }
+            pos = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed);
+        }
+        else
+        {
+            pos = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 发布由mg6010e_tx_claim占用并已写好的槽位
+ */
+static inline void mg6010e_tx_publish(mg6010e_tx_slot_t *slot)
+{
+    uint32_t seq = atomic_load_explicit(&slot->sequence, memory_order_relaxed); // 占用期间仅本上下文访问该槽位
+    atomic_store_explicit(&slot->sequence, seq + 1, memory_order_release);
+}
+
+/**
+ * @brief 判断本周期的总线预算是否还能准入一条命令
+ *
+ * @param bus 总线上下文
+ * @param staged 已出队、尚未发出而未计入预算的帧数
+ * @return uint8_t 1表示准入，0表示推迟到下一周期
+ * @note 按一条命令及其回复估算，0x280广播帧的实际占用在发出后计入，预算最多被超出3帧回复
+ */
+static inline uint8_t mg6010e_tx_admit(mg6010e_bus_t *bus, uint32_t staged)
+{
+#if MG6010E_USE_BUS_BUDGET
+    return bus->budget_bits == 0 ||
+           atomic_load_explicit(&bus->reserved_bits, memory_order_relaxed) + (staged + 1) * 2 * MG6010E_CAN_FRAME_BITS_MAX(8) <= bus->budget_bits;
+#else
+    (void)bus;
+    (void)staged;
+    return 1;
+#endif
+}
+
+/**
+ * @brief 将传输层已发出的帧及其预期回复计入本周期的预算
+ *
+ * @param bus 总线上下文
+ * @param frames 已发出的帧
+ * @param sent 帧数
+ */
+static inline void mg6010e_tx_reserve(mg6010e_bus_t *bus, const mg6010e_can_frame_t *frames, uint32_t sent)
+{
+#if MG6010E_USE_BUS_BUDGET
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < sent; i++)
+    {
+        uint32_t replies = frames[i].std_id == MG6010E_CAN_MULTI_IQ_ID ? MG6010E_CAN_MULTI_IQ_MOTOR_NUM : 1;
+        bits += (1 + replies) * MG6010E_CAN_FRAME_BITS_MAX(8);
+    }
+    atomic_fetch_add_explicit(&bus->reserved_bits, bits, memory_order_relaxed);
+#else
+    (void)bus;
+    (void)frames;
+    (void)sent;
+#endif
+}
+
+/**
+ * @brief 将交给传输层的帧计入本周期的总线负载
+ */
+static inline void mg6010e_tx_measure(mg6010e_bus_t *bus, uint32_t count)
+{
+#if MG6010E_USE_BUS_BUDGET
+    atomic_fetch_add_explicit(&bus->measured_bits, count * MG6010E_CAN_FRAME_BITS_MAX(8), memory_order_relaxed);
+#else
+    (void)bus;
+    (void)count;
+#endif
+}
+
+/**
+ * @brief 统计并跟踪交给传输层的一批帧
+ *
+ * @param bus 总线上下文
+ * @param frames 交给传输层的帧
+ * @param count 帧数
+ * @param sent 传输层成功发送的帧数
+ * @note 仅在发送上下文（持有tx_draining）中调用
+ */
+static inline void mg6010e_tx_record(mg6010e_bus_t *bus, const mg6010e_can_frame_t *frames, uint32_t count, uint32_t sent)
+{
+#if MG6010E_USE_STATS
+    bus->stats.tx_frames += sent;
+    bus->stats.tx_failures += count - sent;
+    for (uint32_t i = 0; i < sent; i++)
+    {
+        uint32_t index = frames[i].std_id - (MG6010E_CAN_CMD_BASE_ID + 1);
+        if (index < 32 && bus->handle_table[index] != NULL)
+        {
+            mg6010e_motor_stats_table[bus->handle_table[index] - mg6010e_handle_pool].tx_frames++;
+        }
+    }
+#endif
+#if MG6010E_USE_TRACE
+    uint32_t timestamp = mg6010e_get_timestamp_us();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        MG6010E_TRACE(i < sent ? MG6010E_TRACE_TX : MG6010E_TRACE_TX_FAIL, bus - mg6010e_bus_table, frames[i].std_id, frames[i].data[0], timestamp);
+    }
+#endif
+    (void)bus;
+    (void)frames;
+    (void)count;
+    (void)sent;
+}
+
+/**
+ * @brief 将发送队列中的帧交给传输层发送
+ *
+ * @param bus 总线上下文
+ * @note 同一时刻只有一个上下文写邮箱，被抢占的一方在释放后会重新检查队列，保证不会遗留帧。
+ * 每次最多取出MG6010E_CAN_BATCH_NUM帧一并交给传输层。传输层只发出其中一部分时（如邮箱写入失败、网卡队列已满），
+ * 未发出的帧按原顺序保留在tx_held中，不计入丢弃数，在下一次发送（下一条命令、发送完成回调或mg6010e_bus_budget_tick）时最先发出。
+ * 启用MG6010E_USE_BUS_BUDGET时只有传输层已发出的帧计入预算，本周期预算用尽后剩余的帧留在队列中，由mg6010e_bus_budget_tick在下一周期发出。
+ */
+static void mg6010e_tx_drain(mg6010e_bus_t *bus)
+{
+    uint8_t busy = 0; // 传输层报告有空位却未能发出全部帧，本次不再重试
+    do
+    {
+        if (atomic_flag_test_and_set_explicit(&bus->tx_draining, memory_order_acquire))
+        {
+            return; // 被抢占的上下文正在发送，由其负责清空队列
+        }
+        uint32_t room;
+        while (!busy && (room = mg6010e_transport->tx_free(bus->can_handle)) > 0)
+        {
+            mg6010e_can_frame_t *frames = bus->tx_held; // 上次未发出的帧在前，新出队的帧追加在后
+            uint32_t count = atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed);
+            mg6010e_tx_frame_t frame;
+            while (count < room && count < MG6010E_CAN_BATCH_NUM && mg6010e_tx_admit(bus, count) && mg6010e_tx_dequeue(bus, &frame, 0))
+            {
+                frames[count].std_id = frame.std_id;
+                frames[count].dlc = 8;
+                memcpy(frames[count].data, frame.data, 8);
+                count++;
+            }
+            uint32_t batch = 0; // tx_held中可能有多于一批、未经预算准入的帧（mg6010e_tx_evict移入）
+            while (batch < count && batch < room && batch < MG6010E_CAN_BATCH_NUM && mg6010e_tx_admit(bus, batch))
+            {
+                batch++;
+            }
+            if (batch == 0)
+            {
+                break;
+            }
+            uint32_t sent = mg6010e_transport->send(bus->can_handle, frames, batch);
+            mg6010e_tx_reserve(bus, frames, sent);
+            mg6010e_tx_measure(bus, sent);
+            mg6010e_tx_record(bus, frames, batch, sent);
+            memmove(frames, frames + sent, (count - sent) * sizeof(mg6010e_can_frame_t));
+            atomic_store_explicit(&bus->tx_held_count, count - sent, memory_order_relaxed);
+            busy = sent < batch;
+        }
+        atomic_flag_clear_explicit(&bus->tx_draining, memory_order_release);
+    } while (!busy &&
+             (atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed) != atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed) ||
+              atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed) != 0) &&
+             mg6010e_transport->tx_free(bus->can_handle) > 0 && mg6010e_tx_admit(bus, 0));
+}
+
+/**
+ * @brief 设置命令类别在发送队列满时的丢弃策略
+ *
+ * @param cmd_class 命令类别，MG6010E_CMD_CLASS_*
+ * @param policy 丢弃策略，MG6010E_TX_POLICY_*
+ * @return uint8_t 错误码，0表示成功，12表示命令类别或丢弃策略无效
+ * @note 默认控制类与读取类命令为MG6010E_TX_POLICY_DROP_OLDEST，配置类命令为MG6010E_TX_POLICY_NEVER_DROP。
+ * 增量位置命令（0xA7、0xA8）被丢弃会丢失位移量，如有需要请将控制类设置为MG6010E_TX_POLICY_NEVER_DROP。
+ */
+uint8_t mg6010e_set_tx_policy(uint8_t cmd_class, uint8_t policy)
+{
+    if (cmd_class >= MG6010E_CMD_CLASS_NUM || policy > MG6010E_TX_POLICY_NEVER_DROP)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_tx_policy[cmd_class] = policy;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 获取CAN总线发送队列丢弃的帧数
+ *
+ * @param can_handle CAN句柄
+ * @return uint32_t 因队列满被丢弃的帧数，总线未注册时返回0
+ * @note 传输层未能发送的帧保留到下一次发送，不计入丢弃数，见mg6010e_bus_stats_t的tx_failures
+ */
+uint32_t mg6010e_get_tx_dropped(mg6010e_can_t *can_handle)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL || can_handle == NULL)
+    {
+        return 0;
+    }
+    return atomic_load_explicit(&bus->tx_dropped, memory_order_relaxed);
+}
+
+#if MG6010E_USE_BUS_BUDGET
+/**
+ * @brief 设置CAN总线每周期的发送预算
+ *
+ * @param can_handle CAN句柄
+ * @param cycle_us 预算周期，单位us，需与mg6010e_bus_budget_tick的调用周期相同
+ * @param percent 每周期允许占用的总线时间百分比（0-100），0表示不限制，仅统计负载
+ * @return uint8_t 错误码，0表示成功，2表示总线未注册，12表示参数无效
+ * @note 每条命令按其本身与预期回复（0x280广播帧为4个回复）的最坏情况位数计入预算，预算用尽后的命令推迟到下一周期。
+ */
+uint8_t mg6010e_set_bus_budget(mg6010e_can_t *can_handle, uint32_t cycle_us, uint8_t percent)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (cycle_us == 0 || percent > 100)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    bus->cycle_us = cycle_us;
+    bus->budget_bits = (uint32_t)((uint64_t)MG6010E_CAN_BITRATE * cycle_us / 1000000U * percent / 100U);
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 总线预算周期节拍，开始新的预算周期并发出上一周期推迟的帧
+ *
+ * @note 需按mg6010e_set_bus_budget设置的周期调用，如在控制循环开始处。
+ */
+void mg6010e_bus_budget_tick(void)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS; i++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[i];
+        if (bus->can_handle == NULL)
+        {
+            continue;
+        }
+        if (!mg6010e_tx_admit(bus, 0))
+        {
+            // 预算用尽时仍在队列中的帧推迟到本周期
+            uint32_t pending = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed) - atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed) +
+                               atomic_load_explicit(&bus->tx_held_count, memory_order_relaxed);
+            atomic_fetch_add_explicit(&bus->deferred, pending, memory_order_relaxed);
+        }
+        bus->last_reserved_bits = atomic_exchange_explicit(&bus->reserved_bits, 0, memory_order_relaxed);
+        bus->last_measured_bits = atomic_exchange_explicit(&bus->measured_bits, 0, memory_order_relaxed);
+        if (bus->last_measured_bits > bus->peak_bits)
+        {
+            bus->peak_bits = bus->last_measured_bits;
+        }
+        mg6010e_tx_drain(bus);
+    }
+}
+
+/**
+ * @brief 获取CAN总线负载统计
+ *
+ * @param can_handle CAN句柄
+ * @param load 负载统计输出
+ * @return uint8_t 错误码，0表示成功，1表示load为空，2表示总线未注册
+ */
+uint8_t mg6010e_get_bus_load(mg6010e_can_t *can_handle, mg6010e_bus_load_t *load)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (load == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    load->capacity_bits = (uint32_t)((uint64_t)MG6010E_CAN_BITRATE * bus->cycle_us / 1000000U);
+    load->budget_bits = bus->budget_bits;
+    load->reserved_bits = bus->last_reserved_bits;
+    load->measured_bits = bus->last_measured_bits;
+    load->peak_bits = bus->peak_bits;
+    load->deferred = atomic_load_explicit(&bus->deferred, memory_order_relaxed);
+    load->utilization = load->capacity_bits == 0 ? 0 : (uint16_t)((uint64_t)load->measured_bits * 1000U / load->capacity_bits);
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_BUS_BUDGET */
+
+/**
+ * @brief 领控6010E电机CAN发送邮箱空闲回调钩子函数
+ *
+ * @param can_handle CAN句柄
+ * @note 使用HAL传输层时请将该函数注册在HAL_CAN_TxMailbox0/1/2CompleteCallback与HAL_CAN_TxMailbox0/1/2AbortCallback中，
+ * 并通过HAL_CAN_ActivateNotification开启CAN_IT_TX_MAILBOX_EMPTY中断。其他传输层在可以继续发送时调用。
+ */
+void mg6010e_can_tx_complete_hook(mg6010e_can_t *can_handle)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus != NULL && can_handle != NULL)
+    {
+        mg6010e_tx_drain(bus);
+    }
+}
+
+/**
+ * @brief 为总线上的电机ID分配句柄
+ *
+ * @param bus 总线上下文
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return mg6010e_handle_t* 句柄指针，该电机已初始化过则返回原句柄，句柄池已满则返回NULL
+ */
+static mg6010e_handle_t *mg6010e_alloc_handle(mg6010e_bus_t *bus, uint32_t motor_id)
+{
+    if (bus->handle_table[motor_id - 1] != NULL)
+    {
+        return bus->handle_table[motor_id - 1]; // 重复初始化复用原句柄
+    }
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        if (!mg6010e_handle_pool[i].initialized)
+        {
+            return &mg6010e_handle_pool[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 初始化领控6010E电机配置
+ *
+ * @param mg6010e_config 电机配置结构体指针
+ * @return uint8_t 错误码，0表示成功，1表示配置结构体指针为空，2表示CAN句柄为空，3表示电机ID无效，
+ * 4表示未设置传输层，7表示CAN总线数量超过MG6010E_MAX_CAN_BUS或电机数量超过MG6010E_MAX_MOTOR_NUM
+ * @note 句柄从静态池中分配，不使用堆内存。对同一总线上的同一ID重复调用会复用原句柄并清空其数据。
+ * 不同总线上的电机ID互不冲突，初始化后使用MG6010E_MOTOR(bus, id)寻址，bus为mg6010e_get_bus_index返回的总线编号。
+ */
+uint8_t mg6010e_init(mg6010e_config_t *mg6010e_config)
+{
+    if (mg6010e_config == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR; // 配置结构体指针为空错误
+    }
+    if (mg6010e_config->can_handle == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR; // CAN句柄为空错误
+    }
+    if (mg6010e_config->motor_id < 1 || mg6010e_config->motor_id > 32)
+    {
+        return MG6010E_ERROR_INVALID_ID; // 电机ID无效错误
+    }
+    if (mg6010e_transport == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED; // 未设置传输层
+    }
+    mg6010e_bus_t *bus = mg6010e_register_bus(mg6010e_config->can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_NO_RESOURCE; // 总线表已满
+    }
+    mg6010e_handle_t *mg6010e_handle = mg6010e_alloc_handle(bus, mg6010e_config->motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NO_RESOURCE; // 句柄池已满
+    }
+    bus->handle_table[mg6010e_config->motor_id - 1] = NULL; // 重新初始化期间接收中断不再写入该句柄
+#if MG6010E_USE_POLL_SCHEDULER
+    if (mg6010e_handle->initialized)
+    {
+        mg6010e_poll_release(mg6010e_handle);
+    }
+#endif
+    mg6010e_handle->config = *mg6010e_config;
+    mg6010e_handle->bus_index = (uint8_t)(bus - mg6010e_bus_table);
+    mg6010e_handle->status = (mg6010e_status_t){0};
+    mg6010e_handle->encoder_data = (mg6010e_encoder_data_t){0};
+    mg6010e_handle->control_params = (mg6010e_control_params_t){0};
+    mg6010e_handle->status_time = (mg6010e_status_time_t){0};
+#if MG6010E_USE_REQUEST_TRACKING
+    memset(&mg6010e_request_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_request_state_t));
+#endif
+#if MG6010E_USE_STATS
+    mg6010e_motor_stats_table[mg6010e_handle - mg6010e_handle_pool] = (mg6010e_motor_stats_t){0};
+#endif
+#if MG6010E_USE_TRAJECTORY
+    memset(&mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_traj_t));
+#endif
+#if MG6010E_USE_COALESCE
+    memset(&mg6010e_coalesce_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_coalesce_t));
+#endif
+#if MG6010E_USE_PARAMS_SNAPSHOT
+    memset(&mg6010e_params_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_params_entry_t)); // 进行中的快照/恢复不再包含该电机
+#endif
+#if MG6010E_USE_ENCODER_UNWRAP
+    memset(&mg6010e_unwrap_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_unwrap_t));
+#endif
+#if MG6010E_USE_GROUP
+    memset(&mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_group_entry_t));
+#endif
+#if MG6010E_USE_HEALTH
+    mg6010e_health_release(mg6010e_handle, bus, mg6010e_config->motor_id);
+#endif
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry_t *telemetry = &mg6010e_telemetry[mg6010e_handle->bus_index];
+    uint32_t index = mg6010e_config->motor_id - 1;
+    telemetry->speed[index] = 0;
+    telemetry->iqActual[index] = 0;
+    telemetry->encoder[index] = 0;
+    telemetry->temperature[index] = 0;
+    mg6010e_telemetry_set_angle(telemetry, index, 0);
+#endif
+    mg6010e_handle->initialized = 1;
+    bus->handle_table[mg6010e_config->motor_id - 1] = mg6010e_handle;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 通过电机编号获取领控6010E电机句柄
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return mg6010e_handle_t* 电机句柄指针，若编号无效或未初始化则返回NULL
+ */
+static mg6010e_handle_t *mg6010e_get_handle_by_id(uint8_t motor_id)
+{
+    if (motor_id < 1 || motor_id > MG6010E_MAX_CAN_BUS * 32)
+    {
+        return NULL; // 电机编号无效
+    }
+    return mg6010e_bus_table[MG6010E_MOTOR_BUS(motor_id)].handle_table[MG6010E_MOTOR_CAN_ID(motor_id) - 1];
+}
+
+/**
+ * @brief 注销领控6010E电机，释放其句柄
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @note 注销后该电机的反馈帧被忽略，已在发送队列中的命令仍会发出。可再次调用mg6010e_init重新初始化。
+ */
+uint8_t mg6010e_deinit(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    mg6010e_bus_table[MG6010E_MOTOR_BUS(motor_id)].handle_table[MG6010E_MOTOR_CAN_ID(motor_id) - 1] = NULL;
+#if MG6010E_USE_POLL_SCHEDULER
+    mg6010e_poll_release(mg6010e_handle);
+#endif
+#if MG6010E_USE_HEALTH
+    mg6010e_health_release(mg6010e_handle, &mg6010e_bus_table[MG6010E_MOTOR_BUS(motor_id)], MG6010E_MOTOR_CAN_ID(motor_id));
+#endif
+    mg6010e_handle->initialized = 0;
+    return MG6010E_SUCCESS;
+}
+
+#if MG6010E_USE_REQUEST_TRACKING
+/**
+ * @brief 取得句柄对应的电机编号
+ */
+static inline uint8_t mg6010e_handle_motor(const mg6010e_handle_t *mg6010e_handle)
+{
+    return MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id);
+}
+
+/**
+ * @brief 取得命令的参数ID，仅控制参数读写命令（0xC0、0xC1）有参数ID，其余为0
+ */
+static inline uint8_t mg6010e_request_param_id(const uint8_t *data)
+{
+    return (data[0] == 0xC0 || data[0] == 0xC1) ? data[1] : 0;
+}
+
+/**
+ * @brief 登记一个等待回复的请求
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param cmd_data 命令数据
+ * @return mg6010e_request_t* 请求槽位，该电机等待中的请求已满时返回NULL（计入untracked）
+ * @note 需在命令入队前登记，避免回复先于登记到达
+ */
+static mg6010e_request_t *mg6010e_request_begin(mg6010e_handle_t *mg6010e_handle, const uint8_t *cmd_data)
+{
+    mg6010e_request_state_t *state = &mg6010e_request_table[mg6010e_handle - mg6010e_handle_pool];
+    for (uint32_t i = 0; i < MG6010E_REQUEST_PENDING_NUM; i++)
+    {
+        mg6010e_request_t *request = &state->pending[i];
+        uint8_t expected = MG6010E_REQUEST_FREE;
+        if (atomic_compare_exchange_strong_explicit(&request->state, &expected, MG6010E_REQUEST_FILLING, memory_order_acquire, memory_order_relaxed))
+        {
+            request->cmd = cmd_data[0];
+            request->param_id = mg6010e_request_param_id(cmd_data);
+            request->sent_time = mg6010e_get_timestamp_us();
+            atomic_store_explicit(&request->state, MG6010E_REQUEST_PENDING, memory_order_release);
+            return request;
+        }
+    }
+    state->stats.untracked++;
+    return NULL;
+}
+
+/**
+ * @brief 将往返延迟计入直方图
+ *
+ * @note 桶按2的幂划分，每个数量级再分为两半：桶2k覆盖[2^k, 1.5*2^k)，桶2k+1覆盖[1.5*2^k, 2^(k+1))
+ */
+static void mg6010e_latency_record(mg6010e_latency_stats_t *stats, uint32_t latency_us)
+{
+    uint32_t bucket = 0;
+    if (latency_us >= 2)
+    {
+        uint32_t msb = 31 - (uint32_t)__builtin_clz(latency_us);
+        bucket = msb * 2 + ((latency_us >> (msb - 1)) & 1);
+    }
+    if (bucket >= MG6010E_LATENCY_BUCKET_NUM)
+    {
+        bucket = MG6010E_LATENCY_BUCKET_NUM - 1;
+    }
+    stats->histogram[bucket]++;
+    if (stats->count == 0 || latency_us < stats->min_us)
+    {
+        stats->min_us = latency_us;
+    }
+    if (latency_us > stats->max_us)
+    {
+        stats->max_us = latency_us;
+    }
+    stats->count++;
+}
+
+/**
+ * @brief 用收到的回复完成最早登记的匹配请求
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param rx_data 回复数据
+ * @param timestamp 收到回复的时间戳
+ * @note 在接收中断中调用
+ */
+static void mg6010e_request_complete(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp)
+{
+    mg6010e_request_state_t *state = &mg6010e_request_table[mg6010e_handle - mg6010e_handle_pool];
+    uint8_t param_id = mg6010e_request_param_id(rx_data);
+    mg6010e_request_t *oldest = NULL;
+    for (uint32_t i = 0; i < MG6010E_REQUEST_PENDING_NUM; i++)
+    {
+        mg6010e_request_t *request = &state->pending[i];
+        if (atomic_load_explicit(&request->state, memory_order_acquire) == MG6010E_REQUEST_PENDING &&
+            request->cmd == rx_data[0] && request->param_id == param_id &&
+            (oldest == NULL || (int32_t)(request->sent_time - oldest->sent_time) < 0))
+        {
+            oldest = request;
+        }
+    }
+    if (oldest == NULL)
+    {
+        return;
+    }
+    uint32_t sent_time = oldest->sent_time;
+    uint8_t expected = MG6010E_REQUEST_PENDING;
+    if (!atomic_compare_exchange_strong_explicit(&oldest->state, &expected, MG6010E_REQUEST_FREE, memory_order_acq_rel, memory_order_relaxed))
+    {
+        return; // 已被判定超时
+    }
+    uint32_t latency_us = timestamp - sent_time;
+    mg6010e_latency_record(&state->stats, latency_us);
+    if (mg6010e_request_callback != NULL)
+    {
+        mg6010e_request_callback(mg6010e_handle_motor(mg6010e_handle), rx_data[0], param_id, MG6010E_SUCCESS, latency_us);
+    }
+}
+
+/**
+ * @brief 设置请求完成回调函数
+ *
+ * @param callback 回调函数，为NULL表示不回调
+ * @note 收到回复时在CAN接收中断中回调，result为0；超时在调用mg6010e_request_check_timeout的上下文中回调，result为9
+ */
+void mg6010e_set_request_callback(mg6010e_request_callback_t callback)
+{
+    mg6010e_request_callback = callback;
+}
+
+/**
+ * @brief 设置请求超时时间
+ *
+ * @param timeout_us 超时时间，单位us，默认MG6010E_REQUEST_TIMEOUT_US
+ */
+void mg6010e_set_request_timeout(uint32_t timeout_us)
+{
+    mg6010e_request_timeout_us = timeout_us;
+}
+
+/**
+ * @brief 设置命令类别是否登记请求
+ *
+ * @param cmd_class 命令类别，MG6010E_CMD_CLASS_*
+ * @param enable 1表示登记并配对回复、检查超时，0表示照常发送但不登记
+ * @return uint8_t 错误码，0表示成功，12表示命令类别无效
+ * @note 默认只登记读取类与配置类命令。控制类命令周期发送，可能被丢弃策略或合并跳过，未回复时会产生超时回调，
+ * 并占用读取、配置命令所需的等待槽位，需要其往返延迟时再开启。
+ */
+uint8_t mg6010e_set_request_tracking(uint8_t cmd_class, uint8_t enable)
+{
+    if (cmd_class >= MG6010E_CMD_CLASS_NUM)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_request_tracked[cmd_class] = enable != 0;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 检查并清除超时未回复的请求
+ *
+ * @note 请在任务或主循环中周期性调用，检查周期决定超时判定的精度
+ */
+void mg6010e_request_check_timeout(void)
+{
+    uint32_t now = mg6010e_get_timestamp_us();
+    for (uint32_t m = 0; m < MG6010E_MAX_MOTOR_NUM; m++)
+    {
+        mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[m];
+        if (!mg6010e_handle->initialized)
+        {
+            continue;
+        }
+        mg6010e_request_state_t *state = &mg6010e_request_table[m];
+        for (uint32_t i = 0; i < MG6010E_REQUEST_PENDING_NUM; i++)
+        {
+            mg6010e_request_t *request = &state->pending[i];
+            if (atomic_load_explicit(&request->state, memory_order_acquire) != MG6010E_REQUEST_PENDING)
+            {
+                continue;
+            }
+            // 释放槽位后可能立即被新请求占用，须在释放前复制请求内容
+            uint32_t sent_time = request->sent_time;
+            uint8_t cmd = request->cmd;
+            uint8_t param_id = request->param_id;
+            if (now - sent_time < mg6010e_request_timeout_us)
+            {
+                continue;
+            }
+            uint8_t expected = MG6010E_REQUEST_PENDING;
+            if (!atomic_compare_exchange_strong_explicit(&request->state, &expected, MG6010E_REQUEST_FREE, memory_order_acq_rel, memory_order_relaxed))
+            {
+                continue; // 回复恰好到达
+            }
+            state->stats.timeouts++;
+            if (mg6010e_request_callback != NULL)
+            {
+                mg6010e_request_callback(mg6010e_handle_motor(mg6010e_handle), cmd, param_id, MG6010E_ERROR_TIMEOUT, now - sent_time);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 获取领控6010E电机的请求往返延迟统计
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param stats 统计数据指针
+ * @return uint8_t 错误码，0表示成功，1表示指针为空，4表示未初始化
+ * @note p50与p99取所在直方图桶的上界，误差不超过50%
+ */
+uint8_t mg6010e_get_latency_stats(uint8_t motor_id, mg6010e_latency_stats_t *stats)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *stats = mg6010e_request_table[mg6010e_handle - mg6010e_handle_pool].stats;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 根据延迟统计计算百分位延迟
+ *
+ * @param stats 延迟统计数据指针
+ * @param percent 百分位（0-100）
+ * @return uint32_t 延迟，单位us，取所在直方图桶的上界并不超过最大值，无数据时返回0
+ */
+uint32_t mg6010e_latency_percentile(const mg6010e_latency_stats_t *stats, uint8_t percent)
+{
+    if (stats == NULL || stats->count == 0)
+    {
+        return 0;
+    }
+    uint32_t target = (uint32_t)(((uint64_t)stats->count * percent + 99) / 100);
+    uint32_t sum = 0;
+    for (uint32_t bucket = 0; bucket < MG6010E_LATENCY_BUCKET_NUM; bucket++)
+    {
+        sum += stats->histogram[bucket];
+        if (sum >= target && sum > 0)
+        {
+            uint32_t msb = bucket / 2;
+            uint32_t upper = (bucket & 1) ? (2UL << msb) - 1 : (1UL << msb) + (1UL << msb) / 2 - 1;
+            if (bucket < 2)
+            {
+                upper = 1;
+            }
+            return upper < stats->max_us ? upper : stats->max_us;
+        }
+    }
+    return stats->max_us;
+}
+
+/**
+ * @brief 清空领控6010E电机的请求往返延迟统计
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化
+ */
+uint8_t mg6010e_reset_latency_stats(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    memset(&mg6010e_request_table[mg6010e_handle - mg6010e_handle_pool].stats, 0, sizeof(mg6010e_latency_stats_t));
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_REQUEST_TRACKING */
+
+/**
+ * @brief 按小端序写入16位字段
+ */
+static inline void mg6010e_put_le16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+/**
+ * @brief 按小端序写入32位字段
+ */
+static inline void mg6010e_put_le32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+static inline void mg6010e_put_le16_signed(uint8_t *data, int16_t value)
+{
+    mg6010e_put_le16(data, (uint16_t)value);
+}
+
+static inline void mg6010e_put_le32_signed(uint8_t *data, int32_t value)
+{
+    mg6010e_put_le32(data, (uint32_t)value);
+}
+
+// 按字段类型写入小端序数据，宽度由类型决定，其他类型（包括未注明宽度的整数常量）编译报错
+#define mg6010e_put_le(data, value) _Generic((value),      \
+    uint16_t: mg6010e_put_le16,                             \
+    int16_t: mg6010e_put_le16_signed,                       \
+    uint32_t: mg6010e_put_le32,                             \
+    int32_t: mg6010e_put_le32_signed)((data), (value))
+
+/**
+ * @brief 编码命令头：命令字节与数据1
+ *
+ * @param data 槽位中的命令数据
+ * @param cmd 命令字节
+ * @param arg 数据1，如旋转方向、控制参数ID
+ * @note 调用者需再写入数据2~7
+ */
+static inline void mg6010e_encode_header(uint8_t *data, uint8_t cmd, uint8_t arg)
+{
+    data[0] = cmd;
+    data[1] = arg;
+}
+
+/**
+ * @brief 编码只有命令字节与数据1、其余为0的命令
+ */
+static inline void mg6010e_encode_cmd(uint8_t *data, uint8_t cmd, uint8_t arg)
+{
+    mg6010e_encode_header(data, cmd, arg);
+    mg6010e_put_le(data + 2, (uint16_t)0);
+    mg6010e_put_le(data + 4, (uint32_t)0);
+}
+
+/**
+ * @brief 开始发送领控6010E电机命令：在总线发送队列中占用一个槽位
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param cmd_class 命令类别，决定队列满时的丢弃策略
+ * @param slot 占用的槽位，命令数据直接编码到(*slot)->frame.data中，随后必须调用mg6010e_cmd_commit
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，11表示电机处于故障锁存状态（仅控制类命令）
+ */
+static uint8_t mg6010e_cmd_begin(mg6010e_handle_t *mg6010e_handle, uint8_t cmd_class, mg6010e_tx_slot_t **slot)
+{
+    if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED; // 未初始化错误
+    }
+#if MG6010E_USE_HEALTH
+    if (cmd_class == MG6010E_CMD_CLASS_SETPOINT && mg6010e_health_blocked(mg6010e_handle))
+    {
+        return MG6010E_ERROR_FAULT;
+    }
+#endif
+    *slot = mg6010e_tx_claim(&mg6010e_bus_table[mg6010e_handle->bus_index]);
+    if (*slot == NULL)
+    {
+        return MG6010E_ERROR_QUEUE_FULL;
+    }
+    (*slot)->frame.std_id = MG6010E_CAN_CMD_ID(mg6010e_handle->config.motor_id);
+    (*slot)->frame.cmd_class = cmd_class;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 发布命令前的登记：控制命令已发送标志与请求跟踪
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param slot 已编码、尚未发布的槽位
+ */
+static inline void mg6010e_cmd_prepare(mg6010e_handle_t *mg6010e_handle, mg6010e_tx_slot_t *slot)
+{
+#if MG6010E_USE_POLL_SCHEDULER
+    if (slot->frame.cmd_class == MG6010E_CMD_CLASS_SETPOINT)
+    {
+        mg6010e_poll_table[mg6010e_handle - mg6010e_handle_pool].setpoint_sent = 1;
+    }
+#endif
+#if MG6010E_USE_REQUEST_TRACKING
+    if (mg6010e_request_tracked[slot->frame.cmd_class])
+    {
+        mg6010e_request_begin(mg6010e_handle, slot->frame.data); // 须在发布前登记，否则回复可能先于登记到达
+    }
+#endif
+    (void)mg6010e_handle;
+    (void)slot;
+}
+
+/**
+ * @brief 完成发送领控6010E电机命令：发布已编码的槽位并尝试发出
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param slot mg6010e_cmd_begin占用的槽位
+ * @return uint8_t 错误码，始终为0
+ * @note 命令先进入总线的发送队列，有空闲邮箱时立即发出，否则在发送邮箱空闲中断中发出
+ */
+static uint8_t mg6010e_cmd_commit(mg6010e_handle_t *mg6010e_handle, mg6010e_tx_slot_t *slot)
+{
+    mg6010e_cmd_prepare(mg6010e_handle, slot);
+    mg6010e_tx_publish(slot);
+    mg6010e_tx_drain(&mg6010e_bus_table[mg6010e_handle->bus_index]);
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 开始发送领控6010E电机控制命令（0xA1~0xA6）
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param slot 命令数据的编码位置，随后必须调用mg6010e_setpoint_commit
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入，11表示电机处于故障锁存状态
+ * @note 命令组打开时写入电机在组中的暂存位置；否则启用MG6010E_USE_COALESCE时占用电机的待发槽位，否则与mg6010e_cmd_begin相同。
+ * 增量控制命令（0xA7、0xA8）多次发送与一次发送效果不同，不经过暂存位置与待发槽位。
+ */
+static inline uint8_t mg6010e_setpoint_begin(mg6010e_handle_t *mg6010e_handle, mg6010e_tx_slot_t **slot)
+{
+#if MG6010E_USE_GROUP
+    if (mg6010e_group_open)
+    {
+        if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+        {
+            return MG6010E_ERROR_NOT_INITIALIZED;
+        }
+#if MG6010E_USE_HEALTH
+        if (mg6010e_health_blocked(mg6010e_handle))
+        {
+            return MG6010E_ERROR_FAULT;
+        }
+#endif
+        mg6010e_group_entry_t *entry = &mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool];
+        entry->slot.frame.std_id = MG6010E_CAN_CMD_ID(mg6010e_handle->config.motor_id);
+        entry->slot.frame.cmd_class = MG6010E_CMD_CLASS_SETPOINT;
+        *slot = &entry->slot;
+        return MG6010E_SUCCESS;
+    }
+#endif
+#if MG6010E_USE_COALESCE
+    if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+#if MG6010E_USE_HEALTH
+    if (mg6010e_health_blocked(mg6010e_handle))
+    {
+        return MG6010E_ERROR_FAULT;
+    }
+#endif
+    mg6010e_tx_slot_t *pending = &mg6010e_coalesce_table[mg6010e_handle - mg6010e_handle_pool].slot;
+    uint32_t seq = atomic_load_explicit(&pending->sequence, memory_order_relaxed);
+    if ((seq & MG6010E_COALESCE_WRITING) ||
+        !atomic_compare_exchange_strong_explicit(&pending->sequence, &seq, seq | MG6010E_COALESCE_WRITING, memory_order_acquire, memory_order_relaxed))
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    atomic_thread_fence(memory_order_release); // 写入标志先于数据可见
+    pending->frame.std_id = MG6010E_CAN_CMD_ID(mg6010e_handle->config.motor_id);
+    pending->frame.cmd_class = MG6010E_CMD_CLASS_SETPOINT;
+    *slot = pending;
+    return MG6010E_SUCCESS;
+#else
+    return mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_SETPOINT, slot);
+#endif
+}
+
+/**
+ * @brief 完成发送领控6010E电机控制命令
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param slot mg6010e_setpoint_begin返回的位置
+ * @return uint8_t 错误码，始终为0
+ * @note 命令组中的命令由mg6010e_group_commit发出。启用MG6010E_USE_COALESCE时只将命令标记为待发，覆盖尚未发出的上一条控制命令，由mg6010e_coalesce_flush发出。
+ */
+static inline uint8_t mg6010e_setpoint_commit(mg6010e_handle_t *mg6010e_handle, mg6010e_tx_slot_t *slot)
+{
+#if MG6010E_USE_GROUP
+    mg6010e_group_entry_t *entry = &mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool];
+    if (slot == &entry->slot)
+    {
+        entry->staged = 1; // 同一组内后写覆盖先写
+        return MG6010E_SUCCESS;
+    }
+#endif
+#if MG6010E_USE_COALESCE
+    mg6010e_coalesce_t *coalesce = &mg6010e_coalesce_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t seq = atomic_load_explicit(&slot->sequence, memory_order_relaxed); // 写入期间sequence只会被本上下文修改
+    coalesce->stats.written++;
+    if (seq & MG6010E_COALESCE_PENDING)
+    {
+        coalesce->stats.overwritten++;
+    }
+    atomic_store_explicit(&slot->sequence, ((seq & ~3U) + 4U) | MG6010E_COALESCE_PENDING, memory_order_release);
+    return MG6010E_SUCCESS;
+#else
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+#endif
+}
+
+#if MG6010E_USE_COALESCE
+/**
+ * @brief 撤销电机尚未发出的控制命令，用于直接发出的更新命令（如0x280广播帧）取代它
+ */
+static void mg6010e_coalesce_cancel(mg6010e_handle_t *mg6010e_handle)
+{
+    mg6010e_coalesce_t *coalesce = &mg6010e_coalesce_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t seq = atomic_load_explicit(&coalesce->slot.sequence, memory_order_relaxed);
+    if ((seq & (MG6010E_COALESCE_WRITING | MG6010E_COALESCE_PENDING)) != MG6010E_COALESCE_PENDING ||
+        !atomic_compare_exchange_strong_explicit(&coalesce->slot.sequence, &seq, seq | MG6010E_COALESCE_WRITING, memory_order_acquire, memory_order_relaxed))
+    {
+        return; // 无待发命令，或另一写者正在写入更新的命令
+    }
+    coalesce->stats.overwritten++;
+    atomic_store_explicit(&coalesce->slot.sequence, (seq & ~3U) + 4U, memory_order_release);
+}
+#endif
+
+/**
+ * @brief 发送领控6010E电机读取状态1命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 该命令读取当前电机的温度、电压和错误状态标志
+ */
+uint8_t mg6010e_read_status_1(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x9A, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机清除错误标志命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 该命令清除当前电机的错误状态，电机收到后返回，电机状态没有恢复正常时，错误标志无法清除。
+ */
+uint8_t mg6010e_clean_error_flag(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x9B, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机读取状态2命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 该命令读取当前电机的温度、电机转矩电流（MF、MG）/电机输出功率（MS）、转速、编码器位置。
+ */
+uint8_t mg6010e_read_status_2(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x9C, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机读取状态3命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 该命令读取当前电机的温度和 3 相电流数据
+ */
+uint8_t mg6010e_read_status_3(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x9D, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机关闭命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 将电机从开启状态（上电后默认状态）切换到关闭状态，清除电机转动圈数及之前接收的控制指令，
+LED 由常亮转为慢闪。此时电机仍然可以回复控制命令，但不会执行动作。
+ */
+uint8_t mg6010e_disable(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x80, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机开启命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 将电机从关闭状态切换到开启状态，LED 由慢闪转为常亮。此时再发送控制指令即可控制电机动作。
+ */
+uint8_t mg6010e_run(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x88, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机停止命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 停止电机，但不清除电机运行状态。再次发送控制指令即可控制电机动作。
+ */
+uint8_t mg6010e_stop(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x81, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机抱闸器状态读取命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 读取当前抱闸器的状态。
+ */
+uint8_t mg6010e_break_status_read(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x8C, 0x10);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机抱闸器控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param engage 抱闸器状态，0：抱闸器断电，刹车启动，1：抱闸器通电，刹车释放
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 控制抱闸器的开合。
+ */
+uint8_t mg6010e_break_control(uint8_t motor_id, uint8_t engage)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x8C, engage ? 0x01 : 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机转矩电流闭环控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param iqControl 转矩电流，数值范围-2048~ 2048，对应 MG 电机实际转矩电流范围-33A~33A
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的转矩电流输出，母线电流和电机的实际扭矩因不同电机而异。
+ * 该命令中的控制值 iqControl 不受上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_iq_control(uint8_t motor_id, int16_t iqControl)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA1, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, (uint16_t)0);
+    mg6010e_put_le(slot->frame.data + 4, (uint32_t)(uint16_t)iqControl); // 数据6~7为0
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E多电机转矩电流闭环控制命令
+ *
+ * @param motor_ids 电机编号数组，见MG6010E_MOTOR
+ * @param iqControls 转矩电流数组，与motor_ids一一对应，数值范围-2048~ 2048，对应 MG 电机实际转矩电流范围-33A~33A
+ * @param count 电机数量
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，4表示存在未初始化的电机，6表示发送队列已满，
+ * 11表示存在处于故障锁存状态的电机（仅MG6010E_USE_HEALTH，其余电机照常发送），8表示命令组已打开（仅MG6010E_USE_GROUP）
+ * @note 同一总线上ID为1~4的电机合并为一帧广播命令（ID 0x280）发出，每个电机仍以0xA1格式回复，由接收钩子函数解析。
+ * 广播帧会同时设置该总线上ID为1~4的全部电机，因此仅当该总线上已初始化的1~4号电机全部包含在本次调用中时才使用广播帧，
+ * 其余电机逐个发送0xA1命令。启用MG6010E_USE_HEALTH时，处于故障锁存状态的电机不计入广播帧。
+ * 启用MG6010E_USE_GROUP时，命令组打开期间拒绝发送：广播帧无法放入各电机的暂存位置，立即发出会插在本组命令之前，
+ * 请在命令组中逐个调用mg6010e_iq_control，或在提交后再调用本函数。
+ */
+uint8_t mg6010e_iq_control_group(const uint8_t *motor_ids, const int16_t *iqControls, uint8_t count)
+{
+    if (motor_ids == NULL || iqControls == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+#if MG6010E_USE_GROUP
+    if (mg6010e_group_open)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+#endif
+    for (uint8_t i = 0; i < count; i++)
+    {
+        mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_ids[i]);
+        if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+        {
+            return MG6010E_ERROR_NOT_INITIALIZED;
+        }
+    }
+
+    uint8_t ret = MG6010E_SUCCESS;
+    uint32_t broadcast_mask = 0; // 已通过广播帧发送的电机，bit n 对应 motor_ids[n]
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        if (bus->can_handle == NULL)
+        {
+            continue;
+        }
+        uint8_t requested = 0; // 本次调用包含的1~4号电机
+        uint8_t present = 0;   // 该总线上已初始化的1~4号电机
+        uint32_t mask = 0;
+        for (uint8_t id = 1; id <= MG6010E_CAN_MULTI_IQ_MOTOR_NUM; id++)
+        {
+            if (bus->handle_table[id - 1] != NULL)
+            {
+                present |= 1U << (id - 1);
+            }
+        }
+        for (uint8_t i = 0; i < count && i < 32; i++)
+        {
+            uint8_t id = MG6010E_MOTOR_CAN_ID(motor_ids[i]);
+            if ((uint32_t)MG6010E_MOTOR_BUS(motor_ids[i]) == b && id <= MG6010E_CAN_MULTI_IQ_MOTOR_NUM && (present & (1U << (id - 1))))
+            {
+#if MG6010E_USE_HEALTH
+                if (mg6010e_health_blocked(bus->handle_table[id - 1]))
+                {
+                    continue; // 广播帧无法跳过该电机，改为逐个发送，由mg6010e_iq_control拒绝
+                }
+#endif
+                requested |= 1U << (id - 1);
+                mask |= 1UL << i;
+            }
+        }
+        if (requested == 0 || requested != present)
+        {
+            continue;
+        }
+        broadcast_mask |= mask;
+        mg6010e_tx_slot_t *slot = mg6010e_tx_claim(bus);
+        if (slot == NULL)
+        {
+            ret = MG6010E_ERROR_QUEUE_FULL;
+            continue;
+        }
+        slot->frame.std_id = MG6010E_CAN_MULTI_IQ_ID;
+        slot->frame.cmd_class = MG6010E_CMD_CLASS_SETPOINT;
+        mg6010e_put_le(slot->frame.data, (uint32_t)0);
+        mg6010e_put_le(slot->frame.data + 4, (uint32_t)0);
+        for (uint8_t i = 0; i < count && i < 32; i++)
+        {
+            if (mask & (1UL << i))
+            {
+                mg6010e_put_le(slot->frame.data + (MG6010E_MOTOR_CAN_ID(motor_ids[i]) - 1) * 2, iqControls[i]);
+            }
+        }
+#if MG6010E_USE_REQUEST_TRACKING
+        static const uint8_t reply_cmd[8] = {0xA1};
+        for (uint8_t id = 1; id <= MG6010E_CAN_MULTI_IQ_MOTOR_NUM && mg6010e_request_tracked[MG6010E_CMD_CLASS_SETPOINT]; id++)
+        {
+            if (requested & (1U << (id - 1)))
+            {
+                mg6010e_request_begin(bus->handle_table[id - 1], reply_cmd); // 每个电机以0xA1格式回复
+            }
+        }
+#endif
+#if MG6010E_USE_POLL_SCHEDULER
+        for (uint8_t id = 1; id <= MG6010E_CAN_MULTI_IQ_MOTOR_NUM; id++)
+        {
+            if (requested & (1U << (id - 1)))
+            {
+                mg6010e_poll_table[bus->handle_table[id - 1] - mg6010e_handle_pool].setpoint_sent = 1;
+            }
+        }
+#endif
+#if MG6010E_USE_COALESCE
+        for (uint8_t id = 1; id <= MG6010E_CAN_MULTI_IQ_MOTOR_NUM; id++)
+        {
+            if (requested & (1U << (id - 1)))
+            {
+                mg6010e_coalesce_cancel(bus->handle_table[id - 1]); // 广播帧立即发出，之前写入的控制命令不再发出
+            }
+        }
+#endif
+        mg6010e_tx_publish(slot);
+        mg6010e_tx_drain(bus);
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (i < 32 && (broadcast_mask & (1UL << i)))
+        {
+            continue;
+        }
+        uint8_t err = mg6010e_iq_control(motor_ids[i], iqControls[i]);
+        if (err != MG6010E_SUCCESS && ret == MG6010E_SUCCESS)
+        {
+            ret = err;
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief 发送领控6010E电机速度闭环控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param iqControl 转矩电流，数值范围-2048~ 2048，对应 MG 电机实际转矩电流范围-33A~33A
+ * @param speedControl 速度控制值，对应实际转速为 0.01dps/LSB
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的速度，同时带有力矩限制。母线电流和电机的实际扭矩因不同电机而异。
+ * 该命令下电机的 speedControl 由上位机中的 Max Speed 值限制。
+ * 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ */
+uint8_t mg6010e_speed_control(uint8_t motor_id, int16_t iqControl, int32_t speedControl)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA2, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, iqControl);
+    mg6010e_put_le(slot->frame.data + 4, speedControl);
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机多圈角度位置闭环控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置（多圈角度）。电机转动方向由目标位置和当前位置的差值决定。
+ * 1. 该命令下的控制值 angleControl 受上位机中的 Max Angle 值限制。
+ * 2. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
+ * 3. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 4. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_angle_control(uint8_t motor_id, int32_t angleControl)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA3, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, (uint16_t)0);
+    mg6010e_put_le(slot->frame.data + 4, angleControl);
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机多圈角度位置闭环控制命令2
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置（多圈角度）。电机转动方向由目标位置和当前位置的差值决定。携带最大速度参数。
+ * 1. 该命令下的控制值 angleControl 受上位机中的 Max Angle 值限制。
+ * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_angle_control_2(uint8_t motor_id, int32_t angleControl, uint16_t maxSpeed)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA4, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, maxSpeed);
+    mg6010e_put_le(slot->frame.data + 4, angleControl);
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机单圈角度位置闭环控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleControl 位置控制值，范围（0 ~ 36000）对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @param spinDirection 旋转方向，0表示顺时针，1表示逆时针
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置（单圈角度）。
+ * 1. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
+ * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_single_angle_control(uint8_t motor_id, uint32_t angleControl, uint8_t spinDirection)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA5, spinDirection);
+    mg6010e_put_le(slot->frame.data + 2, (uint16_t)0);
+    mg6010e_put_le(slot->frame.data + 4, angleControl);
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机单圈角度位置闭环控制命令2
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
+ * @param spinDirection 旋转方向，0表示顺时针，1表示逆时针
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，8表示同一电机的另一控制命令正在写入（仅MG6010E_USE_COALESCE），11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置（单圈角度）。携带最大速度参数。
+ * 1. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 2. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制；
+ */
+uint8_t mg6010e_single_angle_control_2(uint8_t motor_id, int32_t angleControl, uint16_t maxSpeed, uint8_t spinDirection)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_setpoint_begin(mg6010e_handle, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA6, spinDirection);
+    mg6010e_put_le(slot->frame.data + 2, maxSpeed);
+    mg6010e_put_le(slot->frame.data + 4, angleControl);
+    return mg6010e_setpoint_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机多圈角度位置闭环控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleIncrement 增量值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置增量。
+ * 1. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
+ * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_angle_increment_control(uint8_t motor_id, int32_t angleIncrement)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_SETPOINT, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA7, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, (uint16_t)0);
+    mg6010e_put_le(slot->frame.data + 4, angleIncrement);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机多圈角度位置闭环控制命令2
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param angleIncrement 增量值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
+ * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满，11表示电机处于故障锁存状态（仅MG6010E_USE_HEALTH）
+ * @note 主机发送该命令以控制电机的位置增量。携带最大速度参数。
+ * 1. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
+ * 2. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ */
+uint8_t mg6010e_angle_increment_control_2(uint8_t motor_id, int32_t angleIncrement, uint16_t maxSpeed)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_SETPOINT, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xA8, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, maxSpeed);
+    mg6010e_put_le(slot->frame.data + 4, angleIncrement);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机控制参数读取命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param controlParamID 控制参数ID
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令读取当前电机的控制参数，读取的参数由序号 controlParamID 确定，见电机控制参数表
+ */
+uint8_t mg6010e_read_control_param(uint8_t motor_id, uint8_t controlParamID)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0xC0, controlParamID);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机控制参数写入命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param controlParamID 控制参数ID
+ * @param paramData 控制参数数据指针，长度根据具体参数而定，最大6字节
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令写入控制参数到 RAM 中，即时生效，断电后失效。写入的参数和序号 controlParamID 见电机控制参数表
+ */
+uint8_t mg6010e_write_control_param(uint8_t motor_id, uint8_t controlParamID, uint8_t *paramData)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0xC1, controlParamID);
+    memcpy(slot->frame.data + 2, paramData, 6);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机读取编码器数据命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令以读取编码器的当前位置。
+ */
+uint8_t mg6010e_read_encoder(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x90, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机写入编码器零点命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 设置电机当前位置的编码器原始值作为电机上电后的初始零点
+ * 1．该命令需要重新上电后才能生效
+ * 2．该命令会将零点写入驱动的 ROM，多次写入将会影响芯片寿命，不建议频繁使用
+ */
+uint8_t mg6010e_write_encoder_zero_point(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x19, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机读取多圈角度命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令以读取当前电机的多圈绝对角度值。
+ */
+uint8_t mg6010e_read_angle(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x92, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机读取单圈角度命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令以读取当前电机的单圈绝对角度值。
+ */
+uint8_t mg6010e_read_single_angle(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_cmd(slot->frame.data, 0x94, 0x00);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发送领控6010E电机设置当前位置为任意角度（多圈角度）
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param motorAngle 角度值，数据单位 0.01°/LSB。
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，6表示发送队列已满
+ * @note 主机发送该命令以设置电机的当前位置作为任意角度（写入 RAM，电机下电后丢失数据）。
+ */
+uint8_t mg6010e_set_angle(uint8_t motor_id, int32_t motorAngle)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_tx_slot_t *slot;
+    uint8_t ret = mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_CONFIG, &slot);
+    if (ret != MG6010E_SUCCESS)
+    {
+        return ret;
+    }
+    mg6010e_encode_header(slot->frame.data, 0x95, 0x00);
+    mg6010e_put_le(slot->frame.data + 2, (uint16_t)0);
+    mg6010e_put_le(slot->frame.data + 4, motorAngle);
+    return mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+#if MG6010E_USE_POLL_SCHEDULER
+/**
+ * @brief 在负载窗口中登记或释放轮询项占用的位置
+ *
+ * @param bus_index 总线编号
+ * @param item 轮询项
+ * @param delta 1表示占用，-1表示释放
+ */
+static void mg6010e_poll_account(uint8_t bus_index, const mg6010e_poll_item_t *item, int8_t delta)
+{
+    for (uint32_t t = item->phase; t < MG6010E_POLL_WINDOW; t += item->period)
+    {
+        mg6010e_poll_load[bus_index][t] = (uint8_t)(mg6010e_poll_load[bus_index][t] + delta);
+    }
+}
+
+/**
+ * @brief 释放电机的全部轮询项
+ *
+ * @param mg6010e_handle 电机句柄指针
+ */
+static void mg6010e_poll_release(mg6010e_handle_t *mg6010e_handle)
+{
+    mg6010e_poll_t *poll = &mg6010e_poll_table[mg6010e_handle - mg6010e_handle_pool];
+    for (uint32_t i = 0; i < MG6010E_POLL_ITEM_NUM; i++)
+    {
+        if (poll->items[i].period != 0)
+        {
+            mg6010e_poll_account(mg6010e_handle->bus_index, &poll->items[i], -1);
+        }
+    }
+    memset(poll, 0, sizeof(mg6010e_poll_t));
+#if MG6010E_USE_ADAPTIVE_POLL
+    memset(&mg6010e_adapt_table[mg6010e_handle - mg6010e_handle_pool], 0, sizeof(mg6010e_adapt_t));
+#endif
+}
+
+/**
+ * @brief 按周期安排电机的轮询项
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param item 轮询项，MG6010E_POLL_*
+ * @param period 轮询周期，单位tick，0表示取消该项
+ * @note 相位选在同一总线上已安排读取帧最少的位置，使各电机的读取请求交错发出，总线占用保持平稳。
+ */
+static void mg6010e_poll_schedule(mg6010e_handle_t *mg6010e_handle, uint8_t item, uint16_t period)
+{
+    mg6010e_poll_item_t *poll_item = &mg6010e_poll_table[mg6010e_handle - mg6010e_handle_pool].items[item];
+    if (poll_item->period != 0)
+    {
+        mg6010e_poll_account(mg6010e_handle->bus_index, poll_item, -1);
+        poll_item->period = 0;
+    }
+    if (period == 0)
+    {
+        return;
+    }
+    poll_item->period = period;
+
+    // 在[0, period)中选取负载最小的相位
+    uint32_t best_phase = 0;
+    uint32_t best_load = UINT32_MAX;
+    uint32_t phase_num = poll_item->period < MG6010E_POLL_WINDOW ? poll_item->period : MG6010E_POLL_WINDOW;
+    for (uint32_t phase = 0; phase < phase_num; phase++)
+    {
+        uint32_t load = 0;
+        for (uint32_t t = phase; t < MG6010E_POLL_WINDOW; t += poll_item->period)
+        {
+            if (mg6010e_poll_load[mg6010e_handle->bus_index][t] > load)
+            {
+                load = mg6010e_poll_load[mg6010e_handle->bus_index][t];
+            }
+        }
+        if (load < best_load)
+        {
+            best_load = load;
+            best_phase = phase;
+        }
+    }
+    poll_item->phase = (uint16_t)best_phase;
+    mg6010e_poll_account(mg6010e_handle->bus_index, poll_item, 1);
+
+    // 对齐到全局tick，使该项在 tick ≡ phase (mod period) 时发出
+    uint32_t offset = (best_phase + poll_item->period - mg6010e_poll_tick_count % poll_item->period) % poll_item->period;
+    poll_item->countdown = (uint16_t)(offset == 0 ? poll_item->period : offset);
+}
+
+/**
+ * @brief 注册领控6010E电机的自动轮询项
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param item 轮询项，MG6010E_POLL_*
+ * @param rate_hz 轮询频率，单位Hz，0表示取消该项，超过MG6010E_POLL_TICK_HZ时按MG6010E_POLL_TICK_HZ处理
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，12表示轮询项无效
+ * @note 新轮询项的相位选在同一总线上已安排读取帧最少的位置，使各电机的读取请求交错发出，总线占用保持平稳。
+ * 启用MG6010E_USE_ADAPTIVE_POLL时，该项改为固定频率，不再自动调整。
+ * 仅在任务上下文中调用，不可与mg6010e_poll_tick并发。
+ */
+uint8_t mg6010e_poll_register(uint8_t motor_id, uint8_t item, uint16_t rate_hz)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (item >= MG6010E_POLL_ITEM_NUM)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+#if MG6010E_USE_ADAPTIVE_POLL
+    mg6010e_adapt_table[mg6010e_handle - mg6010e_handle_pool].adaptive &= (uint8_t)~(1U << item);
+#endif
+    uint32_t period = rate_hz == 0 ? 0 : rate_hz >= MG6010E_POLL_TICK_HZ ? 1 : MG6010E_POLL_TICK_HZ / rate_hz;
+    mg6010e_poll_schedule(mg6010e_handle, item, (uint16_t)(period > UINT16_MAX ? UINT16_MAX : period));
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 领控6010E电机自动轮询节拍函数
+ *
+ * @note 请以MG6010E_POLL_TICK_HZ的频率在定时器中断或任务中调用。到期的轮询项会发送对应的读取命令；
+ * 若自上次读取状态2以来已发送过控制命令（0xA1~0xA8的反馈已包含状态2的数据），则跳过本次状态2读取。
+ * 每条总线每个tick最多发出MG6010E_POLL_TICK_READS条读取命令，超出的到期项推迟到下一个tick，且下一个tick从第一个被推迟的电机开始：
+ * 总线按ID仲裁，请求超出容量时ID小的电机总是优先，限量并轮转后各电机的回复数均衡，推迟的轮询项相位随之后移。
+ */
+void mg6010e_poll_tick(void)
+{
+    static const uint8_t poll_cmd[MG6010E_POLL_ITEM_NUM][2] = {
+        [MG6010E_POLL_STATUS_1] = {0x9A, 0x00},
+        [MG6010E_POLL_STATUS_2] = {0x9C, 0x00},
+        [MG6010E_POLL_STATUS_3] = {0x9D, 0x00},
+        [MG6010E_POLL_ANGLE] = {0x92, 0x00},
+        [MG6010E_POLL_SINGLE_ANGLE] = {0x94, 0x00},
+        [MG6010E_POLL_ENCODER] = {0x90, 0x00},
+        [MG6010E_POLL_BRAKE] = {0x8C, 0x10},
+    };
+
+    mg6010e_poll_tick_count++;
+    for (uint8_t bus_index = 0; bus_index < MG6010E_MAX_CAN_BUS; bus_index++)
+    {
+        uint32_t first = mg6010e_poll_first[bus_index];
+        uint32_t issued = 0;
+        int32_t deferred = -1; // 第一个被推迟的句柄序号
+        for (uint32_t n = 0; n < MG6010E_MAX_MOTOR_NUM; n++)
+        {
+            uint32_t i = (first + n) % MG6010E_MAX_MOTOR_NUM;
+            mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+            if (!mg6010e_handle->initialized || mg6010e_handle->bus_index != bus_index)
+            {
+                continue;
+            }
+            mg6010e_poll_t *poll = &mg6010e_poll_table[i];
+            for (uint32_t item = 0; item < MG6010E_POLL_ITEM_NUM; item++)
+            {
+                mg6010e_poll_item_t *poll_item = &poll->items[item];
+                if (poll_item->period == 0 || --poll_item->countdown != 0)
+                {
+                    continue;
+                }
+                if (item == MG6010E_POLL_STATUS_2 && poll->setpoint_sent)
+                {
+                    poll_item->countdown = poll_item->period;
+                    poll->setpoint_sent = 0; // 控制命令的反馈已携带状态2数据
+                    continue;
+                }
+                if (issued == MG6010E_POLL_TICK_READS)
+                {
+                    poll_item->countdown = 1; // 推迟到下一个tick
+                    deferred = deferred < 0 ? (int32_t)i : deferred;
+                    continue;
+                }
+                poll_item->countdown = poll_item->period;
+                issued++;
+                mg6010e_tx_slot_t *slot;
+                if (mg6010e_cmd_begin(mg6010e_handle, MG6010E_CMD_CLASS_READ, &slot) == MG6010E_SUCCESS)
+                {
+                    mg6010e_encode_cmd(slot->frame.data, poll_cmd[item][0], poll_cmd[item][1]);
+                    mg6010e_cmd_commit(mg6010e_handle, slot);
+                }
+            }
+        }
+        if (deferred >= 0)
+        {
+            mg6010e_poll_first[bus_index] = (uint8_t)deferred;
+        }
+    }
+}
+#endif /* MG6010E_USE_POLL_SCHEDULER */
+
+#if MG6010E_USE_ADAPTIVE_POLL
+/**
+ * @brief 以比较交换更新峰值
+ */
+static inline void mg6010e_adapt_peak(_Atomic uint32_t *peak, uint32_t value)
+{
+    uint32_t current = atomic_load_explicit(peak, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak_explicit(peak, &current, value, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief 在接收路径中记录转速、转矩电流变化率与错误状态的峰值，供mg6010e_poll_adapt计算活动度
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
+ */
+static inline void mg6010e_adapt_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp)
+{
+    mg6010e_adapt_t *adapt = &mg6010e_adapt_table[mg6010e_handle - mg6010e_handle_pool];
+    if (adapt->adaptive == 0)
+    {
+        return;
+    }
+    uint8_t command = rx_data[0];
+    if (command == 0x9A || command == 0x9B)
+    {
+        atomic_store_explicit(&adapt->error_state, rx_data[7], memory_order_relaxed);
+        return;
+    }
+    if (command != 0x9C && (command < 0xA1 || command > 0xA8))
+    {
+        return;
+    }
+    int16_t iq = (int16_t)(rx_data[2] | (rx_data[3] << 8));
+    int16_t speed = (int16_t)(rx_data[4] | (rx_data[5] << 8));
+    mg6010e_adapt_peak(&adapt->speed_peak, (uint32_t)(speed < 0 ? -speed : speed));
+    mg6010e_adapt_peak(&adapt->iq_peak, (uint32_t)(iq < 0 ? -iq : iq));
+    if (adapt->iq_valid)
+    {
+        uint32_t interval = timestamp - adapt->last_iq_time;
+        interval = interval < 1000 ? 1000 : interval; // 连续到达的两帧（如控制命令与轮询回复）不放大变化率
+        int32_t step = (int32_t)iq - adapt->last_iq;
+        mg6010e_adapt_peak(&adapt->slew_peak, (uint32_t)((uint64_t)(step < 0 ? -step : step) * 1000000U / interval));
+    }
+    adapt->last_iq = iq;
+    adapt->last_iq_time = timestamp;
+    adapt->iq_valid = 1;
+    atomic_fetch_add_explicit(&adapt->samples, 1, memory_order_relaxed);
+}
+
+/**
+ * @brief 将电机的轮询项设为自适应频率
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param item 轮询项，仅支持MG6010E_POLL_STATUS_1、MG6010E_POLL_STATUS_2与MG6010E_POLL_ANGLE
+ * @param min_hz 最低频率，单位Hz，电机静止且无错误时按该频率轮询，0表示取消该项
+ * @param max_hz 最高频率，单位Hz，不低于min_hz，超过MG6010E_POLL_TICK_HZ时按MG6010E_POLL_TICK_HZ处理
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，12表示轮询项或频率无效
+ * @note 先按最低频率开始轮询，之后由mg6010e_poll_adapt调整。状态2与多圈角度随转速升高，状态2还随转矩电流变化率升高；
+ * 状态1随转矩电流升高，errorState非0时按最高频率轮询。仅在任务上下文中调用，不可与mg6010e_poll_tick并发。
+ */
+uint8_t mg6010e_poll_adaptive(uint8_t motor_id, uint8_t item, uint16_t min_hz, uint16_t max_hz)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if ((item != MG6010E_POLL_STATUS_1 && item != MG6010E_POLL_STATUS_2 && item != MG6010E_POLL_ANGLE) || max_hz < min_hz)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_adapt_t *adapt = &mg6010e_adapt_table[mg6010e_handle - mg6010e_handle_pool];
+    if (min_hz == 0)
+    {
+        adapt->adaptive &= (uint8_t)~(1U << item);
+        mg6010e_poll_schedule(mg6010e_handle, item, 0);
+        return MG6010E_SUCCESS;
+    }
+    min_hz = min_hz > MG6010E_POLL_TICK_HZ ? MG6010E_POLL_TICK_HZ : min_hz;
+    max_hz = max_hz > MG6010E_POLL_TICK_HZ ? MG6010E_POLL_TICK_HZ : max_hz;
+    adapt->min_hz[item] = min_hz;
+    adapt->max_hz[item] = max_hz;
+    adapt->demand_hz[item] = min_hz;
+    adapt->activity[item] = 0;
+    adapt->adaptive |= (uint8_t)(1U << item);
+    adapt->sample_tick = mg6010e_poll_tick_count;
+    mg6010e_poll_schedule(mg6010e_handle, item, (uint16_t)((MG6010E_POLL_TICK_HZ + min_hz - 1) / min_hz));
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 设置CAN总线用于轮询的带宽预算
+ *
+ * @param can_handle CAN句柄
+ * @param percent 轮询（读取命令与回复）允许占用的总线带宽百分比（1-100），0表示使用MG6010E_POLL_BUDGET_PERCENT
+ * @return uint8_t 错误码，0表示成功，2表示总线未注册，12表示参数无效
+ * @note 在下一次mg6010e_poll_adapt时生效。固定频率轮询项（mg6010e_poll_register）同样计入预算，但不会被缩减。
+ */
+uint8_t mg6010e_set_poll_budget(mg6010e_can_t *can_handle, uint8_t percent)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (percent > 100)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_adapt_budget_percent[bus - mg6010e_bus_table] = percent;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 按电机自上次调整以来的转速、转矩电流与错误状态计算各自适应轮询项的活动度与期望频率
+ *
+ * @param adapt 自适应轮询状态
+ * @note 本次没有反馈时保持原活动度；超过状态2的两个轮询周期没有反馈时视为反馈中断（如电机掉线），活动度归零，
+ * 不会一直按最后一次的活动度以较高频率轮询没有回复的电机。
+ */
+static void mg6010e_adapt_demand(mg6010e_adapt_t *adapt)
+{
+    uint32_t samples = atomic_exchange_explicit(&adapt->samples, 0, memory_order_relaxed);
+    uint32_t speed = atomic_exchange_explicit(&adapt->speed_peak, 0, memory_order_relaxed);
+    uint32_t slew = atomic_exchange_explicit(&adapt->slew_peak, 0, memory_order_relaxed);
+    uint32_t iq = atomic_exchange_explicit(&adapt->iq_peak, 0, memory_order_relaxed);
+    uint8_t error_state = atomic_load_explicit(&adapt->error_state, memory_order_relaxed);
+    uint32_t speed_activity = (uint32_t)((uint64_t)speed * 1000U / MG6010E_ADAPT_SPEED_FULL);
+    uint32_t slew_activity = (uint32_t)((uint64_t)slew * 1000U / MG6010E_ADAPT_IQ_SLEW_FULL);
+    uint32_t stale_ticks = 2U * mg6010e_poll_table[adapt - mg6010e_adapt_table].items[MG6010E_POLL_STATUS_2].period;
+    if (samples != 0)
+    {
+        adapt->sample_tick = mg6010e_poll_tick_count;
+    }
+    uint8_t stale = samples == 0 && stale_ticks != 0 && mg6010e_poll_tick_count - adapt->sample_tick > stale_ticks;
+
+    for (uint32_t item = 0; item < MG6010E_POLL_ITEM_NUM; item++)
+    {
+        if (!(adapt->adaptive & (1U << item)))
+        {
+            continue;
+        }
+        uint32_t activity = adapt->activity[item]; // 本周期没有反馈时保持原活动度
+        if (stale)
+        {
+            activity = 0;
+        }
+        else if (item == MG6010E_POLL_STATUS_1)
+        {
+            activity = error_state != 0 ? 1000 : samples != 0 ? (uint32_t)((uint64_t)iq * 1000U / MG6010E_ADAPT_IQ_LOAD_FULL) : activity;
+        }
+        else if (samples != 0)
+        {
+            activity = item == MG6010E_POLL_STATUS_2 && slew_activity > speed_activity ? slew_activity : speed_activity;
+        }
+        activity = activity > 1000 ? 1000 : activity;
+        adapt->activity[item] = (uint16_t)activity;
+
+        // 升高立即生效，降低每次只回落一半，避免运动间隙中频率来回跳变
+        uint32_t target = adapt->min_hz[item] + (uint32_t)(adapt->max_hz[item] - adapt->min_hz[item]) * activity / 1000U;
+        uint32_t demand = adapt->demand_hz[item];
+        adapt->demand_hz[item] = (uint16_t)(target >= demand ? target : target + (demand - target) / 2);
+    }
+}
+
+/**
+ * @brief 自适应轮询调整函数，按电机动态更新自适应轮询项的频率，并将每条总线的轮询限制在预算内
+ *
+ * @note 建议以10~50Hz在任务中调用，仅在任务上下文中调用，不可与mg6010e_poll_tick并发。
+ * 每次读取按命令与回复两帧的最坏情况位数计算，总线预算扣除固定频率轮询项后，先保证各自适应项的最低频率，
+ * 剩余部分按同一比例分给期望频率中高于最低频率的部分；最低频率之和已超出预算时按比例降低最低频率（至少1Hz）。
+ * 轮询周期向上取整，只有周期变化的轮询项会重新选择相位。
+ */
+void mg6010e_poll_adapt(void)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        if (mg6010e_handle_pool[i].initialized && mg6010e_adapt_table[i].adaptive != 0)
+        {
+            mg6010e_adapt_demand(&mg6010e_adapt_table[i]);
+        }
+    }
+
+    for (uint32_t bus_index = 0; bus_index < MG6010E_MAX_CAN_BUS; bus_index++)
+    {
+        if (mg6010e_bus_table[bus_index].can_handle == NULL)
+        {
+            continue;
+        }
+        mg6010e_poll_budget_t *budget = &mg6010e_adapt_budget[bus_index];
+        uint32_t percent = mg6010e_adapt_budget_percent[bus_index] != 0 ? mg6010e_adapt_budget_percent[bus_index] : MG6010E_POLL_BUDGET_PERCENT;
+        budget->budget_hz = (uint32_t)((uint64_t)MG6010E_CAN_BITRATE * percent / 100U / (2U * MG6010E_CAN_FRAME_BITS_MAX(8)));
+        budget->fixed_hz = 0;
+        budget->minimum_hz = 0;
+        budget->demand_hz = 0;
+        budget->granted_hz = 0;
+        for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+        {
+            if (!mg6010e_handle_pool[i].initialized || mg6010e_handle_pool[i].bus_index != bus_index)
+            {
+                continue;
+            }
+            for (uint32_t item = 0; item < MG6010E_POLL_ITEM_NUM; item++)
+            {
+                if (mg6010e_adapt_table[i].adaptive & (1U << item))
+                {
+                    budget->minimum_hz += mg6010e_adapt_table[i].min_hz[item];
+                    budget->demand_hz += mg6010e_adapt_table[i].demand_hz[item];
+                }
+                else if (mg6010e_poll_table[i].items[item].period != 0)
+                {
+                    budget->fixed_hz += MG6010E_POLL_TICK_HZ / mg6010e_poll_table[i].items[item].period;
+                }
+            }
+        }
+
+        // 最低频率与高于最低频率部分各自的缩放比例，单位0.1%
+        uint32_t available = budget->budget_hz > budget->fixed_hz ? budget->budget_hz - budget->fixed_hz : 0;
+        uint32_t minimum_scale = 1000;
+        uint32_t scale = 1000;
+        if (budget->demand_hz > available)
+        {
+            if (budget->minimum_hz <= available)
+            {
+                scale = (uint32_t)((uint64_t)(available - budget->minimum_hz) * 1000U / (budget->demand_hz - budget->minimum_hz));
+            }
+            else
+            {
+                minimum_scale = (uint32_t)((uint64_t)available * 1000U / budget->minimum_hz);
+                scale = 0;
+            }
+        }
+        budget->scale = (uint16_t)scale;
+
+        for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+        {
+            mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+            mg6010e_adapt_t *adapt = &mg6010e_adapt_table[i];
+            if (!mg6010e_handle->initialized || mg6010e_handle->bus_index != bus_index || adapt->adaptive == 0)
+            {
+                continue;
+            }
+            for (uint32_t item = 0; item < MG6010E_POLL_ITEM_NUM; item++)
+            {
+                if (!(adapt->adaptive & (1U << item)))
+                {
+                    continue;
+                }
+                uint32_t rate = adapt->min_hz[item] * minimum_scale / 1000U + (uint32_t)(adapt->demand_hz[item] - adapt->min_hz[item]) * scale / 1000U;
+                rate = rate == 0 ? 1 : rate;
+                uint32_t period = (MG6010E_POLL_TICK_HZ + rate - 1) / rate;
+                period = period > UINT16_MAX ? UINT16_MAX : period;
+                if (mg6010e_poll_table[i].items[item].period != period)
+                {
+                    mg6010e_poll_schedule(mg6010e_handle, (uint8_t)item, (uint16_t)period);
+                    budget->changes++;
+                }
+                budget->granted_hz += MG6010E_POLL_TICK_HZ / period;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 获取电机各轮询项的当前频率与自适应状态
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param rates 输出
+ * @return uint8_t 错误码，0表示成功，1表示参数为空，4表示未初始化
+ */
+uint8_t mg6010e_get_poll_rates(uint8_t motor_id, mg6010e_poll_rates_t *rates)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (rates == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    uint32_t index = (uint32_t)(mg6010e_handle - mg6010e_handle_pool);
+    const mg6010e_adapt_t *adapt = &mg6010e_adapt_table[index];
+    memset(rates, 0, sizeof(mg6010e_poll_rates_t));
+    for (uint32_t item = 0; item < MG6010E_POLL_ITEM_NUM; item++)
+    {
+        uint16_t period = mg6010e_poll_table[index].items[item].period;
+        rates->rate_hz[item] = (uint16_t)(period != 0 ? MG6010E_POLL_TICK_HZ / period : 0);
+        if (adapt->adaptive & (1U << item))
+        {
+            rates->demand_hz[item] = adapt->demand_hz[item];
+            rates->activity[item] = adapt->activity[item];
+        }
+    }
+    rates->adaptive = adapt->adaptive;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 获取CAN总线最近一次自适应轮询调整的预算分配结果
+ *
+ * @param can_handle CAN句柄
+ * @param budget 输出
+ * @return uint8_t 错误码，0表示成功，1表示参数为空，2表示总线未注册
+ */
+uint8_t mg6010e_get_poll_budget(mg6010e_can_t *can_handle, mg6010e_poll_budget_t *budget)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (budget == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *budget = mg6010e_adapt_budget[bus - mg6010e_bus_table];
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_ADAPTIVE_POLL */
+
+#if MG6010E_USE_TRAJECTORY
+/**
+ * @brief 进入轨迹的某一段，计算该段的插值系数
+ *
+ * @param traj 轨迹状态
+ * @param segment 段起点的路点序号
+ * @note 每段只计算一次，段内每个tick的插值只用乘法与移位，适合没有64位除法指令的Cortex-M4
+ */
+static void mg6010e_traj_enter_segment(mg6010e_traj_t *traj, uint8_t segment)
+{
+    const mg6010e_traj_knot_t *k0 = &traj->knots[segment];
+    const mg6010e_traj_knot_t *k1 = &traj->knots[segment + 1];
+    uint32_t duration = k1->tick - k0->tick;
+    traj->segment = segment;
+    traj->inv_duration = UINT32_MAX / duration;
+    traj->delta = (int32_t)((int64_t)k1->value - k0->value);
+    traj->m0 = (int32_t)((int64_t)k0->velocity * duration / MG6010E_TRAJ_TICK_HZ);
+    traj->m1 = (int32_t)((int64_t)k1->velocity * duration / MG6010E_TRAJ_TICK_HZ);
+    traj->speed_scale = (uint32_t)(((uint64_t)MG6010E_TRAJ_TICK_HZ << 24) / ((uint64_t)duration * 100));
+}
+
+/**
+ * @brief 计算轨迹在当前tick的设定值
+ *
+ * @param traj 轨迹状态，当前tick位于traj->segment段内
+ * @param speed 轨迹速度输出，单位dps，角度轨迹使用
+ * @return int32_t 设定值
+ * @note 段内归一化时间u为Q16定点数，线性插值为 p0 + u·Δ；三次Hermite插值为
+ * p0 + (3u²-2u³)·Δ + (u³-2u²+u)·m0 + (u³-u²)·m1，速度为其对u的导数除以段时长
+ */
+static int32_t mg6010e_traj_evaluate(const mg6010e_traj_t *traj, int32_t *speed)
+{
+    const mg6010e_traj_knot_t *k0 = &traj->knots[traj->segment];
+    int64_t u = (int64_t)(((uint64_t)(traj->tick - k0->tick) * traj->inv_duration) >> 16);
+    int64_t offset;
+    int64_t slope; // 对u的导数，单位同路点值
+    if (traj->config.mode == MG6010E_TRAJ_ANGLE_CUBIC)
+    {
+        int64_t u2 = (u * u) >> 16;
+        int64_t u3 = (u2 * u) >> 16;
+        offset = ((3 * u2 - 2 * u3) * traj->delta + (u3 - 2 * u2 + u) * traj->m0 + (u3 - u2) * traj->m1) >> 16;
+        slope = ((6 * u - 6 * u2) * traj->delta + (3 * u2 - 4 * u + 65536) * traj->m0 + (3 * u2 - 2 * u) * traj->m1) >> 16;
+    }
+    else
+    {
+        offset = (u * traj->delta) >> 16;
+        slope = traj->delta;
+    }
+    *speed = (int32_t)((slope * (int64_t)traj->speed_scale) >> 24);
+    return (int32_t)(k0->value + offset);
+}
+
+/**
+ * @brief 发出一个轨迹设定值
+ *
+ * @param mg6010e_handle 电机句柄指针
+ * @param traj 轨迹状态
+ * @param value 设定值
+ * @param speed 轨迹速度，单位dps，角度轨迹以其绝对值加余量作为0xA4的最大速度
+ */
+static void mg6010e_traj_send(mg6010e_handle_t *mg6010e_handle, mg6010e_traj_t *traj, int32_t value, int32_t speed)
+{
+    uint8_t motor_id = MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id);
+    uint8_t ret;
+    if (traj->config.mode == MG6010E_TRAJ_SPEED_LINEAR)
+    {
+        traj->cmd_value = value;
+        traj->cmd_speed = value / 100;
+        ret = mg6010e_speed_control(motor_id, traj->config.iq_limit, value);
+    }
+    else
+    {
+        uint32_t max_speed = (uint32_t)(speed < 0 ? -(int64_t)speed : speed) * (100U + traj->config.speed_margin) / 100U;
+        if (max_speed < traj->config.min_speed)
+        {
+            max_speed = traj->config.min_speed;
+        }
+        traj->cmd_value = value; // 先于发送更新，回复可能在发送返回前到达
+        traj->cmd_speed = speed;
+        ret = mg6010e_angle_control_2(motor_id, value, (uint16_t)(max_speed > UINT16_MAX ? UINT16_MAX : max_speed));
+    }
+    if (ret == MG6010E_SUCCESS)
+    {
+        traj->stats.setpoints++;
+    }
+    else
+    {
+        traj->stats.send_failures++;
+    }
+}
+
+/**
+ * @brief 记录一次跟踪误差
+ */
+static inline void mg6010e_traj_error_record(mg6010e_traj_error_t *stats, int64_t error)
+{
+    error = error > INT32_MAX ? INT32_MAX : (error < -INT32_MAX ? -INT32_MAX : error);
+    uint32_t magnitude = (uint32_t)(error < 0 ? -error : error);
+    stats->samples++;
+    stats->last = (int32_t)error;
+    stats->sum += magnitude;
+    if (magnitude > stats->max)
+    {
+        stats->max = magnitude;
+    }
+}
+
+/**
+ * @brief 在接收中断中用反馈更新轨迹跟踪误差
+ *
+ * @param mg6010e_handle 电机句柄指针，反馈已写入句柄
+ * @param rx_data 反馈数据
+ */
+static inline void mg6010e_traj_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data)
+{
+    mg6010e_traj_t *traj = &mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool];
+    uint8_t state = atomic_load_explicit(&traj->state, memory_order_relaxed);
+    if (state != MG6010E_TRAJ_RUNNING && state != MG6010E_TRAJ_DONE)
+    {
+        return;
+    }
+    uint8_t speed_mode = traj->config.mode == MG6010E_TRAJ_SPEED_LINEAR;
+    if (rx_data[0] == (speed_mode ? 0xA2 : 0xA4))
+    {
+        mg6010e_traj_error_record(&traj->stats.speed_error, (int64_t)mg6010e_handle->status.speed - traj->cmd_speed);
+    }
+    else if (rx_data[0] == 0x92 && !speed_mode)
+    {
+        mg6010e_traj_error_record(&traj->stats.angle_error, mg6010e_handle->status.angle - traj->cmd_value);
+    }
+}
+
+/**
+ * @brief 加载领控6010E电机的轨迹
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param config 轨迹配置
+ * @param points 路点数组，时间从0开始严格递增（换算为tick后），相邻路点的值之差不超过INT32_MAX
+ * @param count 路点数（1 ~ MG6010E_TRAJ_POINT_NUM），为1时启动后只发送一次该值
+ * @return uint8_t 错误码，0表示成功，1表示指针为空，4表示未初始化，12表示路点数、配置或路点无效
+ * @note 路点被复制到驱动内部。加载会停止该电机正在执行的轨迹并清零其统计，加载后由mg6010e_traj_start启动。
+ * 仅在任务上下文中调用，不可与mg6010e_traj_tick并发。
+ */
+uint8_t mg6010e_traj_load(uint8_t motor_id, const mg6010e_traj_config_t *config, const mg6010e_traj_point_t *points, uint8_t count)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (config == NULL || points == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (count < 1 || count > MG6010E_TRAJ_POINT_NUM || config->mode > MG6010E_TRAJ_SPEED_LINEAR || config->rate_hz == 0 || points[0].time_ms != 0)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_traj_knot_t knots[MG6010E_TRAJ_POINT_NUM];
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t tick = (uint64_t)points[i].time_ms * MG6010E_TRAJ_TICK_HZ / 1000U;
+        if (tick > UINT32_MAX)
+        {
+            return MG6010E_ERROR_INVALID_PARAM;
+        }
+        if (i > 0)
+        {
+            int64_t delta = (int64_t)points[i].value - points[i - 1].value;
+            if (tick <= knots[i - 1].tick || delta > INT32_MAX || delta < -INT32_MAX)
+            {
+                return MG6010E_ERROR_INVALID_PARAM;
+            }
+        }
+        knots[i].tick = (uint32_t)tick;
+        knots[i].value = points[i].value;
+        knots[i].velocity = points[i].velocity;
+    }
+
+    mg6010e_traj_t *traj = &mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool];
+    atomic_store_explicit(&traj->state, MG6010E_TRAJ_IDLE, memory_order_relaxed);
+    traj->config = *config;
+    memcpy(traj->knots, knots, sizeof(mg6010e_traj_knot_t) * count);
+    traj->count = count;
+    traj->start_pending = 0;
+    traj->period = (uint16_t)(config->rate_hz >= MG6010E_TRAJ_TICK_HZ ? 1 : MG6010E_TRAJ_TICK_HZ / config->rate_hz);
+    traj->tick = 0;
+    memset(&traj->stats, 0, sizeof(mg6010e_traj_stats_t));
+    atomic_store_explicit(&traj->state, MG6010E_TRAJ_LOADED, memory_order_relaxed);
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 同步启动一组电机的轨迹
+ *
+ * @param motor_ids 电机编号数组，见MG6010E_MOTOR
+ * @param count 电机数量
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，4表示某个电机未初始化或未加载轨迹（此时所有电机均不启动），12表示电机数量为0
+ * @note 所有电机在下一次mg6010e_traj_tick中从同一tick开始，发送频率相同的电机在同一tick发出设定值，各帧在发送队列中相邻。
+ * 已执行完的轨迹可以再次启动。仅在任务上下文中调用，不可与mg6010e_traj_tick并发。
+ */
+uint8_t mg6010e_traj_start(const uint8_t *motor_ids, uint8_t count)
+{
+    if (motor_ids == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (count == 0)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_ids[i]);
+        if (mg6010e_handle == NULL || atomic_load_explicit(&mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool].state, memory_order_relaxed) == MG6010E_TRAJ_IDLE)
+        {
+            return MG6010E_ERROR_NOT_INITIALIZED;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        mg6010e_traj_table[mg6010e_get_handle_by_id(motor_ids[i]) - mg6010e_handle_pool].start_pending = 1;
+    }
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 停止发送领控6010E电机的轨迹设定值
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @note 电机保持最后收到的设定值。轨迹保留，可再次启动。仅在任务上下文中调用，不可与mg6010e_traj_tick并发。
+ */
+uint8_t mg6010e_traj_stop(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    mg6010e_traj_t *traj = &mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool];
+    traj->start_pending = 0;
+    if (atomic_load_explicit(&traj->state, memory_order_relaxed) != MG6010E_TRAJ_IDLE)
+    {
+        atomic_store_explicit(&traj->state, MG6010E_TRAJ_LOADED, memory_order_relaxed);
+    }
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 领控6010E电机轨迹节拍函数
+ *
+ * @note 请以MG6010E_TRAJ_TICK_HZ的频率在定时器中断或任务中调用。每个正在执行的轨迹按其发送周期插值并发出设定值，
+ * 到达最后一个路点时发出终点值并结束。设定值与普通控制命令一样经过发送队列（及总线预算、请求跟踪等）。
+ */
+void mg6010e_traj_tick(void)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+        mg6010e_traj_t *traj = &mg6010e_traj_table[i];
+        if (!mg6010e_handle->initialized)
+        {
+            continue;
+        }
+        if (traj->start_pending)
+        {
+            traj->start_pending = 0;
+            traj->tick = 0;
+            if (traj->count > 1)
+            {
+                mg6010e_traj_enter_segment(traj, 0);
+            }
+            atomic_store_explicit(&traj->state, MG6010E_TRAJ_RUNNING, memory_order_relaxed);
+        }
+        if (atomic_load_explicit(&traj->state, memory_order_relaxed) != MG6010E_TRAJ_RUNNING)
+        {
+            continue;
+        }
+        const mg6010e_traj_knot_t *last = &traj->knots[traj->count - 1];
+        if (traj->tick >= last->tick)
+        {
+            mg6010e_traj_send(mg6010e_handle, traj, last->value, traj->count > 1 ? last->velocity / 100 : 0);
+            atomic_store_explicit(&traj->state, MG6010E_TRAJ_DONE, memory_order_relaxed);
+            continue;
+        }
+        while (traj->tick >= traj->knots[traj->segment + 1].tick)
+        {
+            mg6010e_traj_enter_segment(traj, (uint8_t)(traj->segment + 1));
+        }
+        if (traj->tick % traj->period == 0)
+        {
+            int32_t speed;
+            int32_t value = mg6010e_traj_evaluate(traj, &speed);
+            mg6010e_traj_send(mg6010e_handle, traj, value, speed);
+        }
+        traj->tick++;
+    }
+}
+
+/**
+ * @brief 获取领控6010E电机的轨迹执行状态与跟踪误差统计
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param stats 统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，4表示未初始化
+ */
+uint8_t mg6010e_traj_get_stats(uint8_t motor_id, mg6010e_traj_stats_t *stats)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    const mg6010e_traj_t *traj = &mg6010e_traj_table[mg6010e_handle - mg6010e_handle_pool];
+    *stats = traj->stats;
+    stats->state = atomic_load_explicit(&traj->state, memory_order_relaxed);
+    stats->elapsed_ms = (uint32_t)((uint64_t)traj->tick * 1000U / MG6010E_TRAJ_TICK_HZ);
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_TRAJECTORY */
+
+#if MG6010E_USE_COALESCE
+/**
+ * @brief 设置控制命令合并的去重策略
+ *
+ * @param skip_unchanged 为1时跳过与上次发出的命令完全相同的控制命令
+ * @param keepalive_cycles 相同的命令至少每隔多少次mg6010e_coalesce_flush重发一次，0表示一直跳过
+ * @note 跳过的命令没有回复，需要反馈数据时请用keepalive_cycles或自动轮询状态2保持刷新。仅在任务上下文中调用。
+ */
+void mg6010e_set_coalesce_policy(uint8_t skip_unchanged, uint16_t keepalive_cycles)
+{
+    mg6010e_coalesce_skip_unchanged = skip_unchanged ? 1 : 0;
+    mg6010e_coalesce_keepalive = keepalive_cycles;
+}
+
+/**
+ * @brief 发出一个电机的待发控制命令
+ *
+ * @note 复制期间命令被改写时重新读取，MG6010E_COALESCE_RETRY次后仍冲突则不发出、计入contended，
+ * 槽位保持待发，下一周期发出最新写入的命令，不会发出新旧混合的帧。
+ */
+static void mg6010e_coalesce_flush_one(mg6010e_handle_t *mg6010e_handle, mg6010e_coalesce_t *coalesce)
+{
+    mg6010e_tx_frame_t frame;
+    uint32_t seq;
+    uint32_t retry = 0;
+    for (; retry < MG6010E_COALESCE_RETRY; retry++)
+    {
+        seq = atomic_load_explicit(&coalesce->slot.sequence, memory_order_acquire);
+        if ((seq & (MG6010E_COALESCE_WRITING | MG6010E_COALESCE_PENDING)) != MG6010E_COALESCE_PENDING)
+        {
+            return; // 无待发命令，或正在写入（写入完成后下一周期发出）
+        }
+        frame = coalesce->slot.frame;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_compare_exchange_strong_explicit(&coalesce->slot.sequence, &seq, seq & ~MG6010E_COALESCE_PENDING, memory_order_relaxed, memory_order_relaxed))
+        {
+            break; // 复制期间未被改写，命令已取走
+        }
+    }
+    if (retry == MG6010E_COALESCE_RETRY)
+    {
+        coalesce->stats.contended++;
+        return;
+    }
+#if MG6010E_USE_HEALTH
+    if (mg6010e_health_blocked(mg6010e_handle))
+    {
+        coalesce->stats.overwritten++; // 故障锁存前写入的命令不再发出
+        return;
+    }
+#endif
+
+    if (mg6010e_coalesce_skip_unchanged && coalesce->last_valid && memcmp(frame.data, coalesce->last_data, 8) == 0 &&
+        (mg6010e_coalesce_keepalive == 0 || mg6010e_coalesce_cycle - coalesce->last_cycle < mg6010e_coalesce_keepalive))
+    {
+        coalesce->stats.skipped++;
+        return;
+    }
+    mg6010e_tx_slot_t *slot = mg6010e_tx_claim(&mg6010e_bus_table[mg6010e_handle->bus_index]);
+    if (slot == NULL)
+    {
+        // 放回待发槽位；若取走后已有写者改写则保留后者
+        uint32_t taken = seq & ~MG6010E_COALESCE_PENDING;
+        atomic_compare_exchange_strong_explicit(&coalesce->slot.sequence, &taken, seq, memory_order_relaxed, memory_order_relaxed);
+        coalesce->stats.queue_full++;
+        return;
+    }
+    slot->frame = frame;
+    memcpy(coalesce->last_data, frame.data, 8);
+    coalesce->last_valid = 1;
+    coalesce->last_cycle = mg6010e_coalesce_cycle;
+    coalesce->stats.sent++;
+    mg6010e_cmd_commit(mg6010e_handle, slot);
+}
+
+/**
+ * @brief 发出所有电机的待发控制命令
+ *
+ * @note 请在每个控制周期写完所有设定值后调用一次（如在控制任务末尾，或mg6010e_traj_tick之后）。
+ * 每个电机本周期最多发出一帧控制命令，即最后写入的那一条；发送队列已满时该命令留到下一周期。
+ * 控制命令接口可在中断中调用，但同一电机的控制命令只应有一个写者，冲突时返回MG6010E_ERROR_BUSY。
+ * 仅在任务上下文中调用，不可重入。
+ */
+void mg6010e_coalesce_flush(void)
+{
+    mg6010e_coalesce_cycle++;
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        if (mg6010e_handle_pool[i].initialized)
+        {
+            mg6010e_coalesce_flush_one(&mg6010e_handle_pool[i], &mg6010e_coalesce_table[i]);
+        }
+    }
+}
+
+/**
+ * @brief 获取领控6010E电机的控制命令合并统计
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR；为0时返回所有已初始化电机的合计
+ * @param stats 统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，4表示未初始化
+ */
+uint8_t mg6010e_get_coalesce_stats(uint8_t motor_id, mg6010e_coalesce_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (motor_id != 0)
+    {
+        mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+        if (mg6010e_handle == NULL)
+        {
+            return MG6010E_ERROR_NOT_INITIALIZED;
+        }
+        *stats = mg6010e_coalesce_table[mg6010e_handle - mg6010e_handle_pool].stats;
+        return MG6010E_SUCCESS;
+    }
+    *stats = (mg6010e_coalesce_stats_t){0};
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        if (!mg6010e_handle_pool[i].initialized)
+        {
+            continue;
+        }
+        const mg6010e_coalesce_stats_t *motor = &mg6010e_coalesce_table[i].stats;
+        stats->written += motor->written;
+        stats->overwritten += motor->overwritten;
+        stats->skipped += motor->skipped;
+        stats->sent += motor->sent;
+        stats->queue_full += motor->queue_full;
+        stats->contended += motor->contended;
+    }
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_COALESCE */
+
+#if MG6010E_USE_PARAMS_SNAPSHOT
+/**
+ * @brief 取得控制参数ID在快照中的序号，不在快照中时返回MG6010E_PARAMS_NUM
+ */
+static inline uint32_t mg6010e_params_index(uint8_t param_id)
+{
+    uint32_t index = 0;
+    while (index < MG6010E_PARAMS_NUM && mg6010e_params_id[index] != param_id)
+    {
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief 在接收中断中记录控制参数读写命令的回复
+ */
+static inline void mg6010e_params_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data)
+{
+    if (rx_data[0] != 0xC0 && rx_data[0] != 0xC1)
+    {
+        return;
+    }
+    uint32_t index = mg6010e_params_index(rx_data[1]);
+    if (index == MG6010E_PARAMS_NUM)
+    {
+        return;
+    }
+    mg6010e_params_entry_t *entry = &mg6010e_params_table[mg6010e_handle - mg6010e_handle_pool];
+    if (rx_data[0] == 0xC0)
+    {
+        memcpy(entry->value[index], rx_data + 2, 6);
+        atomic_fetch_or_explicit(&entry->read_mask, (uint8_t)(1U << index), memory_order_release);
+    }
+    else
+    {
+        atomic_fetch_or_explicit(&entry->write_mask, (uint8_t)(1U << index), memory_order_release);
+    }
+}
+
+/**
+ * @brief 计算CRC-16/CCITT-FALSE
+ */
+static uint16_t mg6010e_params_crc16(const uint8_t *data, uint32_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 清除所有电机的快照/恢复状态并开始新的操作
+ *
+ * @param op 操作，MG6010E_PARAMS_OP_SNAPSHOT或MG6010E_PARAMS_OP_RESTORE
+ */
+static void mg6010e_params_begin(uint8_t op)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_params_entry_t *entry = &mg6010e_params_table[i];
+        memset(entry->stage, MG6010E_PARAMS_IDLE, sizeof(entry->stage));
+        memset(entry->attempts, 0, sizeof(entry->attempts));
+    }
+    mg6010e_params_op = op;
+    mg6010e_params_result = MG6010E_ERROR_BUSY;
+    mg6010e_params_start_time = mg6010e_get_timestamp_us();
+    mg6010e_params_elapsed_us = 0;
+}
+
+/**
+ * @brief 开始读取所有已初始化电机的控制参数快照
+ *
+ * @return uint8_t 错误码，0表示已开始，4表示没有已初始化的电机，8表示上一次快照或恢复尚未结束
+ * @note 所有电机的0xC0读取请求以流水线方式交错发出，每条总线同时等待回复的请求不超过MG6010E_PARAMS_WINDOW个，
+ * 由mg6010e_params_poll推进。完成后可用mg6010e_params_serialize导出，读取的参数也已写入各电机句柄的control_params。
+ * 快照与恢复相关接口仅在任务上下文中调用，不可并发。
+ */
+uint8_t mg6010e_snapshot_params_all(void)
+{
+    if (mg6010e_params_result == MG6010E_ERROR_BUSY)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    mg6010e_params_begin(MG6010E_PARAMS_OP_SNAPSHOT);
+    uint32_t motors = 0;
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        if (mg6010e_handle_pool[i].initialized)
+        {
+            memset(mg6010e_params_table[i].stage, MG6010E_PARAMS_READ, MG6010E_PARAMS_NUM);
+            motors++;
+        }
+    }
+    if (motors == 0)
+    {
+        mg6010e_params_result = MG6010E_ERROR_NOT_INITIALIZED;
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    mg6010e_params_poll();
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 开始将控制参数快照写回电机并读回校验
+ *
+ * @param blob mg6010e_params_serialize导出的快照，开始后即可释放
+ * @param length 快照长度，单位字节
+ * @return uint8_t 错误码，0表示已开始，1表示快照为空，4表示快照中的电机未初始化，8表示上一次快照或恢复尚未结束，
+ * 12表示快照长度、格式或校验和错误
+ * @note 每个参数先以0xC1写入RAM（断电后失效），收到回复后再以0xC0读回并与写入值比较，由mg6010e_params_poll推进。
+ */
+uint8_t mg6010e_restore_params_all(const uint8_t *blob, uint32_t length)
+{
+    if (mg6010e_params_result == MG6010E_ERROR_BUSY)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    if (blob == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    uint8_t magic[4];
+    mg6010e_put_le(magic, (uint32_t)MG6010E_PARAMS_MAGIC);
+    if (length < MG6010E_PARAMS_HEADER_SIZE || memcmp(blob, magic, 4) != 0 || blob[4] != MG6010E_PARAMS_VERSION ||
+        length != MG6010E_PARAMS_BLOB_SIZE((uint32_t)blob[5]) ||
+        mg6010e_params_crc16(blob + MG6010E_PARAMS_HEADER_SIZE, length - MG6010E_PARAMS_HEADER_SIZE) != (uint16_t)(blob[6] | (blob[7] << 8)))
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    const uint8_t *record = blob + MG6010E_PARAMS_HEADER_SIZE;
+    for (uint32_t m = 0; m < blob[5]; m++)
+    {
+        if (mg6010e_get_handle_by_id(record[m * MG6010E_PARAMS_RECORD_SIZE]) == NULL)
+        {
+            return MG6010E_ERROR_NOT_INITIALIZED;
+        }
+    }
+    mg6010e_params_begin(MG6010E_PARAMS_OP_RESTORE);
+    for (uint32_t m = 0; m < blob[5]; m++, record += MG6010E_PARAMS_RECORD_SIZE)
+    {
+        mg6010e_params_entry_t *entry = &mg6010e_params_table[mg6010e_get_handle_by_id(record[0]) - mg6010e_handle_pool];
+        memcpy(entry->target, record + 1, sizeof(entry->target));
+        memset(entry->stage, MG6010E_PARAMS_WRITE, MG6010E_PARAMS_NUM);
+    }
+    if (blob[5] == 0)
+    {
+        mg6010e_params_result = MG6010E_SUCCESS;
+        return MG6010E_SUCCESS;
+    }
+    mg6010e_params_poll();
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 检查一个已发出的请求是否收到回复或超时，更新其阶段
+ *
+ * @return uint8_t 1表示仍在等待回复
+ */
+static uint8_t mg6010e_params_check(const mg6010e_handle_t *mg6010e_handle, mg6010e_params_entry_t *entry, uint32_t index, uint32_t now)
+{
+    uint8_t *stage = &entry->stage[index];
+    _Atomic uint8_t *mask = *stage == MG6010E_PARAMS_WRITE_SENT ? &entry->write_mask : &entry->read_mask;
+    if (atomic_load_explicit(mask, memory_order_acquire) & (1U << index))
+    {
+        entry->attempts[index] = 0;
+        if (*stage == MG6010E_PARAMS_WRITE_SENT)
+        {
+            *stage = MG6010E_PARAMS_READ;
+        }
+        else if (mg6010e_params_op == MG6010E_PARAMS_OP_RESTORE && memcmp(entry->value[index], entry->target[index], 6) != 0)
+        {
+            *stage = MG6010E_PARAMS_MISMATCH;
+        }
+        else
+        {
+            *stage = MG6010E_PARAMS_DONE;
+        }
+        return 0;
+    }
+    if (!mg6010e_handle->initialized)
+    {
+        *stage = MG6010E_PARAMS_FAILED;
+        return 0;
+    }
+    if (now - entry->sent_time[index] < MG6010E_PARAMS_TIMEOUT_US)
+    {
+        return 1;
+    }
+    *stage = entry->attempts[index] > MG6010E_PARAMS_RETRY ? MG6010E_PARAMS_FAILED : (uint8_t)(*stage - 1); // 回到待发送阶段
+    return 0;
+}
+
+/**
+ * @brief 推进控制参数快照或恢复
+ *
+ * @return uint8_t 错误码，0表示已完成，4表示尚未开始任何快照或恢复，8表示进行中，
+ * 9表示已结束但有参数重发后仍无回复，10表示恢复已结束但有参数读回值与写入值不一致
+ * @note 请在任务中周期性调用直至不再返回8，调用越频繁，窗口空出后补发请求越及时。
+ * 收到回复的请求让出窗口，超时MG6010E_PARAMS_TIMEOUT_US的请求最多重发MG6010E_PARAMS_RETRY次。
+ */
+uint8_t mg6010e_params_poll(void)
+{
+    if (mg6010e_params_op == MG6010E_PARAMS_OP_NONE)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (mg6010e_params_result != MG6010E_ERROR_BUSY)
+    {
+        return mg6010e_params_result;
+    }
+    uint32_t now = mg6010e_get_timestamp_us();
+    uint32_t outstanding[MG6010E_MAX_CAN_BUS] = {0};
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_params_entry_t *entry = &mg6010e_params_table[i];
+        for (uint32_t p = 0; p < MG6010E_PARAMS_NUM; p++)
+        {
+            if ((entry->stage[p] == MG6010E_PARAMS_WRITE_SENT || entry->stage[p] == MG6010E_PARAMS_READ_SENT) &&
+                mg6010e_params_check(&mg6010e_handle_pool[i], entry, p, now))
+            {
+                outstanding[mg6010e_handle_pool[i].bus_index]++;
+            }
+        }
+    }
+
+    // 参数序号在外层，使同一总线上各电机的请求交错发出
+    uint8_t pending = 0;
+    uint8_t failed = 0;
+    uint8_t mismatched = 0;
+    for (uint32_t p = 0; p < MG6010E_PARAMS_NUM; p++)
+    {
+        for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+        {
+            mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+            mg6010e_params_entry_t *entry = &mg6010e_params_table[i];
+            uint8_t stage = entry->stage[p];
+            if ((stage == MG6010E_PARAMS_WRITE || stage == MG6010E_PARAMS_READ) && outstanding[mg6010e_handle->bus_index] < MG6010E_PARAMS_WINDOW)
+            {
+                uint8_t motor_id = MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id);
+                uint8_t ret;
+                if (stage == MG6010E_PARAMS_WRITE)
+                {
+                    atomic_fetch_and_explicit(&entry->write_mask, (uint8_t)~(1U << p), memory_order_relaxed); // 须在发送前清除，否则回复可能先于清除到达
+                    ret = mg6010e_write_control_param(motor_id, mg6010e_params_id[p], entry->target[p]);
+                }
+                else
+                {
+                    atomic_fetch_and_explicit(&entry->read_mask, (uint8_t)~(1U << p), memory_order_relaxed);
+                    ret = mg6010e_read_control_param(motor_id, mg6010e_params_id[p]);
+                }
+                if (ret == MG6010E_SUCCESS)
+                {
+                    entry->stage[p] = ++stage;
+                    entry->attempts[p]++;
+                    entry->sent_time[p] = now;
+                    outstanding[mg6010e_handle->bus_index]++;
+                }
+                else if (ret == MG6010E_ERROR_NOT_INITIALIZED)
+                {
+                    entry->stage[p] = stage = MG6010E_PARAMS_FAILED;
+                }
+                else
+                {
+                    outstanding[mg6010e_handle->bus_index] = MG6010E_PARAMS_WINDOW; // 发送队列已满，本次不再向该总线发送
+                }
+            }
+            pending |= stage != MG6010E_PARAMS_IDLE && stage < MG6010E_PARAMS_DONE;
+            failed |= stage == MG6010E_PARAMS_FAILED;
+            mismatched |= stage == MG6010E_PARAMS_MISMATCH;
+        }
+    }
+    if (pending)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    mg6010e_params_elapsed_us = now - mg6010e_params_start_time;
+    mg6010e_params_result = failed ? MG6010E_ERROR_TIMEOUT : (mismatched ? MG6010E_ERROR_VERIFY_FAILED : MG6010E_SUCCESS);
+    return mg6010e_params_result;
+}
+
+/**
+ * @brief 获取控制参数快照或恢复的进度
+ *
+ * @param progress 进度输出
+ * @return uint8_t 错误码，0表示成功，1表示progress为空，4表示尚未开始任何快照或恢复
+ */
+uint8_t mg6010e_params_get_progress(mg6010e_params_progress_t *progress)
+{
+    if (progress == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (mg6010e_params_op == MG6010E_PARAMS_OP_NONE)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    *progress = (mg6010e_params_progress_t){0};
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        const uint8_t *stage = mg6010e_params_table[i].stage;
+        if (stage[0] == MG6010E_PARAMS_IDLE)
+        {
+            continue;
+        }
+        progress->motors++;
+        for (uint32_t p = 0; p < MG6010E_PARAMS_NUM; p++)
+        {
+            progress->done += stage[p] == MG6010E_PARAMS_DONE;
+            progress->failed += stage[p] == MG6010E_PARAMS_FAILED;
+            progress->mismatched += stage[p] == MG6010E_PARAMS_MISMATCH;
+        }
+    }
+    progress->total = (uint16_t)(progress->motors * MG6010E_PARAMS_NUM);
+    progress->elapsed_us = mg6010e_params_result == MG6010E_ERROR_BUSY ? mg6010e_get_timestamp_us() - mg6010e_params_start_time : mg6010e_params_elapsed_us;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 导出最近一次快照
+ *
+ * @param blob 输出缓冲区，大小为MG6010E_PARAMS_BLOB_SIZE(电机数)时可容纳全部电机
+ * @param size 缓冲区大小，单位字节
+ * @param length 写入的字节数
+ * @return uint8_t 错误码，0表示成功，1表示指针为空，4表示最近一次操作不是已结束的快照，8表示快照尚未结束，12表示缓冲区不足
+ * @note 只导出全部参数均已读取的电机，部分参数失败的电机不导出（见mg6010e_params_get_progress）。格式见MG6010E_PARAMS_MAGIC处的说明。
+ */
+uint8_t mg6010e_params_serialize(uint8_t *blob, uint32_t size, uint32_t *length)
+{
+    if (blob == NULL || length == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (size < MG6010E_PARAMS_HEADER_SIZE)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    if (mg6010e_params_op != MG6010E_PARAMS_OP_SNAPSHOT)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (mg6010e_params_result == MG6010E_ERROR_BUSY)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    uint8_t count = 0;
+    uint8_t *record = blob + MG6010E_PARAMS_HEADER_SIZE;
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        const mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+        const mg6010e_params_entry_t *entry = &mg6010e_params_table[i];
+        if (!mg6010e_handle->initialized)
+        {
+            continue;
+        }
+        uint32_t p = 0;
+        while (p < MG6010E_PARAMS_NUM && entry->stage[p] == MG6010E_PARAMS_DONE)
+        {
+            p++;
+        }
+        if (p != MG6010E_PARAMS_NUM)
+        {
+            continue;
+        }
+        if (size < MG6010E_PARAMS_BLOB_SIZE(count + 1U))
+        {
+            return MG6010E_ERROR_INVALID_PARAM;
+        }
+        record[0] = MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id);
+        memcpy(record + 1, entry->value, sizeof(entry->value));
+        record += MG6010E_PARAMS_RECORD_SIZE;
+        count++;
+    }
+    *length = MG6010E_PARAMS_BLOB_SIZE(count);
+    mg6010e_put_le(blob, (uint32_t)MG6010E_PARAMS_MAGIC);
+    blob[4] = MG6010E_PARAMS_VERSION;
+    blob[5] = count;
+    mg6010e_put_le(blob + 6, mg6010e_params_crc16(blob + MG6010E_PARAMS_HEADER_SIZE, *length - MG6010E_PARAMS_HEADER_SIZE));
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_PARAMS_SNAPSHOT */
+
+#if MG6010E_USE_ENCODER_UNWRAP
+#define MG6010E_ENCODER_COUNTS (1L << MG6010E_ENCODER_BITS) // 编码器一圈的计数
+
+/**
+ * @brief 按采样间隔预测编码器计数增量
+ *
+ * @param unwrap 编码器累计状态
+ * @param elapsed 距上一次采样的时间，单位us
+ * @return int64_t 预测的计数增量，尚无速度估计时为0
+ */
+static inline int64_t mg6010e_unwrap_predict(const mg6010e_unwrap_t *unwrap, uint32_t elapsed)
+{
+    if (unwrap->interval_avg <= 0)
+    {
+        return 0;
+    }
+    return (int64_t)unwrap->delta_avg * elapsed / unwrap->interval_avg;
+}
+
+/**
+ * @brief 将累计计数对齐到多圈角度，并记录对齐前的偏差
+ *
+ * @param unwrap 编码器累计状态
+ * @param counts 与angle同一时刻的累计计数
+ * @param angle 多圈角度，单位0.01°
+ */
+static inline void mg6010e_unwrap_anchor(mg6010e_unwrap_t *unwrap, int64_t counts, int64_t angle)
+{
+    if (unwrap->anchored)
+    {
+        int64_t predicted = unwrap->anchor_angle + (counts - unwrap->anchor_counts) * MG6010E_ENCODER_TURN_ANGLE / MG6010E_ENCODER_COUNTS;
+        int64_t correction = angle - predicted;
+        unwrap->last_correction = (int32_t)correction;
+        uint32_t magnitude = (uint32_t)(correction < 0 ? -correction : correction);
+        if (magnitude > unwrap->max_correction)
+        {
+            unwrap->max_correction = magnitude;
+        }
+    }
+    unwrap->anchor_angle = angle;
+    unwrap->anchor_counts = counts;
+    unwrap->anchored = 1;
+    unwrap->anchors++;
+}
+
+/**
+ * @brief 在接收中断中累计编码器值，并在收到多圈角度时校准
+ *
+ * @param mg6010e_handle 电机句柄，反馈已写入
+ * @param command 反馈的命令字节
+ * @param timestamp 接收时间戳，单位us
+ * @note 两次采样间的编码器增量按最短路径取值，仅当速度足以转过四分之一圈时，
+ * 才用反馈中的速度（0x90回复没有速度时用速度估计）判断实际转过的圈数。
+ * 多圈角度到达时若距上一次采样已超过两个平均采样间隔，累计计数已过时，留到下一次采样时按速度估计推算到采样时刻再校准。
+ */
+static inline void mg6010e_unwrap_feedback(mg6010e_handle_t *mg6010e_handle, uint8_t command, uint32_t timestamp)
+{
+    uint16_t encoder;
+    int32_t speed = 0;
+    uint8_t has_speed = 0;
+    switch (command)
+    {
+    case 0x9C:
+    case 0xA1:
+    case 0xA2:
+    case 0xA3:
+    case 0xA4:
+    case 0xA5:
+    case 0xA6:
+    case 0xA7:
+    case 0xA8:
+        encoder = mg6010e_handle->status.encoder;
+        speed = mg6010e_handle->status.speed;
+        has_speed = 1;
+        break;
+    case 0x90:
+        encoder = mg6010e_handle->encoder_data.encoder;
+        break;
+    case 0x92:
+    case 0x95:
+    case 0x19:
+        encoder = 0; // 不含编码器值
+        break;
+    default:
+        return;
+    }
+    mg6010e_unwrap_t *unwrap = &mg6010e_unwrap_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t seq = atomic_load_explicit(&unwrap->sequence, memory_order_relaxed);
+    atomic_store_explicit(&unwrap->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    if (command == 0x19)
+    {
+        unwrap->resync = 1; // 编码器零点改变，累计值保持连续
+    }
+    else if (command == 0x92 || command == 0x95)
+    {
+        uint32_t elapsed = timestamp - unwrap->last_time;
+        if (unwrap->primed && (int64_t)elapsed * 256 <= (int64_t)unwrap->interval_avg * 2)
+        {
+            mg6010e_unwrap_anchor(unwrap, unwrap->counts + mg6010e_unwrap_predict(unwrap, elapsed), mg6010e_handle->status.angle); // 推算到角度回复时刻的计数
+            unwrap->anchor_pending = 0;
+        }
+        else
+        {
+            unwrap->anchor_pending = 1;
+            unwrap->pending_angle = mg6010e_handle->status.angle;
+            unwrap->pending_time = timestamp;
+        }
+    }
+    else
+    {
+        encoder &= (uint16_t)(MG6010E_ENCODER_COUNTS - 1);
+        if (!unwrap->primed)
+        {
+            unwrap->counts = encoder;
+            unwrap->primed = 1;
+        }
+        else if (unwrap->resync)
+        {
+            unwrap->resync = 0;
+        }
+        else
+        {
+            uint32_t elapsed = timestamp - unwrap->last_time;
+            int64_t delta = (int64_t)((encoder - unwrap->last_encoder + MG6010E_ENCODER_COUNTS / 2) & (MG6010E_ENCODER_COUNTS - 1)) - MG6010E_ENCODER_COUNTS / 2;
+            int64_t travel = has_speed ? (int64_t)speed * elapsed * 4 : mg6010e_unwrap_predict(unwrap, elapsed) * 4;
+            int64_t quarter = has_speed ? (int64_t)MG6010E_ENCODER_TURN_ANGLE * 10000 : MG6010E_ENCODER_COUNTS;
+            if (travel >= quarter || travel <= -quarter)
+            {
+                // 采样间隔内可能转过半圈以上，按预测增量补上整圈
+                int64_t predicted = has_speed ? (int64_t)speed * elapsed * MG6010E_ENCODER_COUNTS / ((int64_t)MG6010E_ENCODER_TURN_ANGLE * 10000) : travel / 4;
+                int64_t error = predicted - delta;
+                int64_t turns = (error + (error < 0 ? -MG6010E_ENCODER_COUNTS / 2 : MG6010E_ENCODER_COUNTS / 2)) / MG6010E_ENCODER_COUNTS;
+                delta += turns * MG6010E_ENCODER_COUNTS;
+            }
+            unwrap->counts += delta;
+            if (elapsed != 0)
+            {
+                if (unwrap->interval_avg <= 0)
+                {
+                    unwrap->delta_avg = (int32_t)(delta * 256);
+                    unwrap->interval_avg = (int32_t)(elapsed * 256);
+                }
+                else
+                {
+                    unwrap->delta_avg += (int32_t)((delta * 256 - unwrap->delta_avg) >> MG6010E_UNWRAP_VELOCITY_SHIFT);
+                    unwrap->interval_avg += (int32_t)(((int64_t)elapsed * 256 - unwrap->interval_avg) >> MG6010E_UNWRAP_VELOCITY_SHIFT);
+                }
+            }
+        }
+        unwrap->last_encoder = encoder;
+        unwrap->last_time = timestamp;
+        unwrap->samples++;
+        if (unwrap->anchor_pending)
+        {
+            int64_t travel = mg6010e_unwrap_predict(unwrap, timestamp - unwrap->pending_time) * MG6010E_ENCODER_TURN_ANGLE / MG6010E_ENCODER_COUNTS;
+            mg6010e_unwrap_anchor(unwrap, unwrap->counts, unwrap->pending_angle + travel); // 推算到本次采样时刻的多圈角度
+            unwrap->anchor_pending = 0;
+        }
+    }
+    atomic_store_explicit(&unwrap->sequence, seq + 2, memory_order_release);
+}
+
+/**
+ * @brief 获取由编码器累计的领控6010E电机多圈位置与速度
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param position 位置输出
+ * @return uint8_t 错误码，0表示成功，1表示position为空，4表示未初始化，8表示重试MG6010E_UNWRAP_RETRY次后仍与接收中断冲突，此时position未写入
+ * @note 编码器值来自0x9C与0xA1~0xA8的回复及0x90，无需轮询0x92；以低频率轮询MG6010E_POLL_ANGLE（或读取0x92）即可校准绝对位置，
+ * 并由last_correction观察两次校准间的累计误差。速度为计数增量与采样间隔的滑动平均之比。samples为0时尚无编码器反馈，位置无效。
+ */
+uint8_t mg6010e_get_position(uint8_t motor_id, mg6010e_position_t *position)
+{
+    if (position == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    const mg6010e_unwrap_t *unwrap = &mg6010e_unwrap_table[mg6010e_handle - mg6010e_handle_pool];
+    for (uint32_t retry = 0; retry < MG6010E_UNWRAP_RETRY; retry++)
+    {
+        uint32_t seq = atomic_load_explicit(&unwrap->sequence, memory_order_acquire);
+        if (seq & 1)
+        {
+            continue; // 接收中断正在写入
+        }
+        mg6010e_unwrap_t copy;
+        memcpy(&copy, unwrap, sizeof(mg6010e_unwrap_t));
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&unwrap->sequence, memory_order_relaxed) != seq)
+        {
+            continue;
+        }
+        position->position = copy.anchor_angle + (copy.counts - copy.anchor_counts) * MG6010E_ENCODER_TURN_ANGLE / MG6010E_ENCODER_COUNTS;
+        position->velocity = copy.interval_avg > 0 ? (int32_t)((int64_t)copy.delta_avg * 1000000 * MG6010E_ENCODER_TURN_ANGLE / ((int64_t)copy.interval_avg * MG6010E_ENCODER_COUNTS)) : 0;
+        position->timestamp = copy.last_time;
+        position->anchored = copy.anchored;
+        position->samples = copy.samples;
+        position->anchors = copy.anchors;
+        position->last_correction = copy.last_correction;
+        position->max_correction = copy.max_correction;
+        return MG6010E_SUCCESS;
+    }
+    return MG6010E_ERROR_BUSY;
+}
+#endif /* MG6010E_USE_ENCODER_UNWRAP */
+
+#if MG6010E_USE_RECORDER
+_Static_assert((MG6010E_RECORDER_SIZE & (MG6010E_RECORDER_SIZE - 1)) == 0 && MG6010E_RECORDER_SIZE >= 64, "MG6010E_RECORDER_SIZE must be a power of 2 and at least 64");
+
+static _Atomic uint8_t mg6010e_recorder_enabled; // 是否正在记录
+static _Atomic uint8_t mg6010e_recorder_header;  // 下一次导出前需写入文件头
+static uint32_t mg6010e_recorder_next_bus;       // 下一次导出优先读取的总线，避免缓冲区较小时只读到第一条总线
+
+/**
+ * @brief 在接收路径中将一帧反馈追加到所在总线的记录缓冲区
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
+ * @note 每帧最多比较7个字节、写入MG6010E_RECORDER_SYNC_SIZE + MG6010E_RECORDER_RECORD_MAX个字节，不加锁；
+ * 缓冲区不足时丢弃本帧，并在下一条记录前写入同步记录，使解析端重新对齐参考值。
+ */
+static void mg6010e_recorder_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp)
+{
+    if (!atomic_load_explicit(&mg6010e_recorder_enabled, memory_order_relaxed))
+    {
+        return;
+    }
+    mg6010e_bus_t *bus = &mg6010e_bus_table[mg6010e_handle->bus_index];
+    uint32_t head = atomic_load_explicit(&bus->record_head, memory_order_relaxed);
+    uint32_t used = head - atomic_load_explicit(&bus->record_tail, memory_order_acquire);
+    uint8_t sync = atomic_load_explicit(&bus->record_sync, memory_order_relaxed);
+    if (used + (sync ? MG6010E_RECORDER_SYNC_SIZE : 0) + MG6010E_RECORDER_RECORD_MAX > MG6010E_RECORDER_SIZE)
+    {
+        bus->record_stats.dropped++;
+        atomic_store_explicit(&bus->record_sync, 1, memory_order_relaxed); // 丢弃后参考值与解析端不再一致
+        return;
+    }
+    uint8_t record[MG6010E_RECORDER_SYNC_SIZE + MG6010E_RECORDER_RECORD_MAX];
+    uint32_t length = 0;
+    if (sync)
+    {
+        atomic_store_explicit(&bus->record_sync, 0, memory_order_relaxed);
+        memset(bus->record_ref, 0, sizeof(bus->record_ref));
+        record[0] = MG6010E_RECORDER_SYNC;
+        record[1] = mg6010e_handle->bus_index;
+        mg6010e_put_le(record + 2, timestamp);
+        mg6010e_put_le(record + 6, bus->record_stats.dropped);
+        length = MG6010E_RECORDER_SYNC_SIZE;
+        bus->record_time = timestamp;
+    }
+    uint32_t mask_pos = length;
+    record[length + 1] = MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id);
+    record[length + 2] = rx_data[0];
+    length += 3;
+    uint32_t delta = timestamp - bus->record_time;
+    while (delta >= 0x80)
+    {
+        record[length++] = (uint8_t)(delta | 0x80);
+        delta >>= 7;
+    }
+    record[length++] = (uint8_t)delta;
+    uint8_t *ref = bus->record_ref[mg6010e_handle->config.motor_id - 1][MG6010E_RECORDER_CLASS(rx_data[0])];
+    uint8_t mask = 0;
+    for (uint32_t i = 0; i < 7; i++)
+    {
+        if (rx_data[i + 1] != ref[i])
+        {
+            mask |= (uint8_t)(1U << i);
+            ref[i] = rx_data[i + 1];
+            record[length++] = rx_data[i + 1];
+        }
+    }
+    record[mask_pos] = mask;
+    bus->record_time = timestamp;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        bus->record_ring[(head + i) & (MG6010E_RECORDER_SIZE - 1)] = record[i];
+    }
+    atomic_store_explicit(&bus->record_head, head + length, memory_order_release);
+    bus->record_stats.records++;
+    bus->record_stats.bytes += length;
+    if (used + length > bus->record_stats.high_water)
+    {
+        bus->record_stats.high_water = used + length;
+    }
+}
+
+/**
+ * @brief 取得缓冲区中一条完整记录的长度
+ */
+static uint32_t mg6010e_recorder_length(const mg6010e_bus_t *bus, uint32_t pos)
+{
+    uint8_t mask = bus->record_ring[pos & (MG6010E_RECORDER_SIZE - 1)];
+    if (mask == MG6010E_RECORDER_SYNC)
+    {
+        return MG6010E_RECORDER_SYNC_SIZE;
+    }
+    uint32_t length = 3;
+    while (bus->record_ring[(pos + length) & (MG6010E_RECORDER_SIZE - 1)] & 0x80)
+    {
+        length++;
+    }
+    length++;
+    for (; mask != 0; mask >>= 1)
+    {
+        length += mask & 1U;
+    }
+    return length;
+}
+
+/**
+ * @brief 开始记录
+ *
+ * @note 丢弃尚未导出的记录并清零记录统计，下一次mg6010e_recorder_read先输出文件头，各总线的第一条记录前写入同步记录。
+ * 与mg6010e_recorder_read在同一任务中调用。
+ */
+void mg6010e_recorder_start(void)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS; i++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[i];
+        atomic_store_explicit(&bus->record_tail, atomic_load_explicit(&bus->record_head, memory_order_acquire), memory_order_release);
+        bus->record_stats = (mg6010e_recorder_stats_t){0};
+        atomic_store_explicit(&bus->record_sync, 1, memory_order_relaxed); // 在丢弃之后置位，之前写入的记录不会越过同步记录
+    }
+    atomic_store_explicit(&mg6010e_recorder_header, 1, memory_order_relaxed);
+    atomic_store_explicit(&mg6010e_recorder_enabled, 1, memory_order_release);
+}
+
+/**
+ * @brief 停止记录，已记录的数据仍可由mg6010e_recorder_read导出
+ */
+void mg6010e_recorder_stop(void)
+{
+    atomic_store_explicit(&mg6010e_recorder_enabled, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief 导出遥测记录
+ *
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小，单位字节，不小于MG6010E_RECORDER_SIZE时可一次取出一条总线的全部记录
+ * @return uint32_t 写入的字节数，只包含完整的记录，没有新记录时返回0
+ * @note 在后台任务中周期调用，将输出依次追加到文件、SD卡或串口，格式见MG6010E_RECORDER_MAGIC处的说明，
+ * 可用tools/mg6010e_record_decode.c解析为CSV。各总线的记录分段输出，段内按时间顺序排列。
+ */
+uint32_t mg6010e_recorder_read(uint8_t *buffer, uint32_t size)
+{
+    if (buffer == NULL)
+    {
+        return 0;
+    }
+    uint32_t length = 0;
+    if (atomic_load_explicit(&mg6010e_recorder_header, memory_order_relaxed))
+    {
+        if (size < MG6010E_RECORDER_HEADER_SIZE)
+        {
+            return 0;
+        }
+        mg6010e_put_le(buffer, (uint32_t)MG6010E_RECORDER_MAGIC);
+        mg6010e_put_le(buffer + 4, (uint16_t)MG6010E_RECORDER_VERSION);
+        mg6010e_put_le(buffer + 6, (uint16_t)0);
+        length = MG6010E_RECORDER_HEADER_SIZE;
+        atomic_store_explicit(&mg6010e_recorder_header, 0, memory_order_relaxed);
+    }
+    for (uint32_t n = 0; n < MG6010E_MAX_CAN_BUS; n++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[(mg6010e_recorder_next_bus + n) % MG6010E_MAX_CAN_BUS];
+        uint32_t tail = atomic_load_explicit(&bus->record_tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&bus->record_head, memory_order_acquire);
+        uint8_t full = 0;
+        while (tail != head)
+        {
+            uint32_t record = mg6010e_recorder_length(bus, tail);
+            if (length + record > size)
+            {
+                full = 1;
+                break;
+            }
+            for (uint32_t i = 0; i < record; i++)
+            {
+                buffer[length++] = bus->record_ring[(tail + i) & (MG6010E_RECORDER_SIZE - 1)];
+            }
+            tail += record;
+        }
+        atomic_store_explicit(&bus->record_tail, tail, memory_order_release);
+        if (full)
+        {
+            mg6010e_recorder_next_bus = (mg6010e_recorder_next_bus + n) % MG6010E_MAX_CAN_BUS; // 下次从未读完的总线开始
+            return length;
+        }
+    }
+    mg6010e_recorder_next_bus = (mg6010e_recorder_next_bus + 1) % MG6010E_MAX_CAN_BUS;
+    return length;
+}
+
+/**
+ * @brief 获取总线的遥测记录统计
+ *
+ * @param can_handle CAN句柄
+ * @param stats 记录统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，2表示总线未注册
+ * @note 计数由接收路径写入，读取时不加锁，各字段可能来自略有不同的时刻
+ */
+uint8_t mg6010e_get_recorder_stats(mg6010e_can_t *can_handle, mg6010e_recorder_stats_t *stats)
+{
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *stats = bus->record_stats;
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_RECORDER */
+
+#if MG6010E_USE_GROUP
+/**
+ * @brief 结束最近一次提交的命令组，将其偏差计入统计
+ *
+ * @note 在最后一帧回复的接收路径或下一次提交中调用，只计入一次
+ */
+static void mg6010e_group_close(void)
+{
+    if (atomic_exchange_explicit(&mg6010e_group_closed, 1, memory_order_acq_rel))
+    {
+        return;
+    }
+    uint32_t replies = atomic_load_explicit(&mg6010e_group_replies, memory_order_relaxed);
+    uint32_t first = atomic_load_explicit(&mg6010e_group_first, memory_order_relaxed);
+    uint32_t last = atomic_load_explicit(&mg6010e_group_last, memory_order_relaxed);
+    mg6010e_group_stats.motors = mg6010e_group_motors;
+    mg6010e_group_stats.replies = (uint8_t)replies;
+    mg6010e_group_stats.skew_us = replies != 0 ? last - first : 0;
+    mg6010e_group_stats.latency_us = replies != 0 ? last : 0;
+    if (replies < mg6010e_group_motors)
+    {
+        mg6010e_group_stats.incomplete++;
+        return;
+    }
+    mg6010e_group_complete++;
+    mg6010e_group_skew_total += mg6010e_group_stats.skew_us;
+    if (mg6010e_group_stats.skew_us > mg6010e_group_stats.max_skew_us)
+    {
+        mg6010e_group_stats.max_skew_us = mg6010e_group_stats.skew_us;
+    }
+}
+
+/**
+ * @brief 在接收路径中记录命令组内控制命令的回复时间
+ */
+static inline void mg6010e_group_feedback(mg6010e_handle_t *mg6010e_handle, uint8_t command, uint32_t timestamp)
+{
+    if (command < 0xA1 || command > 0xA8)
+    {
+        return;
+    }
+    mg6010e_group_entry_t *entry = &mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t cycle = atomic_load_explicit(&entry->await_cycle, memory_order_relaxed);
+    if (cycle == 0 || !atomic_compare_exchange_strong_explicit(&entry->await_cycle, &cycle, 0, memory_order_relaxed, memory_order_relaxed) ||
+        cycle != atomic_load_explicit(&mg6010e_group_cycle, memory_order_acquire))
+    {
+        return; // 不在命令组中，或是已结束的命令组的迟到回复
+    }
+    uint32_t offset = timestamp - mg6010e_group_commit_time;
+    uint32_t first = atomic_load_explicit(&mg6010e_group_first, memory_order_relaxed);
+    while (offset < first && !atomic_compare_exchange_weak_explicit(&mg6010e_group_first, &first, offset, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+    uint32_t last = atomic_load_explicit(&mg6010e_group_last, memory_order_relaxed);
+    while (offset > last && !atomic_compare_exchange_weak_explicit(&mg6010e_group_last, &last, offset, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+    if (atomic_fetch_add_explicit(&mg6010e_group_replies, 1, memory_order_acq_rel) + 1 == mg6010e_group_motors)
+    {
+        mg6010e_group_close();
+    }
+}
+
+/**
+ * @brief 打开命令组
+ *
+ * @return uint8_t 错误码，0表示成功，8表示命令组已打开
+ * @note 打开后，0xA1~0xA6控制命令接口（如mg6010e_angle_control、mg6010e_speed_control）不再立即发送，
+ * 而是暂存到各电机在组中的位置，同一电机后写覆盖先写，由mg6010e_group_commit一并发出。
+ * 命令组对所有上下文生效，请只在控制任务中打开并提交，不要在中断中调用控制命令接口。
+ */
+uint8_t mg6010e_group_begin(void)
+{
+    if (mg6010e_group_open)
+    {
+        return MG6010E_ERROR_BUSY;
+    }
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_group_table[i].staged = 0;
+    }
+    mg6010e_group_open = 1;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 提交命令组：将暂存的控制命令按ID顺序连续放入发送队列并发出
+ *
+ * @return uint8_t 错误码，0表示成功，4表示命令组未打开，5表示部分命令未能入队（部分提交），6表示某条总线的发送队列容纳不下本组命令
+ * @note 每条总线上的命令按电机ID从小到大排列（标准帧ID越小仲裁优先级越高），全部占用队列槽位后才一并发布，
+ * 发布前发送上下文不会取走其中任何一帧，因此本组命令在总线上连续发出，不会被其他命令插入。
+ * 提交前先检查每一条总线：空闲槽位加上可丢弃的旧帧（见mg6010e_tx_evict）足以容纳本组在该总线上的命令。任一总线不足时返回6，
+ * 不丢弃、不发送任何帧并保持命令组打开，可稍后重试提交或调用mg6010e_group_abort。检查通过后才在占用槽位时丢弃旧帧。
+ * 检查之后若其他上下文抢先占满了队列，已入队的命令照常发出，未能入队的电机不计入本组的电机数，命令组关闭并返回5。
+ * 未发出的电机（含检查后进入故障锁存状态的电机）记录在mg6010e_group_stats_t.unsent中，每次提交时更新。
+ * 本组的偏差（第一帧到最后一帧回复的时间）在收齐回复或下一次提交时计入mg6010e_group_get_stats。
+ */
+uint8_t mg6010e_group_commit(void)
+{
+    if (!mg6010e_group_open)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    uint32_t needed[MG6010E_MAX_CAN_BUS] = {0};
+    uint32_t unsent[MG6010E_MAX_CAN_BUS] = {0};
+    uint32_t motors = 0;
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_handle_t *mg6010e_handle = &mg6010e_handle_pool[i];
+        if (mg6010e_group_table[i].staged && mg6010e_handle->initialized)
+        {
+#if MG6010E_USE_HEALTH
+            if (mg6010e_health_blocked(mg6010e_handle))
+            {
+                unsent[mg6010e_handle->bus_index] |= 1UL << (mg6010e_handle->config.motor_id - 1);
+                continue;
+            }
+#endif
+            needed[mg6010e_handle->bus_index]++;
+            motors++;
+        }
+    }
+    // 先检查所有总线再占用槽位，某条总线不足时其他总线上的旧帧也不丢弃
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        uint32_t used = atomic_load_explicit(&bus->tx_enqueue_pos, memory_order_relaxed) - atomic_load_explicit(&bus->tx_dequeue_pos, memory_order_relaxed);
+        if (needed[b] != 0 && MG6010E_TX_QUEUE_DEPTH - used < needed[b] && MG6010E_TX_QUEUE_DEPTH - used + mg6010e_tx_evictable(bus) < needed[b])
+        {
+            return MG6010E_ERROR_QUEUE_FULL;
+        }
+    }
+
+    mg6010e_group_close(); // 上一组未收齐的回复不再等待
+    uint32_t cycle = atomic_load_explicit(&mg6010e_group_cycle, memory_order_relaxed) + 1;
+    cycle = cycle != 0 ? cycle : 1;
+    mg6010e_group_motors = (uint8_t)motors;
+    mg6010e_group_commit_time = mg6010e_get_timestamp_us();
+    atomic_store_explicit(&mg6010e_group_replies, 0, memory_order_relaxed);
+    atomic_store_explicit(&mg6010e_group_first, UINT32_MAX, memory_order_relaxed);
+    atomic_store_explicit(&mg6010e_group_last, 0, memory_order_relaxed);
+    atomic_store_explicit(&mg6010e_group_closed, motors == 0, memory_order_relaxed); // 空命令组不计入统计
+    atomic_store_explicit(&mg6010e_group_cycle, cycle, memory_order_release);
+    mg6010e_group_stats.cycles++;
+
+    uint32_t skipped = 0;  // 未能发出的命令数
+    uint32_t unqueued = 0; // 其中因发送队列被其他上下文占满而未能入队的命令数
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        for (uint32_t index = 0; index < 32 && needed[b] != 0; index++)
+        {
+            mg6010e_handle_t *mg6010e_handle = bus->handle_table[index];
+            if (mg6010e_handle == NULL)
+            {
+                continue;
+            }
+            mg6010e_group_entry_t *entry = &mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool];
+            if (!entry->staged)
+            {
+                continue;
+            }
+            entry->staged = 0;
+#if MG6010E_USE_HEALTH
+            if (mg6010e_health_blocked(mg6010e_handle))
+            {
+                unsent[b] |= 1UL << index; // 检查后进入故障锁存状态
+                skipped++;
+                continue;
+            }
+#endif
+            entry->claimed = mg6010e_tx_claim(bus);
+            if (entry->claimed == NULL)
+            {
+                unsent[b] |= 1UL << index; // 其他上下文同时入队非丢弃命令，本帧无法发出
+                skipped++;
+                unqueued++;
+                continue;
+            }
+#if MG6010E_USE_COALESCE
+            mg6010e_coalesce_cancel(mg6010e_handle); // 尚未发出的旧控制命令不应在本组之后发出
+#endif
+            entry->claimed->frame = entry->slot.frame;
+            atomic_store_explicit(&entry->await_cycle, cycle, memory_order_relaxed);
+            mg6010e_cmd_prepare(mg6010e_handle, entry->claimed);
+        }
+    }
+    if (skipped != 0)
+    {
+        // 未发出的电机不等待其回复，须在发布前修改，此前不会有本组的回复
+        motors -= skipped;
+        mg6010e_group_motors = (uint8_t)motors;
+        atomic_store_explicit(&mg6010e_group_closed, motors == 0, memory_order_relaxed);
+    }
+    memcpy(mg6010e_group_stats.unsent, unsent, sizeof(unsent));
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        for (uint32_t index = 0; index < 32 && needed[b] != 0; index++)
+        {
+            mg6010e_handle_t *mg6010e_handle = bus->handle_table[index];
+            if (mg6010e_handle != NULL && mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool].claimed != NULL)
+            {
+                mg6010e_tx_publish(mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool].claimed);
+                mg6010e_group_table[mg6010e_handle - mg6010e_handle_pool].claimed = NULL;
+            }
+        }
+    }
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        if (needed[b] != 0)
+        {
+            mg6010e_tx_drain(&mg6010e_bus_table[b]);
+        }
+    }
+    mg6010e_group_open = 0;
+    return unqueued != 0 ? MG6010E_ERROR_SEND_FAILED : MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 放弃命令组中暂存的命令并关闭命令组
+ */
+void mg6010e_group_abort(void)
+{
+    for (uint32_t i = 0; i < MG6010E_MAX_MOTOR_NUM; i++)
+    {
+        mg6010e_group_table[i].staged = 0;
+    }
+    mg6010e_group_open = 0;
+}
+
+/**
+ * @brief 获取命令组统计
+ *
+ * @param stats 统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空
+ * @note 偏差与延迟来自回复的时间戳，精度取决于mg6010e_get_timestamp_us。读取时不加锁，各字段可能来自略有不同的时刻
+ */
+uint8_t mg6010e_group_get_stats(mg6010e_group_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *stats = mg6010e_group_stats;
+    stats->avg_skew_us = mg6010e_group_complete != 0 ? (uint32_t)(mg6010e_group_skew_total / mg6010e_group_complete) : 0;
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_GROUP */
+
+#if MG6010E_USE_HEALTH
+/**
+ * @brief 发出故障动作的命令
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param reaction 故障动作，MG6010E_HEALTH_REACT_NONE等
+ * @return uint8_t 错误码，0表示成功或无动作，6表示发送队列已满且没有可丢弃的帧
+ * @note 发送队列已满时先丢弃最早的可丢弃帧。尚未发出的合并控制命令被撤销，此后的控制命令由mg6010e_health_blocked拒绝，
+ * 因此停止命令之后不会再发出该电机的控制命令。
+ */
+static uint8_t mg6010e_health_react(mg6010e_handle_t *mg6010e_handle, uint8_t reaction)
+{
+    static const uint8_t commands[][2][2] = {
+        [MG6010E_HEALTH_REACT_STOP] = {{0x81, 0x00}},
+        [MG6010E_HEALTH_REACT_DISABLE] = {{0x80, 0x00}},
+        [MG6010E_HEALTH_REACT_BRAKE] = {{0x81, 0x00}, {0x8C, 0x00}}, // 先停止再使抱闸器断电刹车
+    };
+    if (reaction == MG6010E_HEALTH_REACT_NONE || reaction > MG6010E_HEALTH_REACT_BRAKE)
+    {
+        return MG6010E_SUCCESS;
+    }
+#if MG6010E_USE_COALESCE
+    mg6010e_coalesce_cancel(mg6010e_handle);
+#endif
+    mg6010e_bus_t *bus = &mg6010e_bus_table[mg6010e_handle->bus_index];
+    for (uint32_t i = 0; i < 2 && commands[reaction][i][0] != 0; i++)
+    {
+        mg6010e_tx_slot_t *slot = mg6010e_tx_claim(bus);
+        if (slot == NULL)
+        {
+            return MG6010E_ERROR_QUEUE_FULL;
+        }
+        slot->frame.std_id = MG6010E_CAN_CMD_ID(mg6010e_handle->config.motor_id);
+        slot->frame.cmd_class = MG6010E_CMD_CLASS_CONFIG;
+        mg6010e_encode_cmd(slot->frame.data, commands[reaction][i][0], commands[reaction][i][1]);
+        mg6010e_cmd_commit(mg6010e_handle, slot);
+    }
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 锁存电机故障，由无故障变为有故障时执行故障动作
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param fault 新检测到的故障，MG6010E_HEALTH_STALE等
+ * @param timestamp 检测到故障的时间戳，单位us
+ * @note 同一电机的故障可能同时由接收路径与mg6010e_health_tick检测到，故障位以原子操作锁存，故障动作只执行一次
+ */
+static void mg6010e_health_trip(mg6010e_handle_t *mg6010e_handle, uint8_t fault, uint32_t timestamp)
+{
+    mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    uint8_t previous = atomic_fetch_or_explicit(&entry->faults, fault, memory_order_acq_rel);
+    if ((previous & fault) == fault)
+    {
+        return; // 已锁存
+    }
+    if (previous == 0)
+    {
+        entry->fault_time = timestamp;
+        entry->trips++;
+        entry->reaction_result = mg6010e_health_react(mg6010e_handle, entry->config.reaction);
+    }
+    if (mg6010e_health_callback != NULL)
+    {
+        mg6010e_health_callback(MG6010E_MOTOR(mg6010e_handle->bus_index, mg6010e_handle->config.motor_id), previous | fault);
+    }
+}
+
+/**
+ * @brief 在接收路径中记录回复时间，并检查反馈中的温度、电压与错误标志
+ *
+ * @param mg6010e_handle 电机句柄
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
+ */
+static inline void mg6010e_health_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp)
+{
+    mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    if (!entry->enabled)
+    {
+        return;
+    }
+    uint32_t interval = timestamp - atomic_load_explicit(&entry->last_reply, memory_order_relaxed);
+    if ((int32_t)interval >= 0) // 延迟解析时队列中的帧可能早于开始监测的时刻
+    {
+        entry->max_interval = interval > entry->max_interval ? interval : entry->max_interval;
+        atomic_store_explicit(&entry->last_reply, timestamp, memory_order_relaxed);
+    }
+    mg6010e_bus_t *bus = &mg6010e_bus_table[mg6010e_handle->bus_index];
+    uint32_t slice = atomic_load_explicit(&bus->health_slice, memory_order_acquire);
+    atomic_fetch_or_explicit(&bus->health_seen[slice & (MG6010E_HEALTH_SLICE_NUM - 1)], 1UL << (mg6010e_handle->config.motor_id - 1), memory_order_release);
+
+    uint8_t command = rx_data[0];
+    uint8_t fault = 0;
+    if (command == 0x9A || command == 0x9B)
+    {
+        if (entry->config.min_voltage != 0 && (int16_t)(rx_data[2] | (rx_data[3] << 8)) < entry->config.min_voltage)
+        {
+            fault |= MG6010E_HEALTH_UNDERVOLTAGE;
+        }
+        if (rx_data[7] & entry->config.error_mask)
+        {
+            fault |= MG6010E_HEALTH_ERROR_STATE;
+        }
+    }
+    if ((command >= 0x9A && command <= 0x9D) || (command >= 0xA1 && command <= 0xA8))
+    {
+        if (entry->config.max_temperature != 0 && (int8_t)rx_data[1] > entry->config.max_temperature)
+        {
+            fault |= MG6010E_HEALTH_OVERTEMP;
+        }
+    }
+    if (fault != 0)
+    {
+        mg6010e_health_trip(mg6010e_handle, fault, timestamp);
+    }
+}
+
+/**
+ * @brief 设置电机的健康监测
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param config 监测配置，为NULL时停止监测该电机
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，12表示故障动作无效
+ * @note 回复超时从调用时开始计时，已锁存的故障保持不变。温度、电压与错误标志在收到携带该字段的回复时检查，
+ * 需要检测时请以自动轮询或定期调用mg6010e_read_status_1读取状态1。请在任务中调用，不要与mg6010e_health_tick并发。
+ */
+uint8_t mg6010e_set_health_config(uint8_t motor_id, const mg6010e_health_config_t *config)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    if (config != NULL && config->reaction > MG6010E_HEALTH_REACT_BRAKE)
+    {
+        return MG6010E_ERROR_INVALID_PARAM;
+    }
+    mg6010e_bus_t *bus = &mg6010e_bus_table[mg6010e_handle->bus_index];
+    mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t bit = 1UL << (MG6010E_MOTOR_CAN_ID(motor_id) - 1);
+    uint32_t now = mg6010e_get_timestamp_us();
+    atomic_fetch_and_explicit(&bus->health_monitored, ~bit, memory_order_relaxed);
+    entry->enabled = 0;
+    if (config != NULL)
+    {
+        entry->config = *config;
+        entry->max_interval = 0;
+        atomic_store_explicit(&entry->last_reply, now, memory_order_relaxed);
+        entry->enabled = 1;
+        if (config->timeout_us != 0)
+        {
+            if (atomic_load_explicit(&bus->health_monitored, memory_order_relaxed) == 0)
+            {
+                bus->health_slice_start = now; // 该总线开始检测回复超时，时间片从当前时刻开始
+                for (uint32_t i = 0; i < MG6010E_HEALTH_SLICE_NUM; i++)
+                {
+                    atomic_store_explicit(&bus->health_seen[i], 0, memory_order_relaxed);
+                }
+            }
+            atomic_fetch_or_explicit(&bus->health_monitored, bit, memory_order_release);
+        }
+    }
+    mg6010e_health_update_window(bus);
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 设置健康监测故障回调
+ *
+ * @param callback 回调函数，为NULL时不回调
+ * @note 每次锁存新的故障位时调用，可能在接收中断中调用，回调中不应阻塞
+ */
+void mg6010e_set_health_callback(mg6010e_health_callback_t callback)
+{
+    mg6010e_health_callback = callback;
+}
+
+/**
+ * @brief 检查回复超时
+ *
+ * @note 请在任务或主循环中周期性调用，周期不应大于MG6010E_HEALTH_SLICE_US。回复超时在超过超时时间后的第一次调用中检测到，
+ * 检测延迟不超过调用周期（延迟解析模式下另加帧在待解析队列中的时间）。温度、电压与错误标志在接收路径中检查，不依赖本函数。
+ * 接收路径在当前时间片的位图中标记有回复的电机，本函数只将最近若干时间片的位图按位或，不在其中的电机才按回复时间逐个判断，
+ * 因此所有电机正常回复时不遍历电机。可与接收路径并发，不可重入。
+ */
+void mg6010e_health_tick(void)
+{
+    uint32_t now = mg6010e_get_timestamp_us();
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        uint32_t monitored = atomic_load_explicit(&bus->health_monitored, memory_order_acquire);
+        if (monitored == 0)
+        {
+            continue;
+        }
+        uint32_t slice = atomic_load_explicit(&bus->health_slice, memory_order_relaxed);
+        uint32_t elapsed = now - bus->health_slice_start;
+        if (elapsed >= MG6010E_HEALTH_SLICE_US)
+        {
+            uint32_t advance = elapsed / MG6010E_HEALTH_SLICE_US;
+            bus->health_slice_start += advance * MG6010E_HEALTH_SLICE_US;
+            for (uint32_t i = 1; i <= advance && i <= MG6010E_HEALTH_SLICE_NUM; i++)
+            {
+                atomic_store_explicit(&bus->health_seen[(slice + i) & (MG6010E_HEALTH_SLICE_NUM - 1)], 0, memory_order_relaxed);
+            }
+            slice += advance;
+            atomic_store_explicit(&bus->health_slice, slice, memory_order_release); // 先清空再切换，接收路径不会写入未清空的时间片
+        }
+
+        // 最近health_window个时间片（含当前时间片）内有回复的电机距最近一次回复不超过最短的超时时间，无需判断
+        uint32_t recent = 0;
+        for (uint32_t i = 0; i < bus->health_window; i++)
+        {
+            recent |= atomic_load_explicit(&bus->health_seen[(slice - i) & (MG6010E_HEALTH_SLICE_NUM - 1)], memory_order_acquire);
+        }
+        uint32_t candidates = monitored & ~recent & ~atomic_load_explicit(&bus->health_stale, memory_order_relaxed);
+        for (uint32_t index = 0; candidates != 0; index++, candidates >>= 1)
+        {
+            if (!(candidates & 1) || bus->handle_table[index] == NULL)
+            {
+                continue;
+            }
+            mg6010e_handle_t *mg6010e_handle = bus->handle_table[index];
+            mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+            uint32_t age = now - atomic_load_explicit(&entry->last_reply, memory_order_relaxed);
+            if ((int32_t)age < 0 || age <= entry->config.timeout_us)
+            {
+                continue; // 读取now之后收到了回复，或尚未超时
+            }
+            atomic_fetch_or_explicit(&bus->health_stale, 1UL << index, memory_order_relaxed);
+            mg6010e_health_trip(mg6010e_handle, MG6010E_HEALTH_STALE, now);
+        }
+    }
+}
+
+/**
+ * @brief 获取电机的健康监测状态
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param health 状态输出
+ * @return uint8_t 错误码，0表示成功，1表示health为空，4表示未初始化
+ * @note 读取时不加锁，各字段可能来自略有不同的时刻
+ */
+uint8_t mg6010e_get_health(uint8_t motor_id, mg6010e_health_t *health)
+{
+    if (health == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    const mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    uint32_t age = mg6010e_get_timestamp_us() - atomic_load_explicit(&entry->last_reply, memory_order_relaxed);
+    health->faults = atomic_load_explicit(&entry->faults, memory_order_relaxed);
+    health->age_us = entry->enabled && (int32_t)age > 0 ? age : 0;
+    health->max_interval_us = entry->max_interval;
+    health->fault_time = entry->fault_time;
+    health->trips = entry->trips;
+    health->reaction_result = entry->reaction_result;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 清除电机已锁存的故障，恢复接受控制命令
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @note 故障动作发出的命令不会撤销，需要时再调用mg6010e_run或mg6010e_break_control。
+ * 回复超时从调用时重新计时；故障条件仍然存在时，下一帧相应的回复会再次锁存故障并执行故障动作。
+ */
+uint8_t mg6010e_clear_health_fault(uint8_t motor_id)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
+    {
+        return MG6010E_ERROR_NOT_INITIALIZED;
+    }
+    mg6010e_health_entry_t *entry = &mg6010e_health_table[mg6010e_handle - mg6010e_handle_pool];
+    atomic_store_explicit(&entry->last_reply, mg6010e_get_timestamp_us(), memory_order_relaxed);
+    atomic_fetch_and_explicit(&mg6010e_bus_table[mg6010e_handle->bus_index].health_stale, ~(1UL << (MG6010E_MOTOR_CAN_ID(motor_id) - 1)), memory_order_release);
+    atomic_store_explicit(&entry->faults, 0, memory_order_release);
+    return MG6010E_SUCCESS;
+}
+#endif /* MG6010E_USE_HEALTH */
 
 /**
- * @brief 注册领控6010E电机句柄到句柄表
+ * @brief 在顺序锁保护下复制句柄中的数据
  *
  * @param mg6010e_handle 电机句柄指针
- * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @param dst 目标地址
+ * @param src 句柄中的源地址
+ * @param size 数据长度
+ * @param dst2 第二段目标地址，为NULL时忽略
+ * @param src2 第二段源地址
+ * @param size2 第二段数据长度
+ * @return uint8_t 错误码，0表示成功，8表示重试MG6010E_SNAPSHOT_RETRY次后仍与接收中断冲突
+ * @note 接收中断写入时不等待读者，读者发现计数变化后重新复制，保证不会读到写了一半的数据（如64位的angle）。
+ * 若在优先级高于CAN接收中断的上下文中调用，可能因写入被打断而返回8。
  */
-static uint8_t mg6010e_register_handle(mg6010e_handle_t *mg6010e_handle)
+static uint8_t mg6010e_snapshot(mg6010e_handle_t *mg6010e_handle, void *dst, const void *src, size_t size, void *dst2, const void *src2, size_t size2)
 {
-    if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+    for (uint32_t retry = 0; retry < MG6010E_SNAPSHOT_RETRY; retry++)
     {
-        return MG6010E_ERROR_NOT_INITIALIZED;
+        uint32_t seq = atomic_load_explicit(&mg6010e_handle->sequence, memory_order_acquire);
+        if (seq & 1)
+        {
+            continue; // 接收中断正在写入
+        }
+        memcpy(dst, src, size);
+        if (dst2 != NULL)
+        {
+            memcpy(dst2, src2, size2);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&mg6010e_handle->sequence, memory_order_relaxed) == seq)
+        {
+            return MG6010E_SUCCESS;
+        }
     }
-    uint32_t motor_id = mg6010e_handle->config.motor_id;
-    mg6010e_handle_table[motor_id - 1] = mg6010e_handle;
-    return MG6010E_SUCCESS;
+    return MG6010E_ERROR_BUSY;
 }
 
 /**
- * @brief 初始化领控6010E电机配置
+ * @brief 获取领控6010E电机状态数据
  *
- * @param mg6010e_config 电机配置结构体指针
- * @return uint8_t 错误码，0表示成功，1表示配置结构体指针为空，2表示CAN句柄为空，3表示电机ID无效
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param status 电机状态数据指针
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，8表示与接收中断冲突
  */
-uint8_t mg6010e_init(mg6010e_config_t *mg6010e_config)
+uint8_t mg6010e_get_motor_status(uint8_t motor_id, mg6010e_status_t *status)
 {
-    if (mg6010e_config == NULL)
+    return mg6010e_get_motor_status_time(motor_id, status, NULL);
+}
+
+/**
+ * @brief 获取领控6010E电机状态数据及各字段的更新时间
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param status 电机状态数据指针
+ * @param status_time 各字段更新时间指针，为NULL时不读取
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，8表示与接收中断冲突
+ * @note 状态与时间戳来自同一次快照，时间戳由mg6010e_get_timestamp_us提供
+ */
+uint8_t mg6010e_get_motor_status_time(uint8_t motor_id, mg6010e_status_t *status, mg6010e_status_time_t *status_time)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
     {
-        return MG6010E_ERROR_CONFIG_NULL_PTR; // 配置结构体指针为空错误
+        return MG6010E_ERROR_NOT_INITIALIZED;
     }
-    if (mg6010e_config->can_handle == NULL)
+    return mg6010e_snapshot(mg6010e_handle, status, &mg6010e_handle->status, sizeof(mg6010e_status_t),
+                            status_time, &mg6010e_handle->status_time, sizeof(mg6010e_status_time_t));
+}
+
+/**
+ * @brief 获取领控6010E电机编码器参数数据
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param encoder_data 电机编码器参数数据指针
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，8表示与接收中断冲突
+ */
+uint8_t mg6010e_get_motor_encoder_data(uint8_t motor_id, mg6010e_encoder_data_t *encoder_data)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
     {
-        return MG6010E_ERROR_CAN_NULL_PTR; // CAN句柄为空错误
+        return MG6010E_ERROR_NOT_INITIALIZED;
     }
-    if (mg6010e_config->motor_id < 1 || mg6010e_config->motor_id > 32)
+    return mg6010e_snapshot(mg6010e_handle, encoder_data, &mg6010e_handle->encoder_data, sizeof(mg6010e_encoder_data_t), NULL, NULL, 0);
+}
+
+/**
+ * @brief 获取领控6010E电机控制参数数据
+ *
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param control_params 电机控制参数数据指针
+ * @return uint8_t 错误码，0表示成功，4表示未初始化，8表示与接收中断冲突
+ */
+uint8_t mg6010e_get_motor_control_params(uint8_t motor_id, mg6010e_control_params_t *control_params)
+{
+    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    if (mg6010e_handle == NULL)
     {
-        return MG6010E_ERROR_INVALID_ID; // 电机ID无效错误
+        return MG6010E_ERROR_NOT_INITIALIZED;
     }
-    mg6010e_handle_t *mg6010e_handle = malloc(sizeof(mg6010e_handle_t));
-    mg6010e_handle->config = *mg6010e_config;
-    mg6010e_handle->status = (mg6010e_status_t){0};
-    mg6010e_handle->encoder_data = (mg6010e_encoder_data_t){0};
-    mg6010e_handle->control_params = (mg6010e_control_params_t){0};
-    mg6010e_handle->initialized = 1;
-    return mg6010e_register_handle(mg6010e_handle);
+    return mg6010e_snapshot(mg6010e_handle, control_params, &mg6010e_handle->control_params, sizeof(mg6010e_control_params_t), NULL, NULL, 0);
 }
 
 /**
- * @brief 通过电机ID获取领控6010E电机句柄
+ * @brief 获取驱动使用的时间戳
  *
- * @param motor_id 电机ID（1-32）
- * @return mg6010e_handle_t* 电机句柄指针，若ID无效则返回NULL
+ * @return uint32_t 时间戳，单位us
+ * @note 弱定义，默认取自传输层，HAL传输层由HAL_GetTick换算，精度为1ms。
+ * 如需更高精度请在用户代码中重新实现（如使用DWT周期计数器或硬件定时器）。
  */
-static mg6010e_handle_t *mg6010e_get_handle_by_id(uint8_t motor_id)
+__weak uint32_t mg6010e_get_timestamp_us(void)
 {
-    if (motor_id < 1 || motor_id > 32)
+    if (mg6010e_transport == NULL || mg6010e_transport->timestamp_us == NULL)
     {
-        return NULL; // 电机ID无效
+        return 0;
     }
-    return mg6010e_handle_table[motor_id - 1];
+    return mg6010e_transport->timestamp_us();
 }
 
+#if MG6010E_USE_SOA_TELEMETRY
 /**
- * @brief 发送领控6010E电机命令
+ * @brief 批量获取电机速度
  *
- * @param mg6010e_handle 电机句柄指针
- * @param cmd_data 命令数据数组指针
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 依赖HAL库
+ * @param bus 总线编号，见mg6010e_get_bus_index
+ * @param speeds 长度为32的数组，speeds[n]对应ID为n+1的电机，单位：1dps/LSB
+ * @param mask 需要读取的电机掩码，bit n 对应ID为n+1的电机，未选中的元素保持不变
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，3表示总线编号无效
+ * @note 16位数据在32位MCU上的读写是原子的，无需加锁
  */
-static uint8_t mg6010e_send_cmd(mg6010e_handle_t *mg6010e_handle, uint8_t *cmd_data)
+uint8_t mg6010e_get_speeds(uint8_t bus, int16_t *speeds, uint32_t mask)
 {
-    if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
+    if (speeds == NULL)
     {
-        return MG6010E_ERROR_NOT_INITIALIZED; // 未初始化错误
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
     }
-
-    CAN_TxHeaderTypeDef tx_header;
-    tx_header.StdId = MG6010E_CAN_CMD_ID(mg6010e_handle->config.motor_id);
-    tx_header.ExtId = 0;
-    tx_header.IDE = CAN_ID_STD;
-    tx_header.RTR = CAN_RTR_DATA;
-    tx_header.DLC = 8;
-
-    if (HAL_CAN_AddTxMessage(mg6010e_handle->config.can_handle, &tx_header, cmd_data, &mg6010e_handle->config.can_tx_mailbox) != HAL_OK)
+    if (bus >= MG6010E_MAX_CAN_BUS)
+    {
+        return MG6010E_ERROR_INVALID_ID;
+    }
+    for (uint32_t i = 0; i < 32; i++)
     {
-        return MG6010E_ERROR_SEND_FAILED; // 发送失败错误
+        if (mask & (1UL << i))
+        {
+            speeds[i] = ((volatile int16_t *)mg6010e_telemetry[bus].speed)[i];
+        }
     }
     return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 发送领控6010E电机读取状态1命令
+ * @brief 批量获取电机实际转矩电流
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 该命令读取当前电机的温度、电压和错误状态标志
+ * @param bus 总线编号，见mg6010e_get_bus_index
+ * @param iqs 长度为32的数组，iqs[n]对应ID为n+1的电机，单位：(66/4096 A ≈ 0.01622 A) / LSB
+ * @param mask 需要读取的电机掩码，bit n 对应ID为n+1的电机，未选中的元素保持不变
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，3表示总线编号无效
  */
-uint8_t mg6010e_read_status_1(uint8_t motor_id)
+uint8_t mg6010e_get_iqs(uint8_t bus, int16_t *iqs, uint32_t mask)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x9A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    if (iqs == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (bus >= MG6010E_MAX_CAN_BUS)
+    {
+        return MG6010E_ERROR_INVALID_ID;
+    }
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        if (mask & (1UL << i))
+        {
+            iqs[i] = ((volatile int16_t *)mg6010e_telemetry[bus].iqActual)[i];
+        }
+    }
+    return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 发送领控6010E电机清除错误标志命令
+ * @brief 批量获取电机编码器值
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 该命令清除当前电机的错误状态，电机收到后返回，电机状态没有恢复正常时，错误标志无法清除。
+ * @param bus 总线编号，见mg6010e_get_bus_index
+ * @param encoders 长度为32的数组，encoders[n]对应ID为n+1的电机
+ * @param mask 需要读取的电机掩码，bit n 对应ID为n+1的电机，未选中的元素保持不变
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，3表示总线编号无效
  */
-uint8_t mg6010e_clean_error_flag(uint8_t motor_id)
+uint8_t mg6010e_get_encoders(uint8_t bus, uint16_t *encoders, uint32_t mask)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x9B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    if (encoders == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (bus >= MG6010E_MAX_CAN_BUS)
+    {
+        return MG6010E_ERROR_INVALID_ID;
+    }
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        if (mask & (1UL << i))
+        {
+            encoders[i] = ((volatile uint16_t *)mg6010e_telemetry[bus].encoder)[i];
+        }
+    }
+    return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 发送领控6010E电机读取状态2命令
+ * @brief 批量获取电机温度
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 该命令读取当前电机的温度、电机转矩电流（MF、MG）/电机输出功率（MS）、转速、编码器位置。
+ * @param bus 总线编号，见mg6010e_get_bus_index
+ * @param temperatures 长度为32的数组，temperatures[n]对应ID为n+1的电机，单位 1℃/LSB
+ * @param mask 需要读取的电机掩码，bit n 对应ID为n+1的电机，未选中的元素保持不变
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，3表示总线编号无效
  */
-uint8_t mg6010e_read_status_2(uint8_t motor_id)
+uint8_t mg6010e_get_temperatures(uint8_t bus, int8_t *temperatures, uint32_t mask)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    if (temperatures == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (bus >= MG6010E_MAX_CAN_BUS)
+    {
+        return MG6010E_ERROR_INVALID_ID;
+    }
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        if (mask & (1UL << i))
+        {
+            temperatures[i] = ((volatile int8_t *)mg6010e_telemetry[bus].temperature)[i];
+        }
+    }
+    return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 发送领控6010E电机读取状态3命令
+ * @brief 批量获取电机多圈角度
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 该命令读取当前电机的温度和 3 相电流数据
+ * @param bus 总线编号，见mg6010e_get_bus_index
+ * @param angles 长度为32的数组，angles[n]对应ID为n+1的电机，单位：0.01°/LSB
+ * @param mask 需要读取的电机掩码，bit n 对应ID为n+1的电机，未选中的元素保持不变
+ * @return uint8_t 错误码，0表示成功，1表示数组指针为空，3表示总线编号无效，8表示某个电机重试MG6010E_SNAPSHOT_RETRY次后仍与接收中断冲突
  */
-uint8_t mg6010e_read_status_3(uint8_t motor_id)
+uint8_t mg6010e_get_angles(uint8_t bus, int64_t *angles, uint32_t mask)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x9D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    if (angles == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    if (bus >= MG6010E_MAX_CAN_BUS)
+    {
+        return MG6010E_ERROR_INVALID_ID;
+    }
+    uint8_t ret = MG6010E_SUCCESS;
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        if (!(mask & (1UL << i)))
+        {
+            continue;
+        }
+        uint32_t retry = 0;
+        for (; retry < MG6010E_SNAPSHOT_RETRY; retry++)
+        {
+            uint32_t seq = atomic_load_explicit(&mg6010e_telemetry[bus].angle_sequence[i], memory_order_acquire);
+            int64_t angle = ((volatile int64_t *)mg6010e_telemetry[bus].angle)[i];
+            atomic_thread_fence(memory_order_acquire);
+            if (!(seq & 1) && atomic_load_explicit(&mg6010e_telemetry[bus].angle_sequence[i], memory_order_relaxed) == seq)
+            {
+                angles[i] = angle;
+                break;
+            }
+        }
+        if (retry == MG6010E_SNAPSHOT_RETRY)
+        {
+            ret = MG6010E_ERROR_BUSY;
+        }
+    }
+    return ret;
 }
+#endif /* MG6010E_USE_SOA_TELEMETRY */
 
 /**
- * @brief 发送领控6010E电机关闭命令
- *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 将电机从开启状态（上电后默认状态）切换到关闭状态，清除电机转动圈数及之前接收的控制指令，
-LED 由常亮转为慢闪。此时电机仍然可以回复控制命令，但不会执行动作。
+ * @brief 按小端读取16位数据
  */
-uint8_t mg6010e_disable(uint8_t motor_id)
+static inline uint16_t mg6010e_read_le16(const uint8_t *data)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
 }
 
 /**
- * @brief 发送领控6010E电机开启命令
- *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 将电机从关闭状态切换到开启状态，LED 由慢闪转为常亮。此时再发送控制指令即可控制电机动作。
+ * @brief 按小端读取32位数据
  */
-uint8_t mg6010e_run(uint8_t motor_id)
+static inline uint32_t mg6010e_read_le32(const uint8_t *data)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    return ((uint32_t)data[0]) | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
 
-    uint8_t cmd_data[8] = {0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+// 反馈帧解析函数，按命令字节（或控制参数ID）查表调用
+typedef void (*mg6010e_rx_decoder_t)(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp);
+
+static void mg6010e_decode_status_1(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取状态1反馈
+{
+    mg6010e_handle->status.temperature = rx_data[1];
+    mg6010e_handle->status.voltage = mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->status.current = (int16_t)mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->status.motorState = rx_data[6];
+    mg6010e_handle->status.errorState = rx_data[7];
+    mg6010e_handle->status_time.temperature = timestamp;
+    mg6010e_handle->status_time.voltage = timestamp;
+    mg6010e_handle->status_time.current = timestamp;
+    mg6010e_handle->status_time.motorState = timestamp;
+    mg6010e_handle->status_time.errorState = timestamp;
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry[mg6010e_handle->bus_index].temperature[mg6010e_handle->config.motor_id - 1] = mg6010e_handle->status.temperature;
+#endif
 }
 
 /**
- * @brief 发送领控6010E电机停止命令
- *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 停止电机，但不清除电机运行状态。再次发送控制指令即可控制电机动作。
+ * @brief 写入状态2布局（0x9C、0xA1~0xA8）的反馈数据
  */
-uint8_t mg6010e_stop(uint8_t motor_id)
+static inline void mg6010e_store_status_2(mg6010e_handle_t *mg6010e_handle, uint8_t temperature, int16_t iqActual, int16_t speed, uint16_t encoder, uint32_t timestamp)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_handle->status.temperature = temperature;
+    mg6010e_handle->status.iqActual = iqActual;
+    mg6010e_handle->status.speed = speed;
+    mg6010e_handle->status.encoder = encoder;
+    mg6010e_handle->status_time.temperature = timestamp;
+    mg6010e_handle->status_time.iqActual = timestamp;
+    mg6010e_handle->status_time.speed = timestamp;
+    mg6010e_handle->status_time.encoder = timestamp;
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry_t *telemetry = &mg6010e_telemetry[mg6010e_handle->bus_index];
+    uint32_t index = mg6010e_handle->config.motor_id - 1;
+    telemetry->temperature[index] = temperature;
+    telemetry->iqActual[index] = iqActual;
+    telemetry->speed[index] = speed;
+    telemetry->encoder[index] = encoder;
+#endif
+}
 
-    uint8_t cmd_data[8] = {0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+static void mg6010e_decode_status_2(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取状态2反馈及0xA1~0xA8控制命令反馈
+{
+    mg6010e_store_status_2(mg6010e_handle, rx_data[1], (int16_t)mg6010e_read_le16(&rx_data[2]), (int16_t)mg6010e_read_le16(&rx_data[4]), mg6010e_read_le16(&rx_data[6]), timestamp);
 }
 
-/**
- * @brief 发送领控6010E电机抱闸器状态读取命令
- *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 读取当前抱闸器的状态。
- */
-uint8_t mg6010e_break_status_read(uint8_t motor_id)
+static void mg6010e_decode_status_3(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取状态3反馈
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    mg6010e_handle->status.temperature = rx_data[1];
+    mg6010e_handle->status.iA = (int16_t)mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->status.iB = (int16_t)mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->status.iC = (int16_t)mg6010e_read_le16(&rx_data[6]);
+    mg6010e_handle->status_time.temperature = timestamp;
+    mg6010e_handle->status_time.iA = timestamp;
+    mg6010e_handle->status_time.iB = timestamp;
+    mg6010e_handle->status_time.iC = timestamp;
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry[mg6010e_handle->bus_index].temperature[mg6010e_handle->config.motor_id - 1] = mg6010e_handle->status.temperature;
+#endif
+}
 
-    uint8_t cmd_data[8] = {0x8C, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+static void mg6010e_decode_brake(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 抱闸器状态反馈
+{
+    mg6010e_handle->status.brakeStatus = rx_data[1];
+    mg6010e_handle->status_time.brakeStatus = timestamp;
 }
 
-/**
- * @brief 发送领控6010E电机抱闸器控制命令
- *
- * @param motor_id 电机ID（1-32）
- * @param engage 抱闸器状态，0：抱闸器断电，刹车启动，1：抱闸器通电，刹车释放
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 控制抱闸器的开合。
- */
-uint8_t mg6010e_break_control(uint8_t motor_id, uint8_t engage)
+static void mg6010e_decode_angle_pid(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 角度环PID参数
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    (void)timestamp;
+    mg6010e_handle->control_params.anglekp = mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->control_params.angleki = mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->control_params.anglekd = mg6010e_read_le16(&rx_data[6]);
+}
 
-    uint8_t cmd_data[8] = {0x8C, engage ? 0x01 : 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+static void mg6010e_decode_speed_pid(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 速度环PID参数
+{
+    (void)timestamp;
+    mg6010e_handle->control_params.speedkp = mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->control_params.speedki = mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->control_params.speedkd = mg6010e_read_le16(&rx_data[6]);
 }
 
-/**
- * @brief 发送领控6010E电机转矩电流闭环控制命令
- *
- * @param motor_id 电机ID（1-32）
- * @param iqControl 转矩电流，数值范围-2048~ 2048，对应 MG 电机实际转矩电流范围-33A~33A
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的转矩电流输出，母线电流和电机的实际扭矩因不同电机而异。
- * 该命令中的控制值 iqControl 不受上位机中的 Max Torque Current 值限制。
- */
-uint8_t mg6010e_iq_control(uint8_t motor_id, int16_t iqControl)
+static void mg6010e_decode_current_pid(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 电流环PID参数
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    (void)timestamp;
+    mg6010e_handle->control_params.currentkp = mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->control_params.currentki = mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->control_params.currentkd = mg6010e_read_le16(&rx_data[6]);
+}
 
-    uint8_t cmd_data[8] = {0xA1, 0x00, 0x00, 0x00, *(uint8_t *)(&iqControl), *((uint8_t *)(&iqControl) + 1), 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+static void mg6010e_decode_torque_limit(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 转矩电流限制参数
+{
+    (void)timestamp;
+    mg6010e_handle->control_params.inputTorqueLimit = (int16_t)mg6010e_read_le16(&rx_data[4]);
 }
 
-/**
- * @brief 发送领控6010E电机速度闭环控制命令
- *
- * @param motor_id 电机ID（1-32）
- * @param iqControl 转矩电流，数值范围-2048~ 2048，对应 MG 电机实际转矩电流范围-33A~33A
- * @param speedControl 速度控制值，对应实际转速为 0.01dps/LSB
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的速度，同时带有力矩限制。母线电流和电机的实际扭矩因不同电机而异。
- * 该命令下电机的 speedControl 由上位机中的 Max Speed 值限制。
- * 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- */
-uint8_t mg6010e_speed_control(uint8_t motor_id, int16_t iqControl, int32_t speedControl)
+static void mg6010e_decode_speed_limit(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 最大速度参数
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    (void)timestamp;
+    mg6010e_handle->control_params.inputSpeedLimit = (int32_t)mg6010e_read_le32(&rx_data[4]);
+}
+
+static void mg6010e_decode_angle_limit(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 角度限制参数
+{
+    (void)timestamp;
+    mg6010e_handle->control_params.inputAngleLimit = (int32_t)mg6010e_read_le32(&rx_data[4]);
+}
+
+static void mg6010e_decode_current_ramp(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 电流斜率参数
+{
+    (void)timestamp;
+    mg6010e_handle->control_params.inputCurrentRamp = (int32_t)mg6010e_read_le32(&rx_data[4]);
+}
 
-    uint8_t cmd_data[8] = {0xA2, 0x00, *(uint8_t *)(&iqControl), *((uint8_t *)(&iqControl) + 1), *(uint8_t *)(&speedControl), *((uint8_t *)(&speedControl) + 1), *((uint8_t *)(&speedControl) + 2), *((uint8_t *)(&speedControl) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+static void mg6010e_decode_speed_ramp(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 速度斜率参数
+{
+    (void)timestamp;
+    mg6010e_handle->control_params.inputSpeedRamp = (int32_t)mg6010e_read_le32(&rx_data[4]);
+}
+
+// 控制参数解析表，按控制参数ID索引
+static const mg6010e_rx_decoder_t mg6010e_param_decoder_table[] = {
+    [0x0A] = mg6010e_decode_angle_pid,
+    [0x0B] = mg6010e_decode_speed_pid,
+    [0x0C] = mg6010e_decode_current_pid,
+    [0x1E] = mg6010e_decode_torque_limit,
+    [0x20] = mg6010e_decode_speed_limit,
+    [0x22] = mg6010e_decode_angle_limit,
+    [0x24] = mg6010e_decode_current_ramp,
+    [0x26] = mg6010e_decode_speed_ramp,
+};
+
+static void mg6010e_decode_control_param(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取/写入控制参数反馈
+{
+    if (rx_data[1] < sizeof(mg6010e_param_decoder_table) / sizeof(mg6010e_param_decoder_table[0]) && mg6010e_param_decoder_table[rx_data[1]] != NULL)
+    {
+        mg6010e_param_decoder_table[rx_data[1]](mg6010e_handle, rx_data, timestamp);
+    }
+}
+
+static void mg6010e_decode_encoder(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取编码器反馈
+{
+    (void)timestamp;
+    mg6010e_handle->encoder_data.encoder = mg6010e_read_le16(&rx_data[2]);
+    mg6010e_handle->encoder_data.encoderRaw = mg6010e_read_le16(&rx_data[4]);
+    mg6010e_handle->encoder_data.encoderOffset = mg6010e_read_le16(&rx_data[6]);
+}
+
+static void mg6010e_decode_encoder_zero(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 写入编码器零点反馈
+{
+    (void)timestamp;
+    mg6010e_handle->encoder_data.encoderOffset = mg6010e_read_le16(&rx_data[6]);
+}
+
+static void mg6010e_decode_angle(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取多圈角度反馈
+{
+    uint64_t angle = ((uint64_t)rx_data[1]) | ((uint64_t)rx_data[2] << 8) | ((uint64_t)rx_data[3] << 16) | ((uint64_t)rx_data[4] << 24) | ((uint64_t)rx_data[5] << 32) | ((uint64_t)rx_data[6] << 40) | ((uint64_t)rx_data[7] << 48);
+    mg6010e_handle->status.angle = (int64_t)(angle ^ (1ULL << 55)) - (int64_t)(1ULL << 55); // 7字节有符号数，符号扩展到64位
+    mg6010e_handle->status_time.angle = timestamp;
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry_set_angle(&mg6010e_telemetry[mg6010e_handle->bus_index], mg6010e_handle->config.motor_id - 1, mg6010e_handle->status.angle);
+#endif
 }
 
+static void mg6010e_decode_single_angle(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 读取单圈角度反馈
+{
+    mg6010e_handle->status.single_angle = mg6010e_read_le32(&rx_data[4]);
+    mg6010e_handle->status_time.single_angle = timestamp;
+}
+
+static void mg6010e_decode_set_angle(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp) // 设置当前位置反馈
+{
+    mg6010e_handle->status.angle = (int32_t)mg6010e_read_le32(&rx_data[4]);
+    mg6010e_handle->status_time.angle = timestamp;
+#if MG6010E_USE_SOA_TELEMETRY
+    mg6010e_telemetry_set_angle(&mg6010e_telemetry[mg6010e_handle->bus_index], mg6010e_handle->config.motor_id - 1, mg6010e_handle->status.angle);
+#endif
+}
+
+// 反馈帧解析表，按命令字节索引，未列出的命令字节为NULL
+static const mg6010e_rx_decoder_t mg6010e_rx_decoder_table[256] = {
+    [0x9A] = mg6010e_decode_status_1,
+    [0x9B] = mg6010e_decode_status_1, // 清除错误标志的回复与读取状态1相同
+    [0x9C] = mg6010e_decode_status_2,
+    [0xA1] = mg6010e_decode_status_2,
+    [0xA2] = mg6010e_decode_status_2,
+    [0xA3] = mg6010e_decode_status_2,
+    [0xA4] = mg6010e_decode_status_2,
+    [0xA5] = mg6010e_decode_status_2,
+    [0xA6] = mg6010e_decode_status_2,
+    [0xA7] = mg6010e_decode_status_2,
+    [0xA8] = mg6010e_decode_status_2,
+    [0x9D] = mg6010e_decode_status_3,
+    [0x8C] = mg6010e_decode_brake,
+    [0xC0] = mg6010e_decode_control_param,
+    [0xC1] = mg6010e_decode_control_param,
+    [0x90] = mg6010e_decode_encoder,
+    [0x19] = mg6010e_decode_encoder_zero,
+    [0x92] = mg6010e_decode_angle,
+    [0x94] = mg6010e_decode_single_angle,
+    [0x95] = mg6010e_decode_set_angle,
+};
+
 /**
- * @brief 发送领控6010E电机多圈角度位置闭环控制命令
- *
- * @param motor_id 电机ID（1-32）
- * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置（多圈角度）。电机转动方向由目标位置和当前位置的差值决定。
- * 1. 该命令下的控制值 angleControl 受上位机中的 Max Angle 值限制。
- * 2. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
- * 3. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 4. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ * @brief 顺序锁写端开始，计数为奇数期间读者会重试，写端无需等待
  */
-uint8_t mg6010e_angle_control(uint8_t motor_id, int32_t angleControl)
+static inline uint32_t mg6010e_seqlock_write_begin(mg6010e_handle_t *mg6010e_handle)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA3, 0x00, 0x00, 0x00, *(uint8_t *)(&angleControl), *((uint8_t *)(&angleControl) + 1), *((uint8_t *)(&angleControl) + 2), *((uint8_t *)(&angleControl) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    uint32_t seq = atomic_load_explicit(&mg6010e_handle->sequence, memory_order_relaxed);
+    atomic_store_explicit(&mg6010e_handle->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return seq;
 }
 
 /**
- * @brief 发送领控6010E电机多圈角度位置闭环控制命令2
- *
- * @param motor_id 电机ID（1-32）
- * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置（多圈角度）。电机转动方向由目标位置和当前位置的差值决定。携带最大速度参数。
- * 1. 该命令下的控制值 angleControl 受上位机中的 Max Angle 值限制。
- * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ * @brief 顺序锁写端结束
  */
-uint8_t mg6010e_angle_control_2(uint8_t motor_id, int32_t angleControl, uint16_t maxSpeed)
+static inline void mg6010e_seqlock_write_end(mg6010e_handle_t *mg6010e_handle, uint32_t seq)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA4, 0x00, *(uint8_t *)(&maxSpeed), *((uint8_t *)(&maxSpeed) + 1), *(uint8_t *)(&angleControl), *((uint8_t *)(&angleControl) + 1), *((uint8_t *)(&angleControl) + 2), *((uint8_t *)(&angleControl) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    atomic_store_explicit(&mg6010e_handle->sequence, seq + 2, memory_order_release);
 }
 
+#if MG6010E_USE_DEFERRED_RX || MG6010E_USE_STATS
 /**
- * @brief 发送领控6010E电机单圈角度位置闭环控制命令
+ * @brief 获取CPU周期计数，用于测量接收中断耗时
  *
- * @param motor_id 电机ID（1-32）
- * @param angleControl 位置控制值，范围（0 ~ 36000）对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @param spinDirection 旋转方向，0表示顺时针，1表示逆时针
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置（单圈角度）。
- * 1. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
- * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ * @return uint32_t 周期计数
+ * @note 弱定义，使用HAL时读取DWT->CYCCNT（需先使能DWT周期计数器），否则返回0。可在用户代码中重新实现。
  */
-uint8_t mg6010e_single_angle_control(uint8_t motor_id, uint32_t angleControl, uint8_t spinDirection)
+__weak uint32_t mg6010e_get_cycle_count(void)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA5, spinDirection, 0x00, 0x00, *(uint8_t *)(&angleControl), *((uint8_t *)(&angleControl) + 1), *((uint8_t *)(&angleControl) + 2), *((uint8_t *)(&angleControl) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+#if MG6010E_USE_HAL
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
 }
+#endif
 
 /**
- * @brief 发送领控6010E电机单圈角度位置闭环控制命令2
+ * @brief 统计并跟踪一帧到达的反馈
  *
- * @param motor_id 电机ID（1-32）
- * @param angleControl 位置控制值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
- * @param spinDirection 旋转方向，0表示顺时针，1表示逆时针
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置（单圈角度）。携带最大速度参数。
- * 1. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 2. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制；
+ * @param bus 总线上下文
+ * @param frame 反馈帧，ID已确认在反馈ID范围内
+ * @param registered 该ID的电机是否已初始化
+ * @param timestamp 接收时间戳，单位us
  */
-uint8_t mg6010e_single_angle_control_2(uint8_t motor_id, int32_t angleControl, uint16_t maxSpeed, uint8_t spinDirection)
+static inline void mg6010e_rx_record(mg6010e_bus_t *bus, const mg6010e_can_frame_t *frame, uint8_t registered, uint32_t timestamp)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA6, spinDirection, *(uint8_t *)(&maxSpeed), *((uint8_t *)(&maxSpeed) + 1), *(uint8_t *)(&angleControl), *((uint8_t *)(&angleControl) + 1), *((uint8_t *)(&angleControl) + 2), *((uint8_t *)(&angleControl) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+#if MG6010E_USE_STATS
+    bus->stats.rx_frames++;
+    bus->stats.rx_unregistered += !registered;
+#endif
+    MG6010E_TRACE(registered ? MG6010E_TRACE_RX : MG6010E_TRACE_RX_UNREGISTERED, bus - mg6010e_bus_table, frame->std_id, frame->data[0], timestamp);
+    (void)bus;
+    (void)frame;
+    (void)registered;
+    (void)timestamp;
 }
 
 /**
- * @brief 发送领控6010E电机多圈角度位置闭环控制命令
+ * @brief 统计并跟踪一帧已找到电机句柄的反馈，命令字节未知时计入rx_unknown
  *
- * @param motor_id 电机ID（1-32）
- * @param angleIncrement 增量值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置增量。
- * 1. 该命令下电机的最大速度由上位机中的 Max Speed 值限制。
- * 2. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 3. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ * @param bus 总线上下文
+ * @param mg6010e_handle 电机句柄
+ * @param decoder 按命令字节查到的解析函数
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
  */
-uint8_t mg6010e_angle_increment_control(uint8_t motor_id, int32_t angleIncrement)
+static inline void mg6010e_rx_account(mg6010e_bus_t *bus, mg6010e_handle_t *mg6010e_handle, mg6010e_rx_decoder_t decoder, const uint8_t *rx_data, uint32_t timestamp)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA7, 0x00, 0x00, 0x00, *(uint8_t *)(&angleIncrement), *((uint8_t *)(&angleIncrement) + 1), *((uint8_t *)(&angleIncrement) + 2), *((uint8_t *)(&angleIncrement) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+#if MG6010E_USE_STATS || MG6010E_USE_TRACE
+    // 0x80、0x81、0x88的回复不携带数据，没有解析函数
+    uint8_t unknown = decoder == NULL && rx_data[0] != 0x80 && rx_data[0] != 0x81 && rx_data[0] != 0x88;
+#endif
+#if MG6010E_USE_STATS
+    mg6010e_motor_stats_t *stats = &mg6010e_motor_stats_table[mg6010e_handle - mg6010e_handle_pool];
+    stats->rx_frames++;
+    stats->rx_unknown += unknown;
+    bus->stats.rx_unknown += unknown;
+#endif
+#if MG6010E_USE_TRACE
+    if (unknown)
+    {
+        MG6010E_TRACE(MG6010E_TRACE_RX_UNKNOWN, bus - mg6010e_bus_table, MG6010E_CAN_FEEDBACK_ID(mg6010e_handle->config.motor_id), rx_data[0], timestamp);
+    }
+#endif
+    (void)bus;
+    (void)mg6010e_handle;
+    (void)decoder;
+    (void)rx_data;
+    (void)timestamp;
 }
 
 /**
- * @brief 发送领控6010E电机多圈角度位置闭环控制命令2
+ * @brief 反馈写入句柄后，交给依赖回复的功能（健康监测、请求跟踪、轨迹跟踪误差、控制参数快照、编码器累计、遥测记录、命令组偏差、自适应轮询）
  *
- * @param motor_id 电机ID（1-32）
- * @param angleIncrement 增量值，对应实际位置为 0.01deg/LSB，即 36000 代表 360°
- * @param maxSpeed 最大速度控制值，对应实际转速 1dps/LSB，即 360 代表 360dps。
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以控制电机的位置增量。携带最大速度参数。
- * 1. 该控制模式下，电机的最大加速度由上位机中的 Max Acceleration 值限制。
- * 2. 该控制模式下，MF、MH、MG 电机的最大转矩电流由上位机中的 Max Torque Current 值限制。
+ * @param mg6010e_handle 电机句柄
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
  */
-uint8_t mg6010e_angle_increment_control_2(uint8_t motor_id, int32_t angleIncrement, uint16_t maxSpeed)
+static inline void mg6010e_rx_feedback(mg6010e_handle_t *mg6010e_handle, const uint8_t *rx_data, uint32_t timestamp)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xA8, 0x00, *(uint8_t *)(&maxSpeed), *((uint8_t *)(&maxSpeed) + 1), *(uint8_t *)(&angleIncrement), *((uint8_t *)(&angleIncrement) + 1), *((uint8_t *)(&angleIncrement) + 2), *((uint8_t *)(&angleIncrement) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+#if MG6010E_USE_HEALTH
+    mg6010e_health_feedback(mg6010e_handle, rx_data, timestamp); // 最先检查，故障动作不受其他功能耗时影响
+#endif
+#if MG6010E_USE_REQUEST_TRACKING
+    mg6010e_request_complete(mg6010e_handle, rx_data, timestamp); // 无数据的回复（如0x80、0x81、0x88）同样完成请求
+#endif
+#if MG6010E_USE_TRAJECTORY
+    mg6010e_traj_feedback(mg6010e_handle, rx_data);
+#endif
+#if MG6010E_USE_PARAMS_SNAPSHOT
+    mg6010e_params_feedback(mg6010e_handle, rx_data);
+#endif
+#if MG6010E_USE_ENCODER_UNWRAP
+    mg6010e_unwrap_feedback(mg6010e_handle, rx_data[0], timestamp);
+#endif
+#if MG6010E_USE_RECORDER
+    mg6010e_recorder_feedback(mg6010e_handle, rx_data, timestamp);
+#endif
+#if MG6010E_USE_GROUP
+    mg6010e_group_feedback(mg6010e_handle, rx_data[0], timestamp);
+#endif
+#if MG6010E_USE_ADAPTIVE_POLL
+    mg6010e_adapt_feedback(mg6010e_handle, rx_data, timestamp);
+#endif
+    (void)mg6010e_handle;
+    (void)rx_data;
+    (void)timestamp;
 }
 
 /**
- * @brief 发送领控6010E电机控制参数读取命令
+ * @brief 解析一帧反馈并写入电机句柄
  *
- * @param motor_id 电机ID（1-32）
- * @param controlParamID 控制参数ID
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令读取当前电机的控制参数，读取的参数由序号 controlParamID 确定，见电机控制参数表
+ * @param bus 总线上下文
+ * @param index 电机ID-1
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
  */
-uint8_t mg6010e_read_control_param(uint8_t motor_id, uint8_t controlParamID)
+static void mg6010e_rx_decode(mg6010e_bus_t *bus, uint32_t index, const uint8_t *rx_data, uint32_t timestamp)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xC0, controlParamID, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    mg6010e_handle_t *mg6010e_handle = bus->handle_table[index];
+    if (mg6010e_handle == NULL)
+    {
+        return;
+    }
+    mg6010e_rx_decoder_t decoder = mg6010e_rx_decoder_table[rx_data[0]];
+    mg6010e_rx_account(bus, mg6010e_handle, decoder, rx_data, timestamp);
+    if (decoder != NULL)
+    {
+        uint32_t seq = mg6010e_seqlock_write_begin(mg6010e_handle);
+        decoder(mg6010e_handle, rx_data, timestamp);
+        mg6010e_seqlock_write_end(mg6010e_handle, seq);
+    }
+    mg6010e_rx_feedback(mg6010e_handle, rx_data, timestamp);
 }
 
+#if MG6010E_USE_DEFERRED_RX
 /**
- * @brief 发送领控6010E电机控制参数写入命令
+ * @brief 在接收中断中将一帧反馈放入总线的待解析队列
  *
- * @param motor_id 电机ID（1-32）
- * @param controlParamID 控制参数ID
- * @param paramData 控制参数数据指针，长度根据具体参数而定，最大6字节
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令写入控制参数到 RAM 中，即时生效，断电后失效。写入的参数和序号 controlParamID 见电机控制参数表
+ * @param bus 总线上下文
+ * @param index 电机ID-1
+ * @param rx_data 反馈数据
+ * @param timestamp 接收时间戳，单位us
+ * @param start 进入mg6010e_can_rx_frame时的周期计数
  */
-uint8_t mg6010e_write_control_param(uint8_t motor_id, uint8_t controlParamID, uint8_t *paramData)
+static inline void mg6010e_rx_defer(mg6010e_bus_t *bus, uint32_t index, const uint8_t *rx_data, uint32_t timestamp, uint32_t start)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0xC1, controlParamID, paramData[0], paramData[1], paramData[2], paramData[3], paramData[4], paramData[5]};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    uint32_t head = atomic_load_explicit(&bus->rx_head, memory_order_relaxed);
+    uint32_t depth = head - atomic_load_explicit(&bus->rx_tail, memory_order_acquire);
+    if (depth >= MG6010E_RX_RING_DEPTH)
+    {
+        bus->rx_overrun++;
+        return;
+    }
+    mg6010e_rx_entry_t *entry = &bus->rx_ring[head & MG6010E_RX_RING_MASK];
+    entry->timestamp = timestamp;
+    entry->index = (uint8_t)index;
+    memcpy(entry->data, rx_data, 8);
+    atomic_store_explicit(&bus->rx_head, head + 1, memory_order_release);
+    if (depth + 1 > bus->rx_high_water)
+    {
+        bus->rx_high_water = depth + 1;
+    }
+    uint32_t cycles = mg6010e_get_cycle_count() - start;
+    bus->rx_isr_last_cycles = cycles;
+    if (cycles > bus->rx_isr_max_cycles)
+    {
+        bus->rx_isr_max_cycles = cycles;
+    }
+    bus->rx_isr_count++;
 }
+#endif /* MG6010E_USE_DEFERRED_RX */
 
 /**
- * @brief 发送领控6010E电机读取编码器数据命令
- *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以读取编码器的当前位置。
+ * @brief 领控6010E电机CAN接收帧处理函数
+ * @param can_handle 接收到该报文的CAN句柄
+ * @param frame 接收到的标准数据帧
+ * @note 由传输层或用户的CAN接收回调对每一帧调用。
+ * 非本驱动的报文只经过一次无符号比较即返回，本驱动的报文按命令字节查表解析。
+ * 同一电机的反馈只能由一个中断上下文写入（单写者顺序锁）。
+ * MG6010E_USE_DEFERRED_RX为1时只为帧打时间戳并放入总线的待解析队列，由mg6010e_process_pending解析，
+ * 此时同一总线只能由一个中断调用本函数。
  */
-uint8_t mg6010e_read_encoder(uint8_t motor_id)
+void mg6010e_can_rx_frame(mg6010e_can_t *can_handle, const mg6010e_can_frame_t *frame)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
+    // ID小于基ID时减法回绕为大数，一次比较即可排除总线上的其他设备
+    uint32_t index = frame->std_id - (MG6010E_CAN_FEEDBACK_BASE_ID + 1);
+    if (index >= 32)
+    {
+        return;
+    }
+#if MG6010E_USE_DEFERRED_RX || MG6010E_USE_STATS
+    uint32_t start = mg6010e_get_cycle_count();
+#endif
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return;
+    }
+    uint32_t timestamp = mg6010e_get_timestamp_us();
+    mg6010e_rx_record(bus, frame, bus->handle_table[index] != NULL, timestamp);
+#if MG6010E_USE_DEFERRED_RX
+    if (bus->handle_table[index] != NULL)
+    {
+        mg6010e_rx_defer(bus, index, frame->data, timestamp, start);
+    }
+#else
+#if MG6010E_USE_BUS_BUDGET
+    atomic_fetch_add_explicit(&bus->measured_bits, MG6010E_CAN_FRAME_BITS_MAX(8), memory_order_relaxed);
+#endif
+    mg6010e_rx_decode(bus, index, frame->data, timestamp);
+#endif
+#if MG6010E_USE_STATS
+    uint32_t cycles = mg6010e_get_cycle_count() - start;
+    bus->stats.isr_count++;
+    bus->isr_cycles_total += cycles;
+    if (cycles > bus->stats.isr_max_cycles)
+    {
+        bus->stats.isr_max_cycles = cycles;
+    }
+#endif
+}
 
-    uint8_t cmd_data[8] = {0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+/**
+ * @brief 领控6010E电机CAN接收帧批量处理函数
+ * @param can_handle 接收到这些报文的CAN句柄
+ * @param frames 帧数组，如一次从接收FIFO取出的全部帧或DMA接收缓冲区
+ * @param count 帧数
+ * @return uint32_t 属于已初始化电机的帧数
+ * @note 总线查找、时间戳与负载统计每批只做一次，同一批帧使用相同的时间戳。
+ * 每MG6010E_RX_BURST_NUM帧为一组，第一遍对组内所有帧按状态2布局（0x9C、0xA1~0xA8，电机最常见的回复）解包温度、转矩电流、转速与编码器，
+ * 该循环不含分支，可由编译器向量化；第二遍逐帧分发，状态2布局的帧直接写入已解包的数据，其余帧按命令字节查表解析。
+ * 与mg6010e_can_rx_frame相同，同一总线的反馈只能由一个上下文写入。
+ */
+uint32_t mg6010e_can_rx_process_burst(mg6010e_can_t *can_handle, const mg6010e_can_frame_t *frames, uint32_t count)
+{
+    if (frames == NULL)
+    {
+        return 0;
+    }
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return 0;
+    }
+    uint32_t timestamp = mg6010e_get_timestamp_us();
+    uint32_t processed = 0;
+#if MG6010E_USE_BUS_BUDGET
+    uint32_t matched = 0;
+#endif
+    for (uint32_t base = 0; base < count; base += MG6010E_RX_BURST_NUM)
+    {
+        const mg6010e_can_frame_t *group = &frames[base];
+        uint32_t n = count - base < MG6010E_RX_BURST_NUM ? count - base : MG6010E_RX_BURST_NUM;
+        uint8_t temperature[MG6010E_RX_BURST_NUM];
+        int16_t iqActual[MG6010E_RX_BURST_NUM];
+        int16_t speed[MG6010E_RX_BURST_NUM];
+        uint16_t encoder[MG6010E_RX_BURST_NUM];
+        for (uint32_t i = 0; i < n; i++)
+        {
+            temperature[i] = group[i].data[1];
+            iqActual[i] = (int16_t)mg6010e_read_le16(&group[i].data[2]);
+            speed[i] = (int16_t)mg6010e_read_le16(&group[i].data[4]);
+            encoder[i] = mg6010e_read_le16(&group[i].data[6]);
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t index = group[i].std_id - (MG6010E_CAN_FEEDBACK_BASE_ID + 1);
+            if (index >= 32)
+            {
+                continue;
+            }
+#if MG6010E_USE_BUS_BUDGET
+            matched++;
+#endif
+            mg6010e_handle_t *mg6010e_handle = bus->handle_table[index];
+            mg6010e_rx_record(bus, &group[i], mg6010e_handle != NULL, timestamp);
+            if (mg6010e_handle == NULL)
+            {
+                continue;
+            }
+            const uint8_t *rx_data = group[i].data;
+            mg6010e_rx_decoder_t decoder = mg6010e_rx_decoder_table[rx_data[0]];
+            mg6010e_rx_account(bus, mg6010e_handle, decoder, rx_data, timestamp);
+            if (decoder != NULL)
+            {
+                uint32_t seq = mg6010e_seqlock_write_begin(mg6010e_handle);
+                if (decoder == mg6010e_decode_status_2)
+                {
+                    mg6010e_store_status_2(mg6010e_handle, temperature[i], iqActual[i], speed[i], encoder[i], timestamp);
+                }
+                else
+                {
+                    decoder(mg6010e_handle, rx_data, timestamp);
+                }
+                mg6010e_seqlock_write_end(mg6010e_handle, seq);
+            }
+            mg6010e_rx_feedback(mg6010e_handle, rx_data, timestamp);
+            processed++;
+        }
+    }
+#if MG6010E_USE_BUS_BUDGET
+    atomic_fetch_add_explicit(&bus->measured_bits, matched * MG6010E_CAN_FRAME_BITS_MAX(8), memory_order_relaxed);
+#endif
+    return processed;
 }
 
 /**
- * @brief 发送领控6010E电机写入编码器零点命令
+ * @brief 从传输层取出所有已接收的帧并批量处理
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 设置电机当前位置的编码器原始值作为电机上电后的初始零点
- * 1．该命令需要重新上电后才能生效
- * 2．该命令会将零点写入驱动的 ROM，多次写入将会影响芯片寿命，不建议频繁使用
+ * @param can_handle CAN句柄
+ * @return uint32_t 取出的帧数
+ * @note 适用于在主循环或任务中轮询接收，也可在接收FIFO中断中调用，一次中断即排空整个FIFO。
+ * 每次最多向传输层取MG6010E_RX_BURST_NUM帧交给mg6010e_can_rx_process_burst。传输层未提供recv时返回0。
  */
-uint8_t mg6010e_write_encoder_zero_point(uint8_t motor_id)
+uint32_t mg6010e_can_rx_poll(mg6010e_can_t *can_handle)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    if (mg6010e_transport == NULL || mg6010e_transport->recv == NULL)
+    {
+        return 0;
+    }
+    uint32_t total = 0;
+    mg6010e_can_frame_t frames[MG6010E_RX_BURST_NUM];
+    uint32_t count;
+    while ((count = mg6010e_transport->recv(can_handle, frames, MG6010E_RX_BURST_NUM)) > 0)
+    {
+        mg6010e_can_rx_process_burst(can_handle, frames, count);
+        total += count;
+    }
+    return total;
 }
 
+#if MG6010E_USE_DEFERRED_RX
 /**
- * @brief 发送领控6010E电机读取多圈角度命令
+ * @brief 解析接收中断放入队列的反馈帧
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以读取当前电机的多圈绝对角度值。
+ * @return uint32_t 解析的帧数
+ * @note 请在RTOS任务或主循环中周期性调用，且只能由一个上下文调用（它是电机句柄的唯一写者）。
+ * 反馈数据的时间戳为接收中断中记录的时间。两次调用之间某条总线到达的帧超过MG6010E_RX_RING_DEPTH时，多余的帧被丢弃并计入overrun。
  */
-uint8_t mg6010e_read_angle(uint8_t motor_id)
+uint32_t mg6010e_process_pending(void)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    uint32_t total = 0;
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
+    {
+        mg6010e_bus_t *bus = &mg6010e_bus_table[b];
+        if (bus->can_handle == NULL)
+        {
+            continue;
+        }
+        uint32_t tail = atomic_load_explicit(&bus->rx_tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&bus->rx_head, memory_order_acquire);
+        uint32_t count = head - tail;
+        for (; tail != head; tail++)
+        {
+            const mg6010e_rx_entry_t *entry = &bus->rx_ring[tail & MG6010E_RX_RING_MASK];
+            mg6010e_rx_decode(bus, entry->index, entry->data, entry->timestamp);
+            atomic_store_explicit(&bus->rx_tail, tail + 1, memory_order_release); // 解析完才释放槽位
+        }
+#if MG6010E_USE_BUS_BUDGET
+        atomic_fetch_add_explicit(&bus->measured_bits, count * MG6010E_CAN_FRAME_BITS_MAX(8), memory_order_relaxed);
+#endif
+        total += count;
+    }
+    return total;
 }
 
 /**
- * @brief 发送领控6010E电机读取单圈角度命令
+ * @brief 获取延迟解析模式下的接收统计
  *
- * @param motor_id 电机ID（1-32）
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以读取当前电机的单圈绝对角度值。
+ * @param can_handle CAN句柄
+ * @param stats 接收统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，2表示总线未注册
+ * @note 入队耗时从进入mg6010e_can_rx_frame起计，单位为mg6010e_get_cycle_count的计数
  */
-uint8_t mg6010e_read_single_angle(uint8_t motor_id)
+uint8_t mg6010e_get_rx_stats(mg6010e_can_t *can_handle, mg6010e_rx_stats_t *stats)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x94, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    stats->pending = atomic_load_explicit(&bus->rx_head, memory_order_relaxed) - atomic_load_explicit(&bus->rx_tail, memory_order_relaxed);
+    stats->high_water = bus->rx_high_water;
+    stats->overrun = bus->rx_overrun;
+    stats->isr_count = bus->rx_isr_count;
+    stats->isr_last_cycles = bus->rx_isr_last_cycles;
+    stats->isr_max_cycles = bus->rx_isr_max_cycles;
+    return MG6010E_SUCCESS;
 }
+#endif /* MG6010E_USE_DEFERRED_RX */
 
+#if MG6010E_USE_STATS
 /**
- * @brief 发送领控6010E电机设置当前位置为任意角度（多圈角度）
+ * @brief 获取总线收发统计
  *
- * @param motor_id 电机ID（1-32）
- * @param motorAngle 角度值，数据单位 0.01°/LSB。
- * @return uint8_t 错误码，0表示成功，4表示未初始化，5表示发送失败
- * @note 主机发送该命令以设置电机的当前位置作为任意角度（写入 RAM，电机下电后丢失数据）。
+ * @param can_handle CAN句柄
+ * @param stats 收发统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，2表示总线未注册
+ * @note 计数由发送与接收上下文写入，读取时不加锁，各字段可能来自略有不同的时刻
  */
-uint8_t mg6010e_set_angle(uint8_t motor_id, int32_t motorAngle)
+uint8_t mg6010e_get_bus_stats(mg6010e_can_t *can_handle, mg6010e_bus_stats_t *stats)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-
-    uint8_t cmd_data[8] = {0x95, 0x00, 0x00, 0x00, *(uint8_t *)(&motorAngle), *((uint8_t *)(&motorAngle) + 1), *((uint8_t *)(&motorAngle) + 2), *((uint8_t *)(&motorAngle) + 3)};
-    return mg6010e_send_cmd(mg6010e_handle, cmd_data);
+    mg6010e_bus_t *bus = mg6010e_get_bus(can_handle);
+    if (bus == NULL)
+    {
+        return MG6010E_ERROR_CAN_NULL_PTR;
+    }
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *stats = bus->stats;
+    stats->tx_dropped = atomic_load_explicit(&bus->tx_dropped, memory_order_relaxed);
+    stats->isr_avg_cycles = stats->isr_count == 0 ? 0 : (uint32_t)(bus->isr_cycles_total / stats->isr_count);
+    return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 获取领控6010E电机状态数据
+ * @brief 获取电机收发统计
  *
- * @param motor_id 电机ID（1-32）
- * @param status 电机状态数据指针
- * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @param motor_id 电机编号，见MG6010E_MOTOR
+ * @param stats 收发统计输出
+ * @return uint8_t 错误码，0表示成功，1表示stats为空，4表示未初始化
  */
-uint8_t mg6010e_get_motor_status(uint8_t motor_id, mg6010e_status_t *status)
+uint8_t mg6010e_get_motor_stats(uint8_t motor_id, mg6010e_motor_stats_t *stats)
 {
     mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-    if (mg6010e_handle == NULL)
+    if (mg6010e_handle == NULL || !mg6010e_handle->initialized)
     {
         return MG6010E_ERROR_NOT_INITIALIZED;
     }
-    memcpy(status, &mg6010e_handle->status, sizeof(mg6010e_status_t));
+    if (stats == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    *stats = mg6010e_motor_stats_table[mg6010e_handle - mg6010e_handle_pool];
     return MG6010E_SUCCESS;
 }
 
 /**
- * @brief 获取领控6010E电机编码器参数数据
+ * @brief 清零所有总线与电机的收发统计
  *
- * @param motor_id 电机ID（1-32）
- * @param encoder_data 电机编码器参数数据指针
- * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @note 与收发并发调用时，正在进行的计数可能不被清零
  */
-uint8_t mg6010e_get_motor_encoder_data(uint8_t motor_id, mg6010e_encoder_data_t *encoder_data)
+void mg6010e_reset_stats(void)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-    if (mg6010e_handle == NULL)
+    for (uint32_t b = 0; b < MG6010E_MAX_CAN_BUS; b++)
     {
-        return MG6010E_ERROR_NOT_INITIALIZED;
+        mg6010e_bus_table[b].stats = (mg6010e_bus_stats_t){0};
+        mg6010e_bus_table[b].isr_cycles_total = 0;
     }
-    memcpy(encoder_data, &mg6010e_handle->encoder_data, sizeof(mg6010e_encoder_data_t));
-    return MG6010E_SUCCESS;
+    memset(mg6010e_motor_stats_table, 0, sizeof(mg6010e_motor_stats_table));
 }
+#endif /* MG6010E_USE_STATS */
 
+#if MG6010E_USE_TRACE
 /**
- * @brief 获取领控6010E电机控制参数数据
+ * @brief 导出跟踪记录
  *
- * @param motor_id 电机ID（1-32）
- * @param control_params 电机控制参数数据指针
- * @return uint8_t 错误码，0表示成功，4表示未初始化
+ * @param buffer 输出缓冲区，大小为MG6010E_TRACE_DUMP_SIZE时可容纳全部记录
+ * @param size 缓冲区大小，单位字节
+ * @return uint32_t 写入的字节数，缓冲区小于文件头时返回0
+ * @note 按时间顺序导出最近的记录，缓冲区不足时舍弃较早的记录，格式见MG6010E_TRACE_MAGIC处的说明，
+ * 可将导出数据保存为文件后用tools/mg6010e_trace_decode.c解析为时间线。导出期间仍在记录时，最早的几条可能已被覆盖。
  */
-uint8_t mg6010e_get_motor_control_params(uint8_t motor_id, mg6010e_control_params_t *control_params)
+uint32_t mg6010e_trace_dump(uint8_t *buffer, uint32_t size)
 {
-    mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-    if (mg6010e_handle == NULL)
+    if (buffer == NULL || size < MG6010E_TRACE_HEADER_SIZE)
     {
-        return MG6010E_ERROR_NOT_INITIALIZED;
+        return 0;
     }
-    memcpy(control_params, &mg6010e_handle->control_params, sizeof(mg6010e_control_params_t));
-    return MG6010E_SUCCESS;
+    uint32_t total = atomic_load_explicit(&mg6010e_trace_pos, memory_order_acquire);
+    uint32_t count = total < MG6010E_TRACE_DEPTH ? total : MG6010E_TRACE_DEPTH;
+    if (count > (size - MG6010E_TRACE_HEADER_SIZE) / MG6010E_TRACE_ENTRY_SIZE)
+    {
+        count = (size - MG6010E_TRACE_HEADER_SIZE) / MG6010E_TRACE_ENTRY_SIZE;
+    }
+    mg6010e_put_le(buffer, (uint32_t)MG6010E_TRACE_MAGIC);
+    mg6010e_put_le(buffer + 4, (uint16_t)MG6010E_TRACE_VERSION);
+    mg6010e_put_le(buffer + 6, (uint16_t)MG6010E_TRACE_ENTRY_SIZE);
+    mg6010e_put_le(buffer + 8, count);
+    mg6010e_put_le(buffer + 12, total);
+    uint8_t *out = buffer + MG6010E_TRACE_HEADER_SIZE;
+    for (uint32_t pos = total - count; pos != total; pos++)
+    {
+        const mg6010e_trace_entry_t *entry = &mg6010e_trace_ring[pos & (MG6010E_TRACE_DEPTH - 1)];
+        mg6010e_put_le(out, entry->timestamp);
+        mg6010e_put_le(out + 4, entry->id);
+        out[6] = entry->opcode;
+        out[7] = entry->event;
+        out += MG6010E_TRACE_ENTRY_SIZE;
+    }
+    return MG6010E_TRACE_HEADER_SIZE + count * MG6010E_TRACE_ENTRY_SIZE;
+}
+
+/**
+ * @brief 清空跟踪记录
+ */
+void mg6010e_trace_clear(void)
+{
+    atomic_store_explicit(&mg6010e_trace_pos, 0, memory_order_release);
 }
+#endif /* MG6010E_USE_TRACE */
 
+#if MG6010E_USE_HAL
 /**
  * @brief 领控6010E电机CAN接收回调钩子函数
+ * @param can_handle 接收到该报文的CAN句柄
  * @param rx_header CAN接收报文头指针
  * @param rx_data CAN接收数据指针
  * @note 您需要自行处理CAN接收与数据，然后将接受到的数据传入本函数，请将该函数注册在CAN总线回调函数中。依赖HAL库。
  */
-void mg6010e_can_rx_callback_hook(CAN_RxHeaderTypeDef *rx_header, uint8_t *rx_data)
+void mg6010e_can_rx_callback_hook(CAN_HandleTypeDef *can_handle, CAN_RxHeaderTypeDef *rx_header, uint8_t *rx_data)
 {
-    if (rx_header->StdId > MG6010E_CAN_FEEDBACK_BASE_ID && rx_header->StdId <= MG6010E_CAN_FEEDBACK_BASE_ID + 32)
+    if (rx_header->IDE != CAN_ID_STD)
     {
-        uint8_t motor_id = MG6010E_CAN_GET_MOTOR_ID(rx_header->StdId);
-        mg6010e_handle_t *mg6010e_handle = mg6010e_get_handle_by_id(motor_id);
-        if (mg6010e_handle != NULL && mg6010e_handle->initialized)
+        return;
+    }
+    mg6010e_can_frame_t frame;
+    frame.std_id = rx_header->StdId;
+    frame.dlc = (uint8_t)rx_header->DLC;
+    memcpy(frame.data, rx_data, 8);
+    mg6010e_can_rx_frame(can_handle, &frame);
+}
+
+/**
+ * @brief HAL传输层：获取空闲发送邮箱数
+ */
+static uint32_t mg6010e_hal_tx_free(CAN_HandleTypeDef *can_handle)
+{
+    return HAL_CAN_GetTxMailboxesFreeLevel(can_handle);
+}
+
+/**
+ * @brief HAL传输层：将帧写入发送邮箱
+ */
+static uint32_t mg6010e_hal_send(CAN_HandleTypeDef *can_handle, const mg6010e_can_frame_t *frames, uint32_t count)
+{
+    CAN_TxHeaderTypeDef tx_header;
+    tx_header.ExtId = 0;
+    tx_header.IDE = CAN_ID_STD;
+    tx_header.RTR = CAN_RTR_DATA;
+    tx_header.TransmitGlobalTime = DISABLE;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        tx_header.StdId = frames[i].std_id;
+        tx_header.DLC = frames[i].dlc;
+        uint32_t tx_mailbox;
+        if (HAL_CAN_AddTxMessage(can_handle, &tx_header, (uint8_t *)frames[i].data, &tx_mailbox) != HAL_OK)
         {
-            // 处理接收到的数据
-            switch (rx_data[0])
-            {
-            case 0x9A: // 读取状态1反馈
-                mg6010e_handle->status.temperature = rx_data[1];
-                mg6010e_handle->status.voltage = (uint16_t)rx_data[2] | ((uint16_t)rx_data[3] << 8);
-                mg6010e_handle->status.current = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                mg6010e_handle->status.motorState = rx_data[6];
-                mg6010e_handle->status.errorState = rx_data[7];
-                break;
-            case 0x9C: // 读取状态2反馈
-            case 0xA1:
-            case 0xA2:
-            case 0xA3:
-            case 0xA4:
-            case 0xA5:
-            case 0xA6:
-            case 0xA7:
-            case 0xA8:
-                mg6010e_handle->status.temperature = rx_data[1];
-                mg6010e_handle->status.iqActual = (int16_t)(((uint16_t)rx_data[2]) | ((uint16_t)rx_data[3] << 8));
-                mg6010e_handle->status.speed = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                mg6010e_handle->status.encoder = (uint16_t)rx_data[6] | ((uint16_t)rx_data[7] << 8);
-                break;
-            case 0x9D: // 读取状态3反馈
-                mg6010e_handle->status.temperature = rx_data[1];
-                mg6010e_handle->status.iA = (int16_t)(((uint16_t)rx_data[2]) | ((uint16_t)rx_data[3] << 8));
-                mg6010e_handle->status.iB = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                mg6010e_handle->status.iC = (int16_t)(((uint16_t)rx_data[6]) | ((uint16_t)rx_data[7] << 8));
-                break;
-            case 0x8C: // 抱闸器状态反馈
-                mg6010e_handle->status.brakeStatus = rx_data[1];
-                break;
-            case 0xC0: // 读取控制参数反馈
-            case 0xC1:
-                switch (rx_data[1])
-                {
-                case 0x0A: // 角度环PID参数
-                    mg6010e_handle->control_params.anglekp = (int16_t)(((uint16_t)rx_data[2]) | ((uint16_t)rx_data[3] << 8));
-                    mg6010e_handle->control_params.angleki = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                    mg6010e_handle->control_params.anglekd = (int16_t)(((uint16_t)rx_data[6]) | ((uint16_t)rx_data[7] << 8));
-                    break;
-                case 0x0B: // 速度环PID参数
-                    mg6010e_handle->control_params.speedkp = (int16_t)(((uint16_t)rx_data[2]) | ((uint16_t)rx_data[3] << 8));
-                    mg6010e_handle->control_params.speedki = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                    mg6010e_handle->control_params.speedkd = (int16_t)(((uint16_t)rx_data[6]) | ((uint16_t)rx_data[7] << 8));
-                    break;
-                case 0x0C: // 电流环PID参数
-                    mg6010e_handle->control_params.currentkp = (int16_t)(((uint16_t)rx_data[2]) | ((uint16_t)rx_data[3] << 8));
-                    mg6010e_handle->control_params.currentki = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                    mg6010e_handle->control_params.currentkd = (int16_t)(((uint16_t)rx_data[6]) | ((uint16_t)rx_data[7] << 8));
-                    break;
-                case 0x1E: // 转矩电流限制参数
-                    mg6010e_handle->control_params.inputTorqueLimit = (int16_t)(((uint16_t)rx_data[4]) | ((uint16_t)rx_data[5] << 8));
-                    break;
-                case 0x20: // 最大速度参数
-                    mg6010e_handle->control_params.inputSpeedLimit = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                    break;
-                case 0x22: // 角度限制参数
-                    mg6010e_handle->control_params.inputAngleLimit = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                    break;
-                case 0x24: // 电流斜率参数
-                    mg6010e_handle->control_params.inputCurrentRamp = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                    break;
-                case 0x26: // 速度斜率参数
-                    mg6010e_handle->control_params.inputSpeedRamp = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                    break;
-                default:
-                    break;
-                }
-                break;
-            case 0x90: // 读取编码器反馈
-                mg6010e_handle->encoder_data.encoder = (uint16_t)rx_data[2] | ((uint16_t)rx_data[3] << 8);
-                mg6010e_handle->encoder_data.encoderRaw = (uint16_t)rx_data[4] | ((uint16_t)rx_data[5] << 8);
-                mg6010e_handle->encoder_data.encoderOffset = (uint16_t)rx_data[6] | ((uint16_t)rx_data[7] << 8);
-                break;
-            case 0x19:
-                mg6010e_handle->encoder_data.encoderOffset = (uint16_t)rx_data[6] | ((uint16_t)rx_data[7] << 8);
-                break;
-            case 0x92: // 读取多圈角度反馈
-                mg6010e_handle->status.angle = (int64_t)(((uint64_t)rx_data[1]) | ((uint64_t)rx_data[2] << 8) | ((uint64_t)rx_data[3] << 16) | ((uint64_t)rx_data[4] << 24) | ((uint64_t)rx_data[5] << 32) | ((uint64_t)rx_data[6] << 40) | ((uint64_t)rx_data[7] << 48));
-                break;
-            case 0x94: // 读取单圈角度反馈
-                mg6010e_handle->status.single_angle = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                break;
-            case 0x95: // 设置当前位置反馈
-                mg6010e_handle->status.angle = (int32_t)(((uint32_t)rx_data[4]) | ((uint32_t)rx_data[5] << 8) | ((uint32_t)rx_data[6] << 16) | ((uint32_t)rx_data[7] << 24));
-                break;
-            default:
-                break;
-            }
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief HAL传输层：从接收FIFO（MG6010E_HAL_RX_FIFO）取出标准数据帧
+ */
+static uint32_t mg6010e_hal_recv(CAN_HandleTypeDef *can_handle, mg6010e_can_frame_t *frames, uint32_t count)
+{
+    uint32_t received = 0;
+    while (received < count && HAL_CAN_GetRxFifoFillLevel(can_handle, MG6010E_HAL_RX_FIFO) > 0)
+    {
+        CAN_RxHeaderTypeDef rx_header;
+        if (HAL_CAN_GetRxMessage(can_handle, MG6010E_HAL_RX_FIFO, &rx_header, frames[received].data) != HAL_OK)
+        {
+            break;
+        }
+        if (rx_header.IDE == CAN_ID_STD && rx_header.RTR == CAN_RTR_DATA)
+        {
+            frames[received].std_id = rx_header.StdId;
+            frames[received].dlc = (uint8_t)rx_header.DLC;
+            received++;
         }
     }
-}
\ No newline at end of file
+    return received;
+}
+
+/**
+ * @brief HAL传输层：由HAL_GetTick换算的时间戳，精度为1ms
+ */
+static uint32_t mg6010e_hal_timestamp_us(void)
+{
+    return HAL_GetTick() * 1000U;
+}
+
+// STM32 HAL库传输层
+const mg6010e_transport_t mg6010e_hal_transport = {
+    .tx_free = mg6010e_hal_tx_free,
+    .send = mg6010e_hal_send,
+    .recv = mg6010e_hal_recv,
+    .timestamp_us = mg6010e_hal_timestamp_us,
+};
+#endif /* MG6010E_USE_HAL */
\ No newline at end of file
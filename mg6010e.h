@@ -3,8 +3,20 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
+#include <stdatomic.h>
+
+#ifndef MG6010E_USE_HAL
+#define MG6010E_USE_HAL 1 // 为1时使用STM32 HAL库作为默认传输层；为0时不依赖HAL库，需通过mg6010e_set_transport提供传输层
+#endif
+
+#if MG6010E_USE_HAL
 #include <stm32f4xx_hal.h> // 依赖HAL库，请根据实际情况修改为对应的HAL库头文件路径
+typedef CAN_HandleTypeDef mg6010e_can_t; // CAN总线句柄
+#else
+typedef void mg6010e_can_t; // CAN总线句柄，由传输层解释（如mg6010e_socketcan_t）
+#endif
 
 #define MG6010E_SUCCESS 0
 #define MG6010E_ERROR_CONFIG_NULL_PTR 1
@@ -12,18 +24,294 @@
 #define MG6010E_ERROR_INVALID_ID 3
 #define MG6010E_ERROR_NOT_INITIALIZED 4
 #define MG6010E_ERROR_SEND_FAILED 5
+#define MG6010E_ERROR_QUEUE_FULL 6
+#define MG6010E_ERROR_NO_RESOURCE 7
+#define MG6010E_ERROR_BUSY 8
+#define MG6010E_ERROR_TIMEOUT 9
+#define MG6010E_ERROR_VERIFY_FAILED 10
+#define MG6010E_ERROR_FAULT 11 // 电机处于健康监测的故障锁存状态，控制命令被拒绝，见mg6010e_clear_health_fault
+#define MG6010E_ERROR_INVALID_PARAM 12 // 参数值超出取值范围（长度、数量、枚举值等）
 #define MG6010E_CAN_CMD_BASE_ID 0x140
 #define MG6010E_CAN_CMD_ID(motor_id) (MG6010E_CAN_CMD_BASE_ID + motor_id)
 #define MG6010E_CAN_FEEDBACK_BASE_ID 0x140 // 手册中是0x180，但实际测试为0x140
 #define MG6010E_CAN_FEEDBACK_ID(motor_id) (MG6010E_CAN_FEEDBACK_BASE_ID + motor_id)
 #define MG6010E_CAN_GET_MOTOR_ID(feedback_id) ((feedback_id) - MG6010E_CAN_FEEDBACK_BASE_ID)
+#define MG6010E_CAN_MULTI_IQ_ID 0x280      // 多电机转矩电流控制广播ID
+#define MG6010E_CAN_MULTI_IQ_MOTOR_NUM 4   // 广播帧可控制的电机数量（ID 1~4）
+#define MG6010E_CAN_FRAME_BITS_MAX(dlc) (47 + 8 * (dlc) + (33 + 8 * (dlc)) / 4) // 标准数据帧最坏情况下占用的位数（含位填充与3位帧间隔），8字节为135位
+
+// 电机编号：不同CAN总线上的电机ID可以相同，驱动接口使用由总线编号与电机ID组合成的编号寻址。
+// 第0条总线上电机编号即为电机ID，与单总线用法兼容。
+#define MG6010E_MOTOR(bus, id) ((uint8_t)((bus) * 32 + (id)))  // bus：总线编号（见mg6010e_get_bus_index），id：电机ID（1-32）
+#define MG6010E_MOTOR_BUS(motor) (((motor) - 1) / 32)          // 从电机编号取得总线编号
+#define MG6010E_MOTOR_CAN_ID(motor) ((((motor) - 1) % 32) + 1) // 从电机编号取得电机ID
+
+#ifndef MG6010E_USE_SOA_TELEMETRY
+#define MG6010E_USE_SOA_TELEMETRY 0 // 为1时额外按电机ID连续存放速度、转矩电流、编码器、角度和温度，并提供批量读取接口
+#endif
+#ifndef MG6010E_USE_POLL_SCHEDULER
+#define MG6010E_USE_POLL_SCHEDULER 0 // 为1时启用自动轮询调度器，按注册的频率周期性发送读取命令
+#endif
+#ifndef MG6010E_POLL_TICK_HZ
+#define MG6010E_POLL_TICK_HZ 1000 // mg6010e_poll_tick的调用频率，单位Hz
+#endif
+#ifndef MG6010E_POLL_WINDOW
+#define MG6010E_POLL_WINDOW 100 // 用于交错安排读取请求的负载窗口长度，单位tick
+#endif
+#ifndef MG6010E_USE_ADAPTIVE_POLL
+#define MG6010E_USE_ADAPTIVE_POLL 0 // 为1时按电机的转速、转矩电流变化与错误状态在总线预算内自动调整状态1、状态2与多圈角度的轮询频率，需要MG6010E_USE_POLL_SCHEDULER
+#endif
+#ifndef MG6010E_ADAPT_SPEED_FULL
+#define MG6010E_ADAPT_SPEED_FULL 360 // 转速达到该值（dps）时状态2与多圈角度按最高频率轮询
+#endif
+#ifndef MG6010E_ADAPT_IQ_SLEW_FULL
+#define MG6010E_ADAPT_IQ_SLEW_FULL 20000 // 转矩电流变化率达到该值（LSB/s）时状态2按最高频率轮询
+#endif
+#ifndef MG6010E_ADAPT_IQ_LOAD_FULL
+#define MG6010E_ADAPT_IQ_LOAD_FULL 1024 // 转矩电流绝对值达到该值（LSB）时状态1按最高频率轮询，errorState非0时状态1始终按最高频率轮询
+#endif
+#ifndef MG6010E_POLL_BUDGET_PERCENT
+#define MG6010E_POLL_BUDGET_PERCENT 20 // 默认每条总线用于轮询（读取命令与回复）的带宽占比，单位%
+#endif
+#ifndef MG6010E_USE_REQUEST_TRACKING
+#define MG6010E_USE_REQUEST_TRACKING 0 // 为1时跟踪每条命令的回复，统计往返延迟并检测超时
+#endif
+#ifndef MG6010E_REQUEST_PENDING_NUM
+#define MG6010E_REQUEST_PENDING_NUM 4 // 每个电机同时等待回复的请求数量
+#endif
+#ifndef MG6010E_REQUEST_TIMEOUT_US
+#define MG6010E_REQUEST_TIMEOUT_US 10000 // 默认请求超时时间，单位us
+#endif
+#define MG6010E_LATENCY_BUCKET_NUM 40 // 往返延迟直方图桶数，覆盖0~1s
+#ifndef MG6010E_USE_BUS_BUDGET
+#define MG6010E_USE_BUS_BUDGET 0 // 为1时按每周期的总线时间预算准入或推迟发送，并统计总线利用率
+#endif
+#ifndef MG6010E_CAN_BITRATE
+#define MG6010E_CAN_BITRATE 1000000 // CAN总线波特率，单位bit/s，用于计算总线利用率
+#endif
+#ifndef MG6010E_USE_DEFERRED_RX
+#define MG6010E_USE_DEFERRED_RX 0 // 为1时接收中断只为帧打时间戳并放入队列，由mg6010e_process_pending在任务中解析
+#endif
+#ifndef MG6010E_RX_RING_DEPTH
+#define MG6010E_RX_RING_DEPTH 32 // 每条CAN总线待解析帧队列的深度，必须为2的幂
+#endif
+#ifndef MG6010E_USE_STATS
+#define MG6010E_USE_STATS 0 // 为1时统计每个电机与每条总线的收发帧数、错误与接收中断耗时
+#endif
+#ifndef MG6010E_USE_TRACE
+#define MG6010E_USE_TRACE 0 // 为1时将每帧收发事件（时间戳、ID、命令字节）记录到环形缓冲区，可导出后在上位机解析
+#endif
+#ifndef MG6010E_TRACE_DEPTH
+#define MG6010E_TRACE_DEPTH 256 // 跟踪环形缓冲区的记录数，必须为2的幂
+#endif
+#ifndef MG6010E_USE_RECORDER
+#define MG6010E_USE_RECORDER 0 // 为1时将每帧解析后的反馈以增量编码记录到每条总线的环形缓冲区，由后台任务导出到文件或串口
+#endif
+#ifndef MG6010E_RECORDER_SIZE
+#define MG6010E_RECORDER_SIZE 2048 // 每条总线记录缓冲区的字节数，必须为2的幂
+#endif
+#ifndef MG6010E_USE_TRAJECTORY
+#define MG6010E_USE_TRAJECTORY 0 // 为1时启用轨迹流式发送，按固定频率对路点插值并发送角度或速度设定值
+#endif
+#ifndef MG6010E_TRAJ_TICK_HZ
+#define MG6010E_TRAJ_TICK_HZ 1000 // mg6010e_traj_tick的调用频率，单位Hz
+#endif
+#ifndef MG6010E_TRAJ_POINT_NUM
+#define MG6010E_TRAJ_POINT_NUM 16 // 每个电机轨迹的最大路点数
+#endif
+#ifndef MG6010E_USE_PARAMS_SNAPSHOT
+#define MG6010E_USE_PARAMS_SNAPSHOT 0 // 为1时提供所有电机控制参数的流水线批量读取（快照）与写回校验（恢复）
+#endif
+#ifndef MG6010E_PARAMS_WINDOW
+#define MG6010E_PARAMS_WINDOW 8 // 快照与恢复时每条总线同时等待回复的请求数上限，不应超过MG6010E_TX_QUEUE_DEPTH
+#endif
+#ifndef MG6010E_PARAMS_TIMEOUT_US
+#define MG6010E_PARAMS_TIMEOUT_US 20000 // 快照与恢复时单个请求的超时时间，单位us
+#endif
+#ifndef MG6010E_PARAMS_RETRY
+#define MG6010E_PARAMS_RETRY 2 // 快照与恢复时单个请求超时后的重发次数
+#endif
+#ifndef MG6010E_USE_ENCODER_UNWRAP
+#define MG6010E_USE_ENCODER_UNWRAP 0 // 为1时在接收路径中将编码器值累计为连续的多圈位置与速度估计，并以0x92/0x95回复的多圈角度校准
+#endif
+#ifndef MG6010E_ENCODER_BITS
+#define MG6010E_ENCODER_BITS 16 // 编码器位数（14、15或16）
+#endif
+#ifndef MG6010E_ENCODER_TURN_ANGLE
+#define MG6010E_ENCODER_TURN_ANGLE 36000 // 编码器转过一圈时多圈角度的变化量，单位0.01°
+#endif
+#ifndef MG6010E_UNWRAP_VELOCITY_SHIFT
+#define MG6010E_UNWRAP_VELOCITY_SHIFT 2 // 速度估计的滑动平均系数为1/2^n，越大越平滑、滞后越多
+#endif
+#ifndef MG6010E_UNWRAP_RETRY
+#define MG6010E_UNWRAP_RETRY 8 // mg6010e_get_position与接收中断冲突的最大重试次数，用尽后返回MG6010E_ERROR_BUSY
+#endif
+#ifndef MG6010E_USE_HEALTH
+#define MG6010E_USE_HEALTH 0 // 为1时在接收路径中监测每个电机的回复间隔、温度、电压与错误标志，异常时执行配置的安全停止动作
+#endif
+#ifndef MG6010E_HEALTH_SLICE_US
+#define MG6010E_HEALTH_SLICE_US 5000 // 回复超时检测的时间片长度，单位us，每条总线按时间片记录有回复的电机位图
+#endif
+#ifndef MG6010E_HEALTH_SLICE_NUM
+#define MG6010E_HEALTH_SLICE_NUM 8 // 保留的时间片数，必须为2的幂；超时时间超过MG6010E_HEALTH_SLICE_US × MG6010E_HEALTH_SLICE_NUM的电机每次检查都按回复时间逐个判断
+#endif
+#ifndef MG6010E_USE_GROUP
+#define MG6010E_USE_GROUP 0 // 为1时启用命令组，在mg6010e_group_begin与mg6010e_group_commit之间暂存各电机的控制命令，提交时按ID顺序连续发出
+#endif
+#ifndef MG6010E_USE_COALESCE
+#define MG6010E_USE_COALESCE 0 // 为1时控制命令先写入每个电机的待发槽位（后写覆盖先写），由mg6010e_coalesce_flush每周期统一发出
+#endif
+#ifndef MG6010E_COALESCE_RETRY
+#define MG6010E_COALESCE_RETRY 4 // 取走待发命令时与写入冲突的最大重试次数，用尽后命令留在槽位中由下一周期发出
+#endif
+#ifndef MG6010E_MAX_MOTOR_NUM
+#define MG6010E_MAX_MOTOR_NUM 32 // 句柄静态池大小，即所有总线上最多同时初始化的电机数量
+#endif
+#ifndef MG6010E_MAX_CAN_BUS
+#define MG6010E_MAX_CAN_BUS 2 // 最多支持的CAN总线数量（1-7）
+#endif
+#ifndef MG6010E_SNAPSHOT_RETRY
+#define MG6010E_SNAPSHOT_RETRY 8 // 读取状态快照时与接收中断冲突的最大重试次数
+#endif
+#ifndef MG6010E_CAN_BATCH_NUM
+#define MG6010E_CAN_BATCH_NUM 4 // 每次调用传输层发送/接收的最大帧数
+#endif
+#ifndef MG6010E_RX_BURST_NUM
+#define MG6010E_RX_BURST_NUM 16 // mg6010e_can_rx_poll每次从传输层取出的最大帧数，也是批量解析一次解包的帧数
+#endif
+#ifndef MG6010E_HAL_RX_FIFO
+#define MG6010E_HAL_RX_FIFO CAN_RX_FIFO0 // HAL传输层接收使用的FIFO
+#endif
+#ifndef MG6010E_TX_QUEUE_DEPTH
+#define MG6010E_TX_QUEUE_DEPTH 16 // 每条CAN总线的发送队列深度，必须为2的幂
+#endif
+
+// 命令类别，不同类别在发送队列满时采用不同的丢弃策略
+#define MG6010E_CMD_CLASS_SETPOINT 0 // 控制类命令（0xA1~0xA8）
+#define MG6010E_CMD_CLASS_READ 1     // 读取类命令
+#define MG6010E_CMD_CLASS_CONFIG 2   // 配置类命令（写参数、开关电机、抱闸等）
+#define MG6010E_CMD_CLASS_NUM 3
+
+// 发送队列丢弃策略
+#define MG6010E_TX_POLICY_DROP_OLDEST 0 // 队列满时丢弃最早入队的命令
+#define MG6010E_TX_POLICY_NEVER_DROP 1  // 入队后永不丢弃，队列满时返回MG6010E_ERROR_QUEUE_FULL
+
+// 自动轮询项
+#define MG6010E_POLL_STATUS_1 0     // 读取状态1（0x9A）
+#define MG6010E_POLL_STATUS_2 1     // 读取状态2（0x9C），控制命令的反馈已包含该数据
+#define MG6010E_POLL_STATUS_3 2     // 读取状态3（0x9D）
+#define MG6010E_POLL_ANGLE 3        // 读取多圈角度（0x92）
+#define MG6010E_POLL_SINGLE_ANGLE 4 // 读取单圈角度（0x94）
+#define MG6010E_POLL_ENCODER 5      // 读取编码器（0x90）
+#define MG6010E_POLL_BRAKE 6        // 读取抱闸器状态（0x8C）
+#define MG6010E_POLL_ITEM_NUM 7
+
+// 自适应轮询的当前状态，数组按轮询项MG6010E_POLL_*索引
+typedef struct mg6010e_poll_rates
+{
+    uint16_t rate_hz[MG6010E_POLL_ITEM_NUM];   // 实际轮询频率（MG6010E_POLL_TICK_HZ / 周期），0表示不轮询
+    uint16_t demand_hz[MG6010E_POLL_ITEM_NUM]; // 自适应项按电机动态计算的期望频率，尚未按预算缩减
+    uint16_t activity[MG6010E_POLL_ITEM_NUM];  // 自适应项最近一次调整时的活动度，单位0.1%，0对应最低频率，1000对应最高频率
+    uint8_t adaptive;                          // 自适应轮询项的位图，bit n对应轮询项n
+} mg6010e_poll_rates_t;
+
+// 总线的轮询预算，频率均为每秒读取次数，每次读取按命令与回复两帧的最坏情况占用计算
+typedef struct mg6010e_poll_budget
+{
+    uint32_t budget_hz;  // 预算允许的读取频率
+    uint32_t fixed_hz;   // 固定频率轮询项（mg6010e_poll_register）占用的频率
+    uint32_t minimum_hz; // 自适应项最低频率之和
+    uint32_t demand_hz;  // 自适应项期望频率之和
+    uint32_t granted_hz; // 自适应项实际频率之和
+    uint16_t scale;      // 期望频率中高于最低频率的部分实际得到的比例，单位0.1%
+    uint32_t changes;    // 累计调整轮询周期的次数
+} mg6010e_poll_budget_t;
+
+// 轨迹插值方式
+#define MG6010E_TRAJ_ANGLE_LINEAR 0 // 多圈角度，路点间线性插值，以0xA4发送
+#define MG6010E_TRAJ_ANGLE_CUBIC 1  // 多圈角度，路点间按路点速度做三次Hermite插值，以0xA4发送
+#define MG6010E_TRAJ_SPEED_LINEAR 2 // 速度，路点间线性插值，以0xA2发送
+
+// 轨迹状态
+#define MG6010E_TRAJ_IDLE 0    // 无轨迹
+#define MG6010E_TRAJ_LOADED 1  // 已加载，等待mg6010e_traj_start
+#define MG6010E_TRAJ_RUNNING 2 // 正在发送设定值
+#define MG6010E_TRAJ_DONE 3    // 已发送最后一个路点
+
+// 健康监测故障，按位或
+#define MG6010E_HEALTH_STALE 0x01        // 超过timeout_us未收到任何回复
+#define MG6010E_HEALTH_OVERTEMP 0x02     // 温度高于max_temperature（0x9A、0x9B、0x9C、0x9D、0xA1~0xA8回复）
+#define MG6010E_HEALTH_UNDERVOLTAGE 0x04 // 母线电压低于min_voltage（0x9A、0x9B回复）
+#define MG6010E_HEALTH_ERROR_STATE 0x08  // errorState中有error_mask中的位（0x9A、0x9B回复）
+
+// 健康监测故障时的动作
+#define MG6010E_HEALTH_REACT_NONE 0    // 只锁存故障并调用回调
+#define MG6010E_HEALTH_REACT_STOP 1    // 发送电机停止命令（0x81，同mg6010e_stop）
+#define MG6010E_HEALTH_REACT_DISABLE 2 // 发送电机关闭命令（0x80，同mg6010e_disable）
+#define MG6010E_HEALTH_REACT_BRAKE 3   // 发送电机停止命令，并使抱闸器断电刹车（0x81、0x8C，同mg6010e_break_control(motor_id, 0)）
 
-// 领控6010E电机配置结构体，依赖HAL库
+// 跟踪事件类型
+#define MG6010E_TRACE_TX 0              // 帧已交给传输层
+#define MG6010E_TRACE_TX_FAIL 1         // 传输层未能发送（如HAL_CAN_AddTxMessage失败）
+#define MG6010E_TRACE_RX 2              // 收到已初始化电机的反馈
+#define MG6010E_TRACE_RX_UNREGISTERED 3 // 收到未初始化电机ID的反馈
+#define MG6010E_TRACE_RX_UNKNOWN 4      // 反馈的命令字节未知（解析时记录）
+
+// 跟踪导出格式（小端）：16字节文件头（魔数"M6TR"、uint16版本、uint16记录长度、uint32记录数、uint32累计记录数），
+// 之后按时间顺序排列的记录，每条为uint32时间戳（us）、uint16 ID（bit11~13为总线编号，bit0~10为标准帧ID）、uint8命令字节、uint8事件类型
+#define MG6010E_TRACE_MAGIC 0x5254364DU // "M6TR"
+#define MG6010E_TRACE_VERSION 1
+#define MG6010E_TRACE_HEADER_SIZE 16
+#define MG6010E_TRACE_ENTRY_SIZE 8
+#define MG6010E_TRACE_DUMP_SIZE (MG6010E_TRACE_HEADER_SIZE + MG6010E_TRACE_ENTRY_SIZE * MG6010E_TRACE_DEPTH) // 导出全部记录所需的缓冲区大小
+
+// 遥测记录格式（小端）：导出数据以8字节文件头开始（魔数"M6RC"、uint16版本、uint16保留），之后为连续的记录，由第一个字节区分：
+// 反馈记录：uint8变化掩码（bit7为0，bit0~6表示反馈数据1~7中与该电机同类反馈的上一条记录不同的字节）、uint8电机编号（见MG6010E_MOTOR）、
+// uint8命令字节、与同一总线上一条记录的时间差（us，LEB128变长编码）、按顺序排列的变化字节；
+// 同步记录：uint8 MG6010E_RECORDER_SYNC、uint8总线编号、uint32时间戳（us）、uint32该总线累计丢弃的记录数，此后该总线所有电机的参考值为0，时间差以此为基准。
+// 开始记录或丢弃记录后，该总线的下一条记录前会先写入同步记录。同类反馈见MG6010E_RECORDER_CLASS，数据布局相同的命令字节共用参考值。
+#define MG6010E_RECORDER_MAGIC 0x4352364DU // "M6RC"
+#define MG6010E_RECORDER_VERSION 1
+#define MG6010E_RECORDER_HEADER_SIZE 8
+#define MG6010E_RECORDER_SYNC 0x80
+#define MG6010E_RECORDER_SYNC_SIZE 10
+#define MG6010E_RECORDER_RECORD_MAX 15 // 反馈记录的最大字节数：掩码、电机编号、命令字节，最长5字节的时间差与7个变化字节
+#define MG6010E_RECORDER_CLASS_NUM 5
+#define MG6010E_RECORDER_CLASS(opcode) \
+    ((opcode) == 0x9A || (opcode) == 0x9B ? 0 : (opcode) == 0x9C || ((opcode) >= 0xA1 && (opcode) <= 0xA8) ? 1 : (opcode) == 0x9D ? 2 : (opcode) == 0x90 ? 3 : 4)
+
+// 控制参数快照格式（小端）：8字节文件头（魔数"M6PA"、uint8版本、uint8电机数、uint16 CRC-16/CCITT-FALSE，覆盖全部电机记录），
+// 之后每个电机一条记录：uint8电机编号（见MG6010E_MOTOR），以及按0x0A、0x0B、0x0C、0x1E、0x20、0x22、0x24、0x26排列的8个参数各6字节（即0xC0回复的数据2~7）
+#define MG6010E_PARAMS_NUM 8
+#define MG6010E_PARAMS_MAGIC 0x4150364DU // "M6PA"
+#define MG6010E_PARAMS_VERSION 1
+#define MG6010E_PARAMS_HEADER_SIZE 8
+#define MG6010E_PARAMS_RECORD_SIZE (1 + MG6010E_PARAMS_NUM * 6)
+#define MG6010E_PARAMS_BLOB_SIZE(motor_num) (MG6010E_PARAMS_HEADER_SIZE + MG6010E_PARAMS_RECORD_SIZE * (motor_num)) // 保存motor_num个电机的快照所需的字节数
+
+// CAN标准数据帧
+typedef struct mg6010e_can_frame
+{
+    uint32_t std_id; // 标准帧ID
+    uint8_t dlc;     // 数据长度
+    uint8_t data[8]; // 数据
+} mg6010e_can_frame_t;
+
+// CAN传输层，驱动通过它收发帧，不直接调用HAL库
+typedef struct mg6010e_transport
+{
+    uint32_t (*tx_free)(mg6010e_can_t *can);                                             // 返回当前可立即发送的帧数（如空闲邮箱数）
+    uint32_t (*send)(mg6010e_can_t *can, const mg6010e_can_frame_t *frames, uint32_t count); // 发送帧，返回成功交给硬件的帧数
+    uint32_t (*recv)(mg6010e_can_t *can, mg6010e_can_frame_t *frames, uint32_t count);       // 取出已接收的标准数据帧，返回帧数，可为NULL
+    uint32_t (*timestamp_us)(void);                                                        // 单调时间戳，单位us
+} mg6010e_transport_t;
+
+// 领控6010E电机配置结构体
 typedef struct mg6010e_config
 {
-    CAN_HandleTypeDef *can_handle; // CAN句柄
-    uint32_t can_tx_mailbox;       // CAN发送邮箱
-    uint32_t motor_id;             // 电机ID(1-32)
+    mg6010e_can_t *can_handle; // CAN句柄
+    uint32_t can_tx_mailbox;   // CAN发送邮箱
+    uint32_t motor_id;         // 电机ID(1-32)，不同总线上的电机ID可以相同
 } mg6010e_config_t;
 
 // 领控6010E电机状态结构体
@@ -45,6 +333,204 @@ typedef struct mg6010e_status
     uint32_t single_angle; // 电机单圈角度，单位：0.01°/LSB
 } mg6010e_status_t;
 
+// 领控6010E电机状态各字段最近一次更新的时间戳，单位us，0表示从未更新
+typedef struct mg6010e_status_time
+{
+    uint32_t temperature;
+    uint32_t voltage;
+    uint32_t current;
+    uint32_t motorState;
+    uint32_t errorState;
+    uint32_t iqActual;
+    uint32_t speed;
+    uint32_t encoder;
+    uint32_t iA;
+    uint32_t iB;
+    uint32_t iC;
+    uint32_t brakeStatus;
+    uint32_t angle;
+    uint32_t single_angle;
+} mg6010e_status_time_t;
+
+// 领控6010E电机请求往返延迟统计
+typedef struct mg6010e_latency_stats
+{
+    uint32_t count;                                  // 收到回复的请求数
+    uint32_t timeouts;                               // 超时的请求数
+    uint32_t untracked;                              // 因等待中的请求已满而未跟踪的请求数
+    uint32_t min_us;                                 // 最小往返延迟，单位us
+    uint32_t max_us;                                 // 最大往返延迟，单位us
+    uint32_t histogram[MG6010E_LATENCY_BUCKET_NUM]; // 往返延迟直方图，见mg6010e_latency_percentile
+} mg6010e_latency_stats_t;
+
+// 请求完成回调，result为0表示收到回复，9表示超时；latency_us为往返延迟或已等待的时间
+typedef void (*mg6010e_request_callback_t)(uint8_t motor_id, uint8_t cmd, uint8_t param_id, uint8_t result, uint32_t latency_us);
+
+// CAN总线负载统计，位数均按最坏情况（MG6010E_CAN_FRAME_BITS_MAX）计算
+typedef struct mg6010e_bus_load
+{
+    uint32_t capacity_bits; // 每周期总线容量
+    uint32_t budget_bits;   // 每周期预算，0表示不限制
+    uint32_t reserved_bits; // 上一周期准入的帧及其预期回复占用的位数
+    uint32_t measured_bits; // 上一周期实际发送与接收的帧占用的位数
+    uint32_t peak_bits;     // measured_bits的历史最大值
+    uint32_t deferred;      // 因预算不足推迟到下一周期发送的累计帧数
+    uint16_t utilization;   // 上一周期总线利用率（measured_bits / capacity_bits），单位0.1%
+} mg6010e_bus_load_t;
+
+// 延迟解析模式下的接收统计，耗时单位为mg6010e_get_cycle_count的计数
+typedef struct mg6010e_rx_stats
+{
+    uint32_t pending;         // 队列中待解析的帧数
+    uint32_t high_water;      // 待解析帧数的历史最大值
+    uint32_t overrun;         // 因队列已满丢弃的帧数
+    uint32_t isr_count;       // 接收中断中入队的帧数
+    uint32_t isr_last_cycles; // 最近一帧入队的耗时
+    uint32_t isr_max_cycles;  // 单帧入队的最大耗时
+} mg6010e_rx_stats_t;
+
+// 总线收发统计，接收中断耗时单位为mg6010e_get_cycle_count的计数
+typedef struct mg6010e_bus_stats
+{
+    uint32_t tx_frames;       // 交给传输层的帧数
+    uint32_t tx_failures;     // 传输层未能发送的次数（如HAL_CAN_AddTxMessage失败），未发出的帧保留到下一次发送
+    uint32_t tx_dropped;      // 因发送队列满而丢弃的帧数，同mg6010e_get_tx_dropped
+    uint32_t rx_frames;       // 收到的反馈帧数（ID在反馈ID范围内）
+    uint32_t rx_unregistered; // 其中发往未初始化电机ID的帧数
+    uint32_t rx_unknown;      // 其中命令字节未知的帧数
+    uint32_t isr_count;       // mg6010e_can_rx_frame的调用次数
+    uint32_t isr_max_cycles;  // 单次调用的最大耗时
+    uint32_t isr_avg_cycles;  // 平均耗时
+} mg6010e_bus_stats_t;
+
+// 遥测记录统计
+typedef struct mg6010e_recorder_stats
+{
+    uint32_t records;    // 写入的反馈记录数
+    uint32_t bytes;      // 写入的字节数，含同步记录
+    uint32_t dropped;    // 因缓冲区已满丢弃的记录数
+    uint32_t high_water; // 缓冲区中未导出字节数的历史最大值
+} mg6010e_recorder_stats_t;
+
+// 电机收发统计
+typedef struct mg6010e_motor_stats
+{
+    uint32_t tx_frames;  // 交给传输层的命令帧数（不含0x280广播帧）
+    uint32_t rx_frames;  // 收到的反馈帧数
+    uint32_t rx_unknown; // 其中命令字节未知的帧数
+} mg6010e_motor_stats_t;
+
+// 轨迹路点
+typedef struct mg6010e_traj_point
+{
+    uint32_t time_ms; // 相对轨迹起点的时间，单位ms，第一个路点为0，之后严格递增
+    int32_t value;    // 多圈角度（0.01°/LSB）或速度（0.01dps/LSB）
+    int32_t velocity; // 路点处的速度，单位0.01dps/LSB，仅MG6010E_TRAJ_ANGLE_CUBIC使用
+} mg6010e_traj_point_t;
+
+// 轨迹配置
+typedef struct mg6010e_traj_config
+{
+    uint8_t mode;         // 插值方式，MG6010E_TRAJ_ANGLE_LINEAR等
+    uint8_t speed_margin; // 角度轨迹：0xA4最大速度相对轨迹速度的余量，单位%，如20表示1.2倍
+    uint16_t rate_hz;     // 设定值发送频率，单位Hz，超过MG6010E_TRAJ_TICK_HZ时按MG6010E_TRAJ_TICK_HZ处理
+    uint16_t min_speed;   // 角度轨迹：0xA4最大速度的下限，单位dps，避免轨迹速度为0处电机无法纠正误差
+    int16_t iq_limit;     // 速度轨迹：0xA2的转矩电流限制
+} mg6010e_traj_config_t;
+
+// 轨迹跟踪误差统计，误差为反馈值减发出的设定值
+typedef struct mg6010e_traj_error
+{
+    uint32_t samples; // 计入统计的反馈数
+    int32_t last;     // 最近一次误差
+    uint32_t max;     // 误差绝对值的最大值
+    uint64_t sum;     // 误差绝对值之和，除以samples即平均值
+} mg6010e_traj_error_t;
+
+// 轨迹执行状态与跟踪误差统计
+typedef struct mg6010e_traj_stats
+{
+    uint8_t state;                    // 轨迹状态，MG6010E_TRAJ_IDLE等
+    uint32_t elapsed_ms;              // 自启动起经过的时间，单位ms
+    uint32_t setpoints;               // 已发出的设定值数
+    uint32_t send_failures;           // 因发送队列满未能发出的设定值数
+    mg6010e_traj_error_t speed_error; // 速度误差，单位dps，来自0xA4或0xA2的回复
+    mg6010e_traj_error_t angle_error; // 角度误差，单位0.01°，来自角度轨迹运行期间的0x92回复
+} mg6010e_traj_stats_t;
+
+// 控制命令合并统计，节省的帧数为overwritten + skipped
+typedef struct mg6010e_coalesce_stats
+{
+    uint32_t written;     // 写入待发槽位的控制命令数
+    uint32_t overwritten; // 发出前被后写的命令覆盖的命令数
+    uint32_t skipped;     // 与上次发出的命令相同而未发出的命令数
+    uint32_t sent;        // 交给发送队列的命令数
+    uint32_t queue_full;  // 因发送队列已满留到下一周期的次数
+    uint32_t contended;   // 因持续与写入冲突留到下一周期的次数
+} mg6010e_coalesce_stats_t;
+
+// 控制参数快照/恢复的进度
+typedef struct mg6010e_params_progress
+{
+    uint8_t motors;      // 参与的电机数
+    uint16_t total;      // 参数总数，即电机数 × MG6010E_PARAMS_NUM
+    uint16_t done;       // 已完成的参数数（快照：已读取；恢复：已写入且读回一致）
+    uint16_t failed;     // 重发后仍无回复的参数数
+    uint16_t mismatched; // 恢复：读回值与写入值不一致的参数数
+    uint32_t elapsed_us; // 自开始起经过的时间，结束后保持不变
+} mg6010e_params_progress_t;
+
+// 由编码器累计的多圈位置
+typedef struct mg6010e_position
+{
+    int64_t position;        // 多圈位置，单位0.01°，未校准时以编码器零点为0
+    int32_t velocity;        // 速度估计，单位0.01dps
+    uint32_t timestamp;      // 最近一次编码器采样的时间戳，单位us
+    uint8_t anchored;        // 是否已用多圈角度（0x92或0x95回复）校准
+    uint32_t samples;        // 累计的编码器采样数
+    uint32_t anchors;        // 校准次数
+    int32_t last_correction; // 最近一次校准时多圈角度减估计位置，单位0.01°，反映两次校准间的累计误差
+    uint32_t max_correction; // 校准差绝对值的最大值
+} mg6010e_position_t;
+
+// 命令组统计，偏差以各电机对控制命令的回复时间衡量
+typedef struct mg6010e_group_stats
+{
+    uint32_t cycles;      // 已提交的命令组数
+    uint32_t incomplete;  // 下一次提交时仍有电机未回复的命令组数
+    uint8_t motors;       // 最近一个已结束命令组的电机数
+    uint8_t replies;      // 其中收到回复的电机数
+    uint32_t skew_us;     // 最近一个已结束命令组第一帧到最后一帧回复的时间，单位us
+    uint32_t latency_us;  // 最近一个已结束命令组从提交到最后一帧回复的时间，单位us
+    uint32_t max_skew_us; // 回复齐全的命令组中skew_us的最大值
+    uint32_t avg_skew_us; // 回复齐全的命令组中skew_us的平均值
+    uint32_t unsent[MG6010E_MAX_CAN_BUS]; // 最近一次提交中暂存了命令却未发出的电机（故障锁存或未能入队），bit n 对应该总线上ID为n+1的电机
+} mg6010e_group_stats_t;
+
+// 健康监测配置，各阈值为0表示不检测该项
+typedef struct mg6010e_health_config
+{
+    uint32_t timeout_us;    // 回复超时时间，单位us，任何命令的回复都算作回复
+    int8_t max_temperature; // 温度上限，单位1℃
+    int16_t min_voltage;    // 母线电压下限，单位0.01V
+    uint8_t error_mask;     // 视为故障的errorState位
+    uint8_t reaction;       // 故障时的动作，MG6010E_HEALTH_REACT_NONE等
+} mg6010e_health_config_t;
+
+// 健康监测状态
+typedef struct mg6010e_health
+{
+    uint8_t faults;           // 已锁存的故障，MG6010E_HEALTH_STALE等按位或
+    uint32_t age_us;          // 距最近一次回复的时间，单位us
+    uint32_t max_interval_us; // 开始监测以来相邻两次回复间隔的最大值，单位us
+    uint32_t fault_time;      // 最近一次由无故障变为有故障的时间戳，单位us
+    uint32_t trips;           // 由无故障变为有故障的次数
+    uint8_t reaction_result;  // 最近一次故障动作的发送结果，错误码
+} mg6010e_health_t;
+
+// 健康监测故障回调，faults为已锁存的全部故障；在检测到故障的上下文（接收路径或mg6010e_health_tick）中调用
+typedef void (*mg6010e_health_callback_t)(uint8_t motor_id, uint8_t faults);
+
 // 领控6010E电机控制参数结构体
 typedef struct mg6010e_control_params
 {
@@ -79,15 +565,22 @@ typedef struct mg6010e_handle
     mg6010e_status_t status;                 // 电机状态
     mg6010e_encoder_data_t encoder_data;     // 电机编码器数据
     mg6010e_control_params_t control_params; // 电机控制参数
+    mg6010e_status_time_t status_time;       // 电机状态各字段更新时间
+    _Atomic uint32_t sequence;               // 顺序锁计数，奇数表示接收中断正在写入
+    uint8_t bus_index;                       // 所在总线编号
     uint8_t initialized;                     // 初始化标志
 } mg6010e_handle_t;
 
 uint8_t mg6010e_init(mg6010e_config_t *mg6010e_config);
+uint8_t mg6010e_deinit(uint8_t motor_id);
+void mg6010e_set_transport(const mg6010e_transport_t *transport);
+int8_t mg6010e_get_bus_index(mg6010e_can_t *can_handle);
 uint8_t mg6010e_read_status_1(uint8_t motor_id);
 uint8_t mg6010e_read_status_2(uint8_t motor_id);
 uint8_t mg6010e_read_status_3(uint8_t motor_id);
 uint8_t mg6010e_clean_error_flag(uint8_t motor_id);
 uint8_t mg6010e_iq_control(uint8_t motor_id, int16_t iqControl);
+uint8_t mg6010e_iq_control_group(const uint8_t *motor_ids, const int16_t *iqControls, uint8_t count);
 uint8_t mg6010e_speed_control(uint8_t motor_id, int16_t iqControl, int32_t speedControl);
 uint8_t mg6010e_angle_control(uint8_t motor_id, int32_t angleControl);
 uint8_t mg6010e_angle_control_2(uint8_t motor_id, int32_t angleControl, uint16_t maxSpeed);
@@ -108,8 +601,108 @@ uint8_t mg6010e_read_angle(uint8_t motor_id);
 uint8_t mg6010e_read_single_angle(uint8_t motor_id);
 uint8_t mg6010e_set_angle(uint8_t motor_id, int32_t motorAngle);
 uint8_t mg6010e_get_motor_status(uint8_t motor_id, mg6010e_status_t *status);
+uint8_t mg6010e_get_motor_status_time(uint8_t motor_id, mg6010e_status_t *status, mg6010e_status_time_t *status_time);
 uint8_t mg6010e_get_motor_control_params(uint8_t motor_id, mg6010e_control_params_t *control_params);
 uint8_t mg6010e_get_motor_encoder_data(uint8_t motor_id, mg6010e_encoder_data_t *encoder_data);
-void mg6010e_can_rx_callback_hook(CAN_RxHeaderTypeDef *rx_header, uint8_t *rx_data);
+uint8_t mg6010e_set_tx_policy(uint8_t cmd_class, uint8_t policy);
+uint32_t mg6010e_get_tx_dropped(mg6010e_can_t *can_handle);
+uint32_t mg6010e_get_timestamp_us(void);
+#if MG6010E_USE_REQUEST_TRACKING
+void mg6010e_set_request_callback(mg6010e_request_callback_t callback);
+void mg6010e_set_request_timeout(uint32_t timeout_us);
+uint8_t mg6010e_set_request_tracking(uint8_t cmd_class, uint8_t enable);
+void mg6010e_request_check_timeout(void);
+uint8_t mg6010e_get_latency_stats(uint8_t motor_id, mg6010e_latency_stats_t *stats);
+uint32_t mg6010e_latency_percentile(const mg6010e_latency_stats_t *stats, uint8_t percent);
+uint8_t mg6010e_reset_latency_stats(uint8_t motor_id);
+#endif
+#if MG6010E_USE_DEFERRED_RX
+uint32_t mg6010e_process_pending(void);
+uint8_t mg6010e_get_rx_stats(mg6010e_can_t *can_handle, mg6010e_rx_stats_t *stats);
+#endif
+#if MG6010E_USE_DEFERRED_RX || MG6010E_USE_STATS
+uint32_t mg6010e_get_cycle_count(void);
+#endif
+#if MG6010E_USE_STATS
+uint8_t mg6010e_get_bus_stats(mg6010e_can_t *can_handle, mg6010e_bus_stats_t *stats);
+uint8_t mg6010e_get_motor_stats(uint8_t motor_id, mg6010e_motor_stats_t *stats);
+void mg6010e_reset_stats(void);
+#endif
+#if MG6010E_USE_TRACE
+uint32_t mg6010e_trace_dump(uint8_t *buffer, uint32_t size);
+void mg6010e_trace_clear(void);
+#endif
+#if MG6010E_USE_RECORDER
+void mg6010e_recorder_start(void);
+void mg6010e_recorder_stop(void);
+uint32_t mg6010e_recorder_read(uint8_t *buffer, uint32_t size);
+uint8_t mg6010e_get_recorder_stats(mg6010e_can_t *can_handle, mg6010e_recorder_stats_t *stats);
+#endif
+#if MG6010E_USE_BUS_BUDGET
+uint8_t mg6010e_set_bus_budget(mg6010e_can_t *can_handle, uint32_t cycle_us, uint8_t percent);
+void mg6010e_bus_budget_tick(void);
+uint8_t mg6010e_get_bus_load(mg6010e_can_t *can_handle, mg6010e_bus_load_t *load);
+#endif
+#if MG6010E_USE_POLL_SCHEDULER
+uint8_t mg6010e_poll_register(uint8_t motor_id, uint8_t item, uint16_t rate_hz);
+void mg6010e_poll_tick(void);
+#endif
+#if MG6010E_USE_ADAPTIVE_POLL
+uint8_t mg6010e_poll_adaptive(uint8_t motor_id, uint8_t item, uint16_t min_hz, uint16_t max_hz);
+uint8_t mg6010e_set_poll_budget(mg6010e_can_t *can_handle, uint8_t percent);
+void mg6010e_poll_adapt(void);
+uint8_t mg6010e_get_poll_rates(uint8_t motor_id, mg6010e_poll_rates_t *rates);
+uint8_t mg6010e_get_poll_budget(mg6010e_can_t *can_handle, mg6010e_poll_budget_t *budget);
+#endif
+#if MG6010E_USE_TRAJECTORY
+uint8_t mg6010e_traj_load(uint8_t motor_id, const mg6010e_traj_config_t *config, const mg6010e_traj_point_t *points, uint8_t count);
+uint8_t mg6010e_traj_start(const uint8_t *motor_ids, uint8_t count);
+uint8_t mg6010e_traj_stop(uint8_t motor_id);
+void mg6010e_traj_tick(void);
+uint8_t mg6010e_traj_get_stats(uint8_t motor_id, mg6010e_traj_stats_t *stats);
+#endif
+#if MG6010E_USE_PARAMS_SNAPSHOT
+uint8_t mg6010e_snapshot_params_all(void);
+uint8_t mg6010e_restore_params_all(const uint8_t *blob, uint32_t length);
+uint8_t mg6010e_params_poll(void);
+uint8_t mg6010e_params_get_progress(mg6010e_params_progress_t *progress);
+uint8_t mg6010e_params_serialize(uint8_t *blob, uint32_t size, uint32_t *length);
+#endif
+#if MG6010E_USE_ENCODER_UNWRAP
+uint8_t mg6010e_get_position(uint8_t motor_id, mg6010e_position_t *position);
+#endif
+#if MG6010E_USE_HEALTH
+uint8_t mg6010e_set_health_config(uint8_t motor_id, const mg6010e_health_config_t *config);
+void mg6010e_set_health_callback(mg6010e_health_callback_t callback);
+void mg6010e_health_tick(void);
+uint8_t mg6010e_get_health(uint8_t motor_id, mg6010e_health_t *health);
+uint8_t mg6010e_clear_health_fault(uint8_t motor_id);
+#endif
+#if MG6010E_USE_GROUP
+uint8_t mg6010e_group_begin(void);
+uint8_t mg6010e_group_commit(void);
+void mg6010e_group_abort(void);
+uint8_t mg6010e_group_get_stats(mg6010e_group_stats_t *stats);
+#endif
+#if MG6010E_USE_COALESCE
+void mg6010e_set_coalesce_policy(uint8_t skip_unchanged, uint16_t keepalive_cycles);
+void mg6010e_coalesce_flush(void);
+uint8_t mg6010e_get_coalesce_stats(uint8_t motor_id, mg6010e_coalesce_stats_t *stats);
+#endif
+#if MG6010E_USE_SOA_TELEMETRY
+uint8_t mg6010e_get_speeds(uint8_t bus, int16_t *speeds, uint32_t mask);
+uint8_t mg6010e_get_iqs(uint8_t bus, int16_t *iqs, uint32_t mask);
+uint8_t mg6010e_get_encoders(uint8_t bus, uint16_t *encoders, uint32_t mask);
+uint8_t mg6010e_get_temperatures(uint8_t bus, int8_t *temperatures, uint32_t mask);
+uint8_t mg6010e_get_angles(uint8_t bus, int64_t *angles, uint32_t mask);
+#endif
+void mg6010e_can_tx_complete_hook(mg6010e_can_t *can_handle);
+void mg6010e_can_rx_frame(mg6010e_can_t *can_handle, const mg6010e_can_frame_t *frame);
+uint32_t mg6010e_can_rx_process_burst(mg6010e_can_t *can_handle, const mg6010e_can_frame_t *frames, uint32_t count);
+uint32_t mg6010e_can_rx_poll(mg6010e_can_t *can_handle);
+#if MG6010E_USE_HAL
+extern const mg6010e_transport_t mg6010e_hal_transport;
+void mg6010e_can_rx_callback_hook(CAN_HandleTypeDef *can_handle, CAN_RxHeaderTypeDef *rx_header, uint8_t *rx_data);
+#endif
 
 #endif /* __MG6010E_H__ */
\ No newline at end of file
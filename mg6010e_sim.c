@@ -0,0 +1,765 @@
+/**
+ * @file mg6010e_sim.c
+ * @brief 领控6010E电机仿真器源文件
+ */
+#include "mg6010e_sim.h"
+#include <math.h>
+
+#define MG6010E_SIM_TAU_IQ 0.0005f     // 电流环时间常数，单位s
+#define MG6010E_SIM_TAU_ROTOR 0.05f    // 转子时间常数，单位s
+#define MG6010E_SIM_SPEED_PER_IQ 2.0f  // 稳态转速与转矩电流之比，单位dps/LSB
+#define MG6010E_SIM_TAU_THERMAL 10.0f  // 温度时间常数，单位s
+#define MG6010E_SIM_HEAT_PER_IQ2 1.5e-5f // 稳态温升与转矩电流平方之比，单位℃/LSB^2
+#define MG6010E_SIM_AMBIENT 25.0f      // 环境温度，单位℃
+#define MG6010E_SIM_SPEED_KP 2.0f      // 速度环比例系数，单位LSB/dps
+#define MG6010E_SIM_SPEED_KI 20.0f     // 速度环积分系数，单位LSB/(dps*s)
+#define MG6010E_SIM_ANGLE_KP 10.0f     // 角度环比例系数，单位dps/°
+#define MG6010E_SIM_IQ_MAX 2048        // 转矩电流范围
+#define MG6010E_SIM_POLE_PAIRS 7       // 极对数，用于计算相电流
+#define MG6010E_SIM_UNDERVOLTAGE 1800  // 低压保护阈值，单位0.01V
+#define MG6010E_SIM_OVERTEMPERATURE 85 // 过温保护阈值，单位℃
+
+static uint64_t mg6010e_sim_now_ns = 0;                      // 虚拟时间，所有仿真总线共用
+static uint64_t mg6010e_sim_step_ns = 0;                     // 下一次电机模型积分的时间
+static mg6010e_sim_t *mg6010e_sim_list[MG6010E_MAX_CAN_BUS]; // 已初始化的仿真总线
+
+// 控制参数ID，与mg6010e_sim_motor_t.params的排列顺序相同
+static const uint8_t mg6010e_sim_param_ids[8] = {0x0A, 0x0B, 0x0C, 0x1E, 0x20, 0x22, 0x24, 0x26};
+
+static inline void mg6010e_sim_write_le16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+static inline void mg6010e_sim_write_le32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+static inline int32_t mg6010e_sim_read_le32(const uint8_t *data)
+{
+    return (int32_t)(((uint32_t)data[0]) | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+}
+
+static inline float mg6010e_sim_clamp(float value, float limit)
+{
+    return value > limit ? limit : (value < -limit ? -limit : value);
+}
+
+/**
+ * @brief 计算标准数据帧在总线上占用的位数
+ *
+ * @param frame CAN帧
+ * @return uint32_t 位数，包含按实际数据计算的填充位、帧尾与3位帧间隔
+ */
+uint32_t mg6010e_sim_frame_bits(const mg6010e_can_frame_t *frame)
+{
+    uint8_t bits[19 + 64 + 15];
+    uint32_t count = 0;
+    uint8_t dlc = frame->dlc > 8 ? 8 : frame->dlc;
+    bits[count++] = 0; // SOF
+    for (int32_t i = 10; i >= 0; i--)
+    {
+        bits[count++] = (frame->std_id >> i) & 1;
+    }
+    bits[count++] = 0; // RTR
+    bits[count++] = 0; // IDE
+    bits[count++] = 0; // r0
+    for (int32_t i = 3; i >= 0; i--)
+    {
+        bits[count++] = (dlc >> i) & 1;
+    }
+    for (uint32_t byte = 0; byte < dlc; byte++)
+    {
+        for (int32_t i = 7; i >= 0; i--)
+        {
+            bits[count++] = (frame->data[byte] >> i) & 1;
+        }
+    }
+    uint16_t crc = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint8_t crc_next = bits[i] ^ ((crc >> 14) & 1);
+        crc = (uint16_t)((crc << 1) & 0x7FFF);
+        if (crc_next)
+        {
+            crc ^= 0x4599;
+        }
+    }
+    for (int32_t i = 14; i >= 0; i--)
+    {
+        bits[count++] = (crc >> i) & 1;
+    }
+    // 连续5个相同位后插入一个相反位，插入的位计入下一段连续位
+    uint32_t stuffed = 0;
+    uint32_t run = 1;
+    uint8_t last = bits[0];
+    for (uint32_t i = 1; i < count; i++)
+    {
+        if (bits[i] == last)
+        {
+            run++;
+        }
+        else
+        {
+            last = bits[i];
+            run = 1;
+        }
+        if (run == 5)
+        {
+            stuffed++;
+            last = !last;
+            run = 1;
+        }
+    }
+    return count + stuffed + 1 + 2 + 7 + 3; // CRC界定符、ACK、EOF、帧间隔
+}
+
+/**
+ * @brief 电机多圈角度对应的机械角度编码器原始值（16位）
+ */
+static uint16_t mg6010e_sim_encoder_raw(const mg6010e_sim_motor_t *motor)
+{
+    double mechanical = fmod(motor->angle - motor->angle_offset, 36000.0);
+    if (mechanical < 0)
+    {
+        mechanical += 36000.0;
+    }
+    return (uint16_t)(mechanical * 65536.0 / 36000.0);
+}
+
+/**
+ * @brief 电机回复中的编码器值（未减零偏），按encoder_bits截取原始值的高位
+ */
+static uint16_t mg6010e_sim_encoder(const mg6010e_sim_motor_t *motor)
+{
+    return (uint16_t)(mg6010e_sim_encoder_raw(motor) >> (16 - motor->encoder_bits));
+}
+
+/**
+ * @brief 电机回复中减去零偏后的编码器值
+ */
+static uint16_t mg6010e_sim_encoder_zeroed(const mg6010e_sim_motor_t *motor)
+{
+    return (uint16_t)((mg6010e_sim_encoder(motor) - motor->encoder_offset) & ((1U << motor->encoder_bits) - 1));
+}
+
+/**
+ * @brief 取得控制参数在params中的序号
+ *
+ * @return int32_t 序号，未知的控制参数ID返回-1
+ */
+static int32_t mg6010e_sim_param_index(uint8_t param_id)
+{
+    for (int32_t i = 0; i < 8; i++)
+    {
+        if (mg6010e_sim_param_ids[i] == param_id)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 填写状态1回复（0x9A、0x9B）
+ */
+static void mg6010e_sim_reply_status_1(const mg6010e_sim_motor_t *motor, uint8_t *data)
+{
+    data[1] = (uint8_t)(int8_t)motor->temperature;
+    mg6010e_sim_write_le16(&data[2], (uint16_t)motor->voltage);
+    float bus_current = fabsf(motor->iq * (66.0f / 4096.0f) * motor->speed / 2000.0f) * 100.0f; // 粗略的母线电流，单位0.01A
+    mg6010e_sim_write_le16(&data[4], (uint16_t)(int16_t)bus_current);
+    data[6] = motor->motor_state;
+    data[7] = motor->error_state;
+}
+
+/**
+ * @brief 填写状态2回复（0x9C及0xA1~0xA8）
+ */
+static void mg6010e_sim_reply_status_2(const mg6010e_sim_motor_t *motor, uint8_t *data)
+{
+    data[1] = (uint8_t)(int8_t)motor->temperature;
+    mg6010e_sim_write_le16(&data[2], (uint16_t)(int16_t)lrintf(motor->iq));
+    mg6010e_sim_write_le16(&data[4], (uint16_t)(int16_t)lrintf(motor->speed));
+    mg6010e_sim_write_le16(&data[6], mg6010e_sim_encoder_zeroed(motor));
+}
+
+/**
+ * @brief 填写状态3回复（0x9D），相电流由转矩电流与电角度换算
+ */
+static void mg6010e_sim_reply_status_3(const mg6010e_sim_motor_t *motor, uint8_t *data)
+{
+    float electrical = (float)(mg6010e_sim_encoder_raw(motor) * (6.283185307179586 / 65536.0) * MG6010E_SIM_POLE_PAIRS);
+    data[1] = (uint8_t)(int8_t)motor->temperature;
+    mg6010e_sim_write_le16(&data[2], (uint16_t)(int16_t)lrintf(-motor->iq * sinf(electrical)));
+    mg6010e_sim_write_le16(&data[4], (uint16_t)(int16_t)lrintf(-motor->iq * sinf(electrical - 2.0943951f)));
+    mg6010e_sim_write_le16(&data[6], (uint16_t)(int16_t)lrintf(-motor->iq * sinf(electrical + 2.0943951f)));
+}
+
+/**
+ * @brief 切换到角度闭环
+ */
+static void mg6010e_sim_set_angle_target(mg6010e_sim_motor_t *motor, double target, uint16_t max_speed)
+{
+    motor->mode = MG6010E_SIM_MODE_ANGLE;
+    motor->target = (float)target;
+    motor->max_speed = max_speed != 0 ? (float)max_speed : (float)mg6010e_sim_read_le32(&motor->params[4][2]) / 100.0f;
+    motor->iq_limit = (int16_t)(motor->params[3][2] | (motor->params[3][3] << 8));
+}
+
+/**
+ * @brief 电机处理一条命令并生成回复
+ *
+ * @param motor 仿真电机
+ * @param cmd 命令数据
+ * @param reply 回复数据
+ * @return uint8_t 1表示需要回复，0表示不回复
+ */
+static uint8_t mg6010e_sim_command(mg6010e_sim_motor_t *motor, const uint8_t *cmd, uint8_t *reply)
+{
+    memcpy(reply, cmd, 8);
+    if (cmd[0] >= 0xA1 && cmd[0] <= 0xA8)
+    {
+        motor->motor_state = 0x00;
+        motor->stopped = 0;
+    }
+    switch (cmd[0])
+    {
+    case 0x80: // 电机关闭
+        motor->motor_state = 0x10;
+        motor->mode = MG6010E_SIM_MODE_IDLE;
+        return 1;
+    case 0x81: // 电机停止
+        motor->stopped = 1;
+        return 1;
+    case 0x88: // 电机运行
+        motor->motor_state = 0x00;
+        motor->stopped = 0;
+        return 1;
+    case 0x8C: // 抱闸器控制与状态读取
+        if (cmd[1] == 0x00 || cmd[1] == 0x01)
+        {
+            motor->brake = cmd[1];
+        }
+        memset(&reply[1], 0, 7);
+        reply[1] = motor->brake;
+        return 1;
+    case 0x90: // 读取编码器
+    {
+        reply[1] = 0;
+        mg6010e_sim_write_le16(&reply[2], mg6010e_sim_encoder_zeroed(motor));
+        mg6010e_sim_write_le16(&reply[4], mg6010e_sim_encoder(motor));
+        mg6010e_sim_write_le16(&reply[6], motor->encoder_offset);
+        return 1;
+    }
+    case 0x19: // 写入当前位置为编码器零点
+        motor->encoder_offset = mg6010e_sim_encoder(motor);
+        mg6010e_sim_write_le16(&reply[6], motor->encoder_offset);
+        return 1;
+    case 0x92: // 读取多圈角度
+    {
+        uint64_t angle = (uint64_t)(int64_t)llround(motor->angle);
+        for (uint32_t i = 0; i < 7; i++)
+        {
+            reply[1 + i] = (uint8_t)(angle >> (8 * i));
+        }
+        return 1;
+    }
+    case 0x94: // 读取单圈角度
+    {
+        double single = fmod(motor->angle, 36000.0);
+        if (single < 0)
+        {
+            single += 36000.0;
+        }
+        memset(&reply[1], 0, 3);
+        mg6010e_sim_write_le32(&reply[4], (uint32_t)single);
+        return 1;
+    }
+    case 0x95: // 设置当前位置为任意角度
+    {
+        double angle = mg6010e_sim_read_le32(&cmd[4]);
+        motor->angle_offset += angle - motor->angle;
+        motor->angle = angle;
+        return 1;
+    }
+    case 0x9B: // 清除错误标志，故障仍存在时由模型重新置位
+        motor->error_state = 0;
+        mg6010e_sim_reply_status_1(motor, reply);
+        return 1;
+    case 0x9A: // 读取状态1
+        mg6010e_sim_reply_status_1(motor, reply);
+        return 1;
+    case 0x9C: // 读取状态2
+        mg6010e_sim_reply_status_2(motor, reply);
+        return 1;
+    case 0x9D: // 读取状态3
+        mg6010e_sim_reply_status_3(motor, reply);
+        return 1;
+    case 0xA1: // 转矩闭环
+        motor->mode = MG6010E_SIM_MODE_IQ;
+        motor->target = (float)(int16_t)(cmd[4] | (cmd[5] << 8));
+        break;
+    case 0xA2: // 速度闭环
+        motor->mode = MG6010E_SIM_MODE_SPEED;
+        motor->target = (float)mg6010e_sim_read_le32(&cmd[4]) / 100.0f;
+        motor->iq_limit = (int16_t)(cmd[2] | (cmd[3] << 8));
+        if (motor->iq_limit == 0)
+        {
+            motor->iq_limit = (int16_t)(motor->params[3][2] | (motor->params[3][3] << 8));
+        }
+        break;
+    case 0xA3: // 多圈位置闭环
+    case 0xA4:
+        mg6010e_sim_set_angle_target(motor, mg6010e_sim_read_le32(&cmd[4]), cmd[0] == 0xA4 ? (uint16_t)(cmd[2] | (cmd[3] << 8)) : 0);
+        break;
+    case 0xA5: // 单圈位置闭环，spinDirection为0时角度增大方向转动
+    case 0xA6:
+    {
+        double current = fmod(motor->angle, 36000.0);
+        if (current < 0)
+        {
+            current += 36000.0;
+        }
+        double delta = (double)(uint32_t)mg6010e_sim_read_le32(&cmd[4]) - current;
+        if (cmd[1] == 0 && delta < 0)
+        {
+            delta += 36000.0;
+        }
+        else if (cmd[1] != 0 && delta > 0)
+        {
+            delta -= 36000.0;
+        }
+        mg6010e_sim_set_angle_target(motor, motor->angle + delta, cmd[0] == 0xA6 ? (uint16_t)(cmd[2] | (cmd[3] << 8)) : 0);
+        break;
+    }
+    case 0xA7: // 增量位置闭环，在当前目标（非位置闭环时为当前位置）上累加
+    case 0xA8:
+    {
+        double base = motor->mode == MG6010E_SIM_MODE_ANGLE ? motor->target : motor->angle;
+        mg6010e_sim_set_angle_target(motor, base + mg6010e_sim_read_le32(&cmd[4]), cmd[0] == 0xA8 ? (uint16_t)(cmd[2] | (cmd[3] << 8)) : 0);
+        break;
+    }
+    case 0xC0: // 读取控制参数
+    {
+        int32_t index = mg6010e_sim_param_index(cmd[1]);
+        memset(&reply[2], 0, 6);
+        if (index >= 0)
+        {
+            memcpy(&reply[2], motor->params[index], 6);
+        }
+        return 1;
+    }
+    case 0xC1: // 写入控制参数
+    {
+        int32_t index = mg6010e_sim_param_index(cmd[1]);
+        if (index >= 0)
+        {
+            memcpy(motor->params[index], &cmd[2], 6);
+        }
+        return 1;
+    }
+    default:
+        return 0; // 未知命令不回复
+    }
+    mg6010e_sim_reply_status_2(motor, reply); // 0xA1~0xA8
+    return 1;
+}
+
+/**
+ * @brief 电机模型积分一步
+ */
+static void mg6010e_sim_motor_step(mg6010e_sim_motor_t *motor, float dt)
+{
+    float iq_command = 0;
+    if (motor->motor_state == 0x00 && !motor->stopped)
+    {
+        float speed_target = motor->target;
+        switch (motor->mode)
+        {
+        case MG6010E_SIM_MODE_IQ:
+            iq_command = motor->target;
+            break;
+        case MG6010E_SIM_MODE_ANGLE:
+            speed_target = mg6010e_sim_clamp(MG6010E_SIM_ANGLE_KP * (motor->target - (float)motor->angle) / 100.0f, motor->max_speed);
+            // fall through
+        case MG6010E_SIM_MODE_SPEED:
+        {
+            float error = speed_target - motor->speed;
+            motor->speed_integral = mg6010e_sim_clamp(motor->speed_integral + MG6010E_SIM_SPEED_KI * error * dt, motor->iq_limit);
+            iq_command = mg6010e_sim_clamp(MG6010E_SIM_SPEED_KP * error + motor->speed_integral, motor->iq_limit);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    if (iq_command == 0)
+    {
+        motor->speed_integral = 0;
+    }
+    iq_command = mg6010e_sim_clamp(iq_command, MG6010E_SIM_IQ_MAX);
+    motor->iq += (iq_command - motor->iq) * dt / MG6010E_SIM_TAU_IQ;
+    if (motor->brake == 0)
+    {
+        motor->speed = 0; // 抱闸器刹车
+    }
+    else
+    {
+        motor->speed += (MG6010E_SIM_SPEED_PER_IQ * motor->iq - motor->speed) * dt / MG6010E_SIM_TAU_ROTOR;
+    }
+    motor->angle += (double)motor->speed * dt * 100.0;
+    float temperature_target = MG6010E_SIM_AMBIENT + MG6010E_SIM_HEAT_PER_IQ2 * motor->iq * motor->iq;
+    motor->temperature += (temperature_target - motor->temperature) * dt / MG6010E_SIM_TAU_THERMAL;
+    if (motor->voltage < MG6010E_SIM_UNDERVOLTAGE)
+    {
+        motor->error_state |= 0x01;
+    }
+    if (motor->temperature > MG6010E_SIM_OVERTEMPERATURE)
+    {
+        motor->error_state |= 0x08;
+    }
+}
+
+/**
+ * @brief 总线上的一帧传输完成
+ */
+static void mg6010e_sim_frame_done(mg6010e_sim_t *sim)
+{
+    sim->bus_busy = 0;
+    const mg6010e_can_frame_t *frame = &sim->bus_frame;
+    if (sim->bus_source < 0)
+    {
+        // 电机回复帧到达上位机
+        sim->stats.frames_rx++;
+        if (sim->rx_interrupt)
+        {
+            mg6010e_can_rx_frame(sim, frame);
+        }
+        else if (sim->rx_tail - sim->rx_head < MG6010E_SIM_RX_FIFO_DEPTH)
+        {
+            sim->rx_fifo[sim->rx_tail++ % MG6010E_SIM_RX_FIFO_DEPTH] = *frame;
+        }
+        else
+        {
+            sim->stats.rx_overrun++;
+        }
+        return;
+    }
+    // 上位机命令帧到达电机
+    sim->stats.frames_tx++;
+    sim->mailbox_used[sim->bus_source] = 0;
+    uint8_t first = 0;
+    uint8_t last = 0;
+    const uint8_t *cmd = frame->data;
+    uint8_t multi_iq[8] = {0xA1};
+    if (frame->std_id == MG6010E_CAN_MULTI_IQ_ID)
+    {
+        first = 1;
+        last = MG6010E_CAN_MULTI_IQ_MOTOR_NUM;
+        cmd = multi_iq;
+    }
+    else if (frame->std_id > MG6010E_CAN_CMD_BASE_ID && frame->std_id <= MG6010E_CAN_CMD_BASE_ID + 32)
+    {
+        first = last = (uint8_t)(frame->std_id - MG6010E_CAN_CMD_BASE_ID);
+    }
+    for (uint8_t id = first; id != 0 && id <= last; id++)
+    {
+        mg6010e_sim_motor_t *motor = &sim->motors[id - 1];
+        if (!motor->online)
+        {
+            continue;
+        }
+        if (frame->std_id == MG6010E_CAN_MULTI_IQ_ID)
+        {
+            multi_iq[4] = frame->data[(id - 1) * 2];
+            multi_iq[5] = frame->data[(id - 1) * 2 + 1];
+        }
+        uint8_t reply[8];
+        if (!mg6010e_sim_command(motor, cmd, reply))
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < MG6010E_SIM_REPLY_QUEUE; i++)
+        {
+            if (!sim->reply_used[i])
+            {
+                sim->reply_used[i] = 1;
+                sim->reply_ready_ns[i] = mg6010e_sim_now_ns + MG6010E_SIM_REPLY_DELAY_US * 1000ULL;
+                sim->reply[i].std_id = MG6010E_CAN_FEEDBACK_ID(id);
+                sim->reply[i].dlc = 8;
+                memcpy(sim->reply[i].data, reply, 8);
+                break;
+            }
+        }
+    }
+    mg6010e_can_tx_complete_hook(sim); // 模拟发送邮箱空闲中断
+}
+
+/**
+ * @brief 取得仿真总线的下一个事件时间
+ */
+static uint64_t mg6010e_sim_next_event(const mg6010e_sim_t *sim)
+{
+    if (sim->bus_busy)
+    {
+        return sim->bus_free_ns;
+    }
+    uint64_t next = UINT64_MAX;
+    for (uint32_t i = 0; i < MG6010E_SIM_MAILBOX_NUM; i++)
+    {
+        if (sim->mailbox_used[i])
+        {
+            return mg6010e_sim_now_ns;
+        }
+    }
+    for (uint32_t i = 0; i < MG6010E_SIM_REPLY_QUEUE; i++)
+    {
+        if (sim->reply_used[i] && sim->reply_ready_ns[i] < next)
+        {
+            next = sim->reply_ready_ns[i] < mg6010e_sim_now_ns ? mg6010e_sim_now_ns : sim->reply_ready_ns[i];
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief 处理仿真总线在当前时间的事件：帧传输完成，或总线空闲时按ID仲裁开始传输下一帧
+ */
+static void mg6010e_sim_process(mg6010e_sim_t *sim)
+{
+    if (sim->bus_busy)
+    {
+        mg6010e_sim_frame_done(sim);
+        return;
+    }
+    int32_t winner = -1;
+    int8_t source = 0;
+    uint32_t winner_id = UINT32_MAX;
+    for (uint32_t i = 0; i < MG6010E_SIM_MAILBOX_NUM; i++)
+    {
+        if (sim->mailbox_used[i] && sim->mailbox[i].std_id < winner_id)
+        {
+            winner = (int32_t)i;
+            source = (int8_t)i;
+            winner_id = sim->mailbox[i].std_id;
+        }
+    }
+    for (uint32_t i = 0; i < MG6010E_SIM_REPLY_QUEUE; i++)
+    {
+        if (sim->reply_used[i] && sim->reply_ready_ns[i] <= mg6010e_sim_now_ns && sim->reply[i].std_id < winner_id)
+        {
+            winner = (int32_t)i;
+            source = -1;
+            winner_id = sim->reply[i].std_id;
+        }
+    }
+    if (winner < 0)
+    {
+        return;
+    }
+    if (source >= 0)
+    {
+        sim->bus_frame = sim->mailbox[winner]; // 邮箱在传输完成后才释放
+    }
+    else
+    {
+        sim->bus_frame = sim->reply[winner];
+        sim->reply_used[winner] = 0;
+    }
+    uint64_t duration = (uint64_t)mg6010e_sim_frame_bits(&sim->bus_frame) * 1000000000ULL / MG6010E_SIM_BITRATE;
+    sim->bus_source = source;
+    sim->bus_busy = 1;
+    sim->bus_free_ns = mg6010e_sim_now_ns + duration;
+    sim->stats.busy_ns += duration;
+}
+
+/**
+ * @brief 推进虚拟时间，依次处理各仿真总线上的传输事件与电机模型
+ *
+ * @param us 推进的时间，单位us
+ * @note 帧传输完成时在本函数内调用mg6010e_can_tx_complete_hook与mg6010e_can_rx_frame，相当于中断。
+ */
+void mg6010e_sim_advance(uint32_t us)
+{
+    uint64_t end = mg6010e_sim_now_ns + (uint64_t)us * 1000U;
+    for (;;)
+    {
+        mg6010e_sim_t *next_sim = NULL;
+        uint64_t next = mg6010e_sim_step_ns;
+        for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS; i++)
+        {
+            if (mg6010e_sim_list[i] != NULL)
+            {
+                uint64_t event = mg6010e_sim_next_event(mg6010e_sim_list[i]);
+                if (event < next)
+                {
+                    next = event;
+                    next_sim = mg6010e_sim_list[i];
+                }
+            }
+        }
+        if (next > end)
+        {
+            break;
+        }
+        mg6010e_sim_now_ns = next;
+        if (next_sim != NULL)
+        {
+            mg6010e_sim_process(next_sim);
+            continue;
+        }
+        for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS; i++)
+        {
+            for (uint32_t id = 0; mg6010e_sim_list[i] != NULL && id < 32; id++)
+            {
+                mg6010e_sim_motor_step(&mg6010e_sim_list[i]->motors[id], MG6010E_SIM_STEP_US * 1e-6f);
+            }
+        }
+        mg6010e_sim_step_ns += MG6010E_SIM_STEP_US * 1000U;
+    }
+    mg6010e_sim_now_ns = end;
+}
+
+/**
+ * @brief 初始化仿真总线，32个电机全部在线、处于开启状态
+ *
+ * @param sim 仿真总线
+ * @return uint8_t 错误码，0表示成功，1表示参数为空，7表示仿真总线数量超过MG6010E_MAX_CAN_BUS
+ * @note 默认以接收中断方式（rx_interrupt为1）交付回复帧，如需用mg6010e_can_rx_poll轮询接收可将其置0
+ */
+uint8_t mg6010e_sim_init(mg6010e_sim_t *sim)
+{
+    if (sim == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    mg6010e_sim_t **slot = NULL;
+    for (uint32_t i = 0; i < MG6010E_MAX_CAN_BUS && slot == NULL; i++)
+    {
+        if (mg6010e_sim_list[i] == NULL || mg6010e_sim_list[i] == sim)
+        {
+            slot = &mg6010e_sim_list[i];
+        }
+    }
+    if (slot == NULL)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    memset(sim, 0, sizeof(mg6010e_sim_t));
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        mg6010e_sim_motor_t *motor = &sim->motors[i];
+        motor->online = 1;
+        motor->brake = 1;
+        motor->temperature = MG6010E_SIM_AMBIENT;
+        motor->voltage = 2400;
+        motor->encoder_bits = 16;
+        mg6010e_sim_write_le16(&motor->params[0][0], 100); // 角度环Kp
+        mg6010e_sim_write_le16(&motor->params[1][0], 50);  // 速度环Kp
+        mg6010e_sim_write_le16(&motor->params[1][2], 20);  // 速度环Ki
+        mg6010e_sim_write_le16(&motor->params[2][0], 50);  // 电流环Kp
+        mg6010e_sim_write_le16(&motor->params[2][2], 50);  // 电流环Ki
+        mg6010e_sim_write_le16(&motor->params[3][2], 2000);   // 最大转矩电流
+        mg6010e_sim_write_le32(&motor->params[4][2], 36000); // 最大速度，0.01dps/LSB
+    }
+    sim->rx_interrupt = 1;
+    sim->start_ns = mg6010e_sim_now_ns;
+    *slot = sim;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 取得仿真电机，用于读取模型状态或注入故障
+ *
+ * @param sim 仿真总线
+ * @param motor_id 电机ID（1-32）
+ * @return mg6010e_sim_motor_t* 仿真电机，ID无效时返回NULL
+ */
+mg6010e_sim_motor_t *mg6010e_sim_motor(mg6010e_sim_t *sim, uint8_t motor_id)
+{
+    if (sim == NULL || motor_id < 1 || motor_id > 32)
+    {
+        return NULL;
+    }
+    return &sim->motors[motor_id - 1];
+}
+
+/**
+ * @brief 获取仿真总线统计
+ *
+ * @param sim 仿真总线
+ * @param stats 统计输出，总线利用率为busy_ns / elapsed_ns
+ */
+void mg6010e_sim_get_stats(const mg6010e_sim_t *sim, mg6010e_sim_stats_t *stats)
+{
+    *stats = sim->stats;
+    stats->elapsed_ns = mg6010e_sim_now_ns - sim->start_ns;
+}
+
+/**
+ * @brief 仿真传输层：空闲发送邮箱数
+ */
+static uint32_t mg6010e_sim_tx_free(mg6010e_can_t *can)
+{
+    const mg6010e_sim_t *sim = can;
+    uint32_t free_count = 0;
+    for (uint32_t i = 0; i < MG6010E_SIM_MAILBOX_NUM; i++)
+    {
+        free_count += !sim->mailbox_used[i];
+    }
+    return free_count;
+}
+
+/**
+ * @brief 仿真传输层：将帧放入空闲发送邮箱，在下一次mg6010e_sim_advance时上总线
+ */
+static uint32_t mg6010e_sim_send(mg6010e_can_t *can, const mg6010e_can_frame_t *frames, uint32_t count)
+{
+    mg6010e_sim_t *sim = can;
+    uint32_t sent = 0;
+    for (uint32_t i = 0; i < MG6010E_SIM_MAILBOX_NUM && sent < count; i++)
+    {
+        if (!sim->mailbox_used[i])
+        {
+            sim->mailbox[i] = frames[sent++];
+            sim->mailbox_used[i] = 1;
+        }
+    }
+    return sent;
+}
+
+/**
+ * @brief 仿真传输层：从接收FIFO取出回复帧（rx_interrupt为0时）
+ */
+static uint32_t mg6010e_sim_recv(mg6010e_can_t *can, mg6010e_can_frame_t *frames, uint32_t count)
+{
+    mg6010e_sim_t *sim = can;
+    uint32_t received = 0;
+    while (received < count && sim->rx_head != sim->rx_tail)
+    {
+        frames[received++] = sim->rx_fifo[sim->rx_head++ % MG6010E_SIM_RX_FIFO_DEPTH];
+    }
+    return received;
+}
+
+/**
+ * @brief 仿真传输层：虚拟时间，单位us
+ */
+static uint32_t mg6010e_sim_timestamp_us(void)
+{
+    return (uint32_t)(mg6010e_sim_now_ns / 1000U);
+}
+
+// 仿真传输层
+const mg6010e_transport_t mg6010e_sim_transport = {
+    .tx_free = mg6010e_sim_tx_free,
+    .send = mg6010e_sim_send,
+    .recv = mg6010e_sim_recv,
+    .timestamp_us = mg6010e_sim_timestamp_us,
+};
@@ -0,0 +1,101 @@
+/**
+ * @file mg6010e_sim.h
+ * @brief 领控6010E电机仿真器头文件
+ * @note 仿真器作为传输层接入驱动（mg6010e_sim_transport），在虚拟时间中模拟一条CAN总线及其上的32个电机：
+ * 按实际位填充计算每帧的总线时间，模拟3个发送邮箱、ID仲裁与电机回复延迟，电机采用一阶电流/转子模型。
+ * 仅用于上位机（MG6010E_USE_HAL为0），可在没有硬件的情况下端到端运行mg6010e.c。
+ */
+#ifndef __MG6010E_SIM_H__
+#define __MG6010E_SIM_H__
+
+#include "mg6010e.h"
+
+#if MG6010E_USE_HAL
+#error "mg6010e_sim requires MG6010E_USE_HAL to be 0"
+#endif
+
+#ifndef MG6010E_SIM_BITRATE
+#define MG6010E_SIM_BITRATE 1000000 // 仿真总线波特率，单位bit/s
+#endif
+#ifndef MG6010E_SIM_REPLY_DELAY_US
+#define MG6010E_SIM_REPLY_DELAY_US 50 // 电机从收到命令到回复帧可以发出的延迟，单位us
+#endif
+#ifndef MG6010E_SIM_STEP_US
+#define MG6010E_SIM_STEP_US 100 // 电机模型的积分步长，单位us
+#endif
+#ifndef MG6010E_SIM_RX_FIFO_DEPTH
+#define MG6010E_SIM_RX_FIFO_DEPTH 64 // 轮询接收模式下接收FIFO的深度
+#endif
+#define MG6010E_SIM_MAILBOX_NUM 3   // 发送邮箱数量，与bxCAN相同
+#define MG6010E_SIM_REPLY_QUEUE 64  // 等待上总线的回复帧数量
+
+// 仿真电机控制模式
+#define MG6010E_SIM_MODE_IDLE 0   // 无输出
+#define MG6010E_SIM_MODE_IQ 1     // 转矩电流闭环（0xA1、0x280）
+#define MG6010E_SIM_MODE_SPEED 2  // 速度闭环（0xA2）
+#define MG6010E_SIM_MODE_ANGLE 3  // 角度闭环（0xA3~0xA8）
+
+// 仿真电机状态，可直接修改以注入故障（如online置0模拟掉线、修改voltage或error_state）
+typedef struct mg6010e_sim_motor
+{
+    uint8_t online;          // 为0时不回复任何命令
+    uint8_t motor_state;     // 0x00开启，0x10关闭
+    uint8_t stopped;         // 收到0x81后为1，收到0x88后恢复
+    uint8_t error_state;     // 错误标志位，0x01低压，0x08过温
+    uint8_t brake;           // 抱闸器状态，0：断电刹车，1：通电释放
+    uint8_t mode;            // 控制模式，MG6010E_SIM_MODE_*
+    int16_t iq_limit;        // 速度/角度闭环的转矩电流限制，单位同iqControl
+    float target;            // 目标值：转矩电流（LSB）、速度（dps）或多圈角度（0.01°）
+    float max_speed;         // 角度闭环的最大速度，单位dps
+    float iq;                // 实际转矩电流，单位同iqControl
+    float speed;             // 转速，单位dps
+    float speed_integral;    // 速度环积分项，单位同iqControl
+    double angle;            // 多圈角度，单位0.01°，含0x95设置的偏移
+    double angle_offset;     // 0x95设置的多圈角度偏移，单位0.01°
+    float temperature;       // 温度，单位℃
+    int16_t voltage;         // 母线电压，单位0.01V
+    uint16_t encoder_offset; // 编码器零偏
+    uint8_t encoder_bits;    // 编码器位数（14、15或16），初始化为16
+    uint8_t params[8][6];    // 控制参数原始数据（命令字节2~7），按0x0A、0x0B、0x0C、0x1E、0x20、0x22、0x24、0x26排列
+} mg6010e_sim_motor_t;
+
+// 仿真总线统计
+typedef struct mg6010e_sim_stats
+{
+    uint32_t frames_tx;  // 上位机发出的帧数
+    uint32_t frames_rx;  // 电机回复的帧数
+    uint32_t rx_overrun; // 轮询接收模式下因FIFO满丢失的帧数
+    uint64_t busy_ns;    // 总线占用时间，单位ns
+    uint64_t elapsed_ns; // 自初始化起经过的时间，单位ns
+} mg6010e_sim_stats_t;
+
+// 仿真总线，其指针即作为mg6010e_config_t中的can_handle
+typedef struct mg6010e_sim
+{
+    mg6010e_sim_motor_t motors[32];                                 // 按电机ID-1索引
+    mg6010e_can_frame_t mailbox[MG6010E_SIM_MAILBOX_NUM];           // 发送邮箱
+    uint8_t mailbox_used[MG6010E_SIM_MAILBOX_NUM];                  // 邮箱是否占用
+    mg6010e_can_frame_t reply[MG6010E_SIM_REPLY_QUEUE];             // 等待上总线的回复帧
+    uint64_t reply_ready_ns[MG6010E_SIM_REPLY_QUEUE];               // 回复帧可以发出的时间
+    uint8_t reply_used[MG6010E_SIM_REPLY_QUEUE];                    // 回复槽位是否占用
+    mg6010e_can_frame_t rx_fifo[MG6010E_SIM_RX_FIFO_DEPTH];         // 轮询接收模式下的接收FIFO
+    uint32_t rx_head;                                               // 接收FIFO读位置
+    uint32_t rx_tail;                                               // 接收FIFO写位置
+    uint8_t rx_interrupt;                                           // 为1时回复帧传输完成即调用mg6010e_can_rx_frame（模拟接收中断），为0时放入接收FIFO
+    uint8_t bus_busy;                                               // 总线上是否正在传输
+    int8_t bus_source;                                              // 正在传输的帧来源，>=0为邮箱序号，-1为回复帧
+    mg6010e_can_frame_t bus_frame;                                  // 正在传输的帧
+    uint64_t bus_free_ns;                                           // 当前帧传输完成的时间
+    uint64_t start_ns;                                              // 初始化时间
+    mg6010e_sim_stats_t stats;                                      // 统计
+} mg6010e_sim_t;
+
+extern const mg6010e_transport_t mg6010e_sim_transport;
+
+uint8_t mg6010e_sim_init(mg6010e_sim_t *sim);
+void mg6010e_sim_advance(uint32_t us);
+mg6010e_sim_motor_t *mg6010e_sim_motor(mg6010e_sim_t *sim, uint8_t motor_id);
+void mg6010e_sim_get_stats(const mg6010e_sim_t *sim, mg6010e_sim_stats_t *stats);
+uint32_t mg6010e_sim_frame_bits(const mg6010e_can_frame_t *frame);
+
+#endif /* __MG6010E_SIM_H__ */
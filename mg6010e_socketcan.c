@@ -0,0 +1,342 @@
+/**
+ * @file mg6010e_socketcan.c
+ * @brief 领控6010E电机驱动Linux SocketCAN传输层源文件
+ * @note 使用recvmmsg/sendmmsg批量收发，接收线程由epoll驱动。可在vcan虚拟接口上运行，无需硬件：
+ * ip link add dev vcan0 type vcan && ip link set up vcan0
+ */
+#define _GNU_SOURCE
+#include "mg6010e_socketcan.h"
+#include <errno.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+/**
+ * @brief 由CLOCK_MONOTONIC换算的时间戳，单位us
+ */
+static uint32_t mg6010e_socketcan_timestamp_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief 获取可立即发送的帧数
+ *
+ * @note 套接字可写时返回MG6010E_CAN_BATCH_NUM，否则返回0，帧留在驱动的发送队列中，待接收线程收到可写事件后继续发送。
+ * 网卡发送队列已满（ENOBUFS）时套接字仍报告可写，因此在ENOBUFS后的MG6010E_SOCKETCAN_RETRY_US内同样返回0。
+ */
+static uint32_t mg6010e_socketcan_tx_free(mg6010e_can_t *can)
+{
+    mg6010e_socketcan_t *socketcan = can;
+    if (atomic_load_explicit(&socketcan->tx_blocked, memory_order_acquire))
+    {
+        if ((int32_t)(mg6010e_socketcan_timestamp_us() - atomic_load_explicit(&socketcan->tx_retry_time, memory_order_relaxed)) < 0)
+        {
+            return 0;
+        }
+        atomic_store_explicit(&socketcan->tx_blocked, 0, memory_order_relaxed);
+    }
+    struct pollfd pfd = {.fd = socketcan->fd, .events = POLLOUT};
+    if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLOUT))
+    {
+        return 0;
+    }
+    return MG6010E_CAN_BATCH_NUM;
+}
+
+/**
+ * @brief 使用sendmmsg一次发送多帧
+ *
+ * @return uint32_t 成功发送的帧数，网卡发送队列已满（ENOBUFS）时未发出的帧由驱动保留，下一次发送时重发
+ * @note ENOBUFS时不会再有可写事件（套接字本身仍可写），因此启动重试定时器，到期后由接收线程继续发送
+ */
+static uint32_t mg6010e_socketcan_send(mg6010e_can_t *can, const mg6010e_can_frame_t *frames, uint32_t count)
+{
+    mg6010e_socketcan_t *socketcan = can;
+    struct can_frame can_frames[MG6010E_CAN_BATCH_NUM];
+    struct iovec iov[MG6010E_CAN_BATCH_NUM];
+    struct mmsghdr msgs[MG6010E_CAN_BATCH_NUM];
+    if (count > MG6010E_CAN_BATCH_NUM)
+    {
+        count = MG6010E_CAN_BATCH_NUM;
+    }
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        memset(&can_frames[i], 0, sizeof(can_frames[i]));
+        can_frames[i].can_id = frames[i].std_id & CAN_SFF_MASK;
+        can_frames[i].can_dlc = frames[i].dlc;
+        memcpy(can_frames[i].data, frames[i].data, 8);
+        iov[i].iov_base = &can_frames[i];
+        iov[i].iov_len = sizeof(struct can_frame);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    uint32_t sent = 0;
+    while (sent < count)
+    {
+        int ret = sendmmsg(socketcan->fd, &msgs[sent], count - sent, MSG_DONTWAIT);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == ENOBUFS)
+            {
+                atomic_store_explicit(&socketcan->tx_retry_time, mg6010e_socketcan_timestamp_us() + MG6010E_SOCKETCAN_RETRY_US, memory_order_relaxed);
+                atomic_store_explicit(&socketcan->tx_blocked, 1, memory_order_release);
+                if (socketcan->timer_fd >= 0)
+                {
+                    struct itimerspec retry = {.it_value = {.tv_sec = MG6010E_SOCKETCAN_RETRY_US / 1000000, .tv_nsec = MG6010E_SOCKETCAN_RETRY_US % 1000000 * 1000L}};
+                    timerfd_settime(socketcan->timer_fd, 0, &retry, NULL);
+                }
+            }
+            break; // EAGAIN时等待可写事件
+        }
+        sent += (uint32_t)ret;
+    }
+    return sent;
+}
+
+/**
+ * @brief 使用recvmmsg一次取出多帧，丢弃扩展帧、远程帧与错误帧
+ *
+ * @return uint32_t 取出的标准数据帧数，没有待接收的帧时返回0
+ */
+static uint32_t mg6010e_socketcan_recv(mg6010e_can_t *can, mg6010e_can_frame_t *frames, uint32_t count)
+{
+    mg6010e_socketcan_t *socketcan = can;
+    struct can_frame can_frames[MG6010E_RX_BURST_NUM];
+    struct iovec iov[MG6010E_RX_BURST_NUM];
+    struct mmsghdr msgs[MG6010E_RX_BURST_NUM];
+    if (count > MG6010E_RX_BURST_NUM)
+    {
+        count = MG6010E_RX_BURST_NUM;
+    }
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        iov[i].iov_base = &can_frames[i];
+        iov[i].iov_len = sizeof(struct can_frame);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    uint32_t received = 0;
+    while (received == 0) // 一批帧全部被丢弃时继续读取，避免调用者误以为已读空
+    {
+        int ret = recvmmsg(socketcan->fd, msgs, count, MSG_DONTWAIT, NULL);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret <= 0)
+        {
+            break;
+        }
+        for (int i = 0; i < ret; i++)
+        {
+            if (msgs[i].msg_len != sizeof(struct can_frame) || (can_frames[i].can_id & (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_ERR_FLAG)))
+            {
+                continue;
+            }
+            frames[received].std_id = can_frames[i].can_id & CAN_SFF_MASK;
+            frames[received].dlc = can_frames[i].can_dlc;
+            memcpy(frames[received].data, can_frames[i].data, 8);
+            received++;
+        }
+    }
+    return received;
+}
+
+// Linux SocketCAN传输层
+const mg6010e_transport_t mg6010e_socketcan_transport = {
+    .tx_free = mg6010e_socketcan_tx_free,
+    .send = mg6010e_socketcan_send,
+    .recv = mg6010e_socketcan_recv,
+    .timestamp_us = mg6010e_socketcan_timestamp_us,
+};
+
+/**
+ * @brief 打开SocketCAN接口
+ *
+ * @param socketcan SocketCAN总线
+ * @param ifname 网络接口名，如"can0"、"vcan0"
+ * @return uint8_t 错误码，0表示成功，1表示参数为空，7表示接口不存在、套接字创建或设置接收过滤器失败
+ * @note 套接字只接收0x140~0x17F的标准数据帧。打开后将socketcan作为can_handle传给mg6010e_init，
+ * 并通过mg6010e_set_transport(&mg6010e_socketcan_transport)设置传输层。
+ */
+uint8_t mg6010e_socketcan_open(mg6010e_socketcan_t *socketcan, const char *ifname)
+{
+    if (socketcan == NULL || ifname == NULL)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    memset(socketcan, 0, sizeof(mg6010e_socketcan_t));
+    socketcan->epoll_fd = -1;
+    socketcan->event_fd = -1;
+    socketcan->timer_fd = -1;
+    socketcan->fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (socketcan->fd < 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    struct can_filter filter;
+    filter.can_id = MG6010E_CAN_FEEDBACK_BASE_ID;
+    filter.can_mask = (CAN_SFF_MASK & ~0x3FU) | CAN_EFF_FLAG | CAN_RTR_FLAG; // 反馈ID为基ID+1~32，落在基ID起的64个ID内
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(ifname);
+    if (setsockopt(socketcan->fd, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) < 0 || addr.can_ifindex == 0 || bind(socketcan->fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        close(socketcan->fd);
+        socketcan->fd = -1;
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 接收线程：等待epoll事件，批量接收反馈帧并交给驱动处理，套接字重新可写或ENOBUFS重试定时器到期时继续发送队列中的帧
+ */
+static void *mg6010e_socketcan_rx_thread(void *arg)
+{
+    mg6010e_socketcan_t *socketcan = arg;
+    for (;;)
+    {
+        struct epoll_event events[3];
+        int n = epoll_wait(socketcan->epoll_fd, events, 3, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            if (events[i].data.fd == socketcan->event_fd)
+            {
+                return NULL;
+            }
+            if (events[i].data.fd == socketcan->timer_fd)
+            {
+                uint64_t expirations;
+                if (read(socketcan->timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+                {
+                    mg6010e_can_tx_complete_hook(socketcan);
+                }
+                continue;
+            }
+            if (events[i].events & EPOLLIN)
+            {
+                mg6010e_can_rx_poll(socketcan); // 边沿触发，需一直读到没有待接收的帧
+            }
+            if (events[i].events & EPOLLOUT)
+            {
+                mg6010e_can_tx_complete_hook(socketcan);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 启动SocketCAN接收线程
+ *
+ * @param socketcan 已打开的SocketCAN总线
+ * @return uint8_t 错误码，0表示成功，1表示参数为空，7表示epoll或线程创建失败
+ * @note 接收线程是该总线上反馈数据的唯一写者，启动后不要再对同一总线调用mg6010e_can_rx_poll。
+ * 需在mg6010e_set_transport与该总线上的mg6010e_init之后调用。
+ */
+uint8_t mg6010e_socketcan_start(mg6010e_socketcan_t *socketcan)
+{
+    if (socketcan == NULL || socketcan->fd < 0)
+    {
+        return MG6010E_ERROR_CONFIG_NULL_PTR;
+    }
+    socketcan->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    socketcan->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    socketcan->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (socketcan->epoll_fd < 0 || socketcan->event_fd < 0 || socketcan->timer_fd < 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    event.data.fd = socketcan->fd;
+    if (epoll_ctl(socketcan->epoll_fd, EPOLL_CTL_ADD, socketcan->fd, &event) < 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    event.events = EPOLLIN;
+    event.data.fd = socketcan->event_fd;
+    if (epoll_ctl(socketcan->epoll_fd, EPOLL_CTL_ADD, socketcan->event_fd, &event) < 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    event.data.fd = socketcan->timer_fd;
+    if (epoll_ctl(socketcan->epoll_fd, EPOLL_CTL_ADD, socketcan->timer_fd, &event) < 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    if (pthread_create(&socketcan->rx_thread, NULL, mg6010e_socketcan_rx_thread, socketcan) != 0)
+    {
+        return MG6010E_ERROR_NO_RESOURCE;
+    }
+    socketcan->rx_running = 1;
+    return MG6010E_SUCCESS;
+}
+
+/**
+ * @brief 停止接收线程并关闭SocketCAN接口
+ *
+ * @param socketcan SocketCAN总线
+ */
+void mg6010e_socketcan_close(mg6010e_socketcan_t *socketcan)
+{
+    if (socketcan == NULL)
+    {
+        return;
+    }
+    if (socketcan->rx_running)
+    {
+        uint64_t value = 1;
+        if (write(socketcan->event_fd, &value, sizeof(value)) == sizeof(value))
+        {
+            pthread_join(socketcan->rx_thread, NULL);
+        }
+        socketcan->rx_running = 0;
+    }
+    if (socketcan->epoll_fd >= 0)
+    {
+        close(socketcan->epoll_fd);
+        socketcan->epoll_fd = -1;
+    }
+    if (socketcan->event_fd >= 0)
+    {
+        close(socketcan->event_fd);
+        socketcan->event_fd = -1;
+    }
+    if (socketcan->timer_fd >= 0)
+    {
+        close(socketcan->timer_fd);
+        socketcan->timer_fd = -1;
+    }
+    if (socketcan->fd >= 0)
+    {
+        close(socketcan->fd);
+        socketcan->fd = -1;
+    }
+}
@@ -0,0 +1,39 @@
+/**
+ * @file mg6010e_socketcan.h
+ * @brief 领控6010E电机驱动Linux SocketCAN传输层头文件
+ */
+#ifndef __MG6010E_SOCKETCAN_H__
+#define __MG6010E_SOCKETCAN_H__
+
+#include "mg6010e.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if MG6010E_USE_HAL
+#error "mg6010e_socketcan requires MG6010E_USE_HAL to be 0"
+#endif
+
+#ifndef MG6010E_SOCKETCAN_RETRY_US
+#define MG6010E_SOCKETCAN_RETRY_US 1000 // 网卡发送队列已满（ENOBUFS）后等待多久再重试发送，单位us
+#endif
+
+// SocketCAN总线，其指针即作为mg6010e_config_t中的can_handle
+typedef struct mg6010e_socketcan
+{
+    int fd;                 // CAN原始套接字
+    int epoll_fd;           // 接收线程等待的epoll实例
+    int event_fd;           // 用于通知接收线程退出
+    int timer_fd;           // ENOBUFS后的重试定时器，到期时接收线程继续发送
+    pthread_t rx_thread;    // 接收线程
+    uint8_t rx_running;     // 接收线程是否在运行
+    _Atomic uint8_t tx_blocked;     // 上一次发送遇到ENOBUFS，重试时间之前不再发送
+    _Atomic uint32_t tx_retry_time; // 重试时间，单位us
+} mg6010e_socketcan_t;
+
+extern const mg6010e_transport_t mg6010e_socketcan_transport;
+
+uint8_t mg6010e_socketcan_open(mg6010e_socketcan_t *socketcan, const char *ifname);
+uint8_t mg6010e_socketcan_start(mg6010e_socketcan_t *socketcan);
+void mg6010e_socketcan_close(mg6010e_socketcan_t *socketcan);
+
+#endif /* __MG6010E_SOCKETCAN_H__ */
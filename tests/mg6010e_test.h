@@ -0,0 +1,94 @@
+/**
+ * @file mg6010e_test.h
+ * @brief 领控6010E电机驱动上位机单元测试的公共部分
+ * @note 每个测试程序由若干测试函数组成，检查失败时输出文件与行号并继续执行，全部通过时返回0。
+ * 未以MG6010E_USE_HAL为1编译时，驱动经仿真器（mg6010e_sim）收发，测试在虚拟时间中运行。
+ */
+#ifndef __MG6010E_TEST_H__
+#define __MG6010E_TEST_H__
+
+#include "mg6010e.h"
+#if !MG6010E_USE_HAL
+#include "mg6010e_sim.h"
+#endif
+#include <stdio.h>
+
+static uint32_t mg6010e_test_failures; // 失败的检查数
+
+// 检查条件，失败时输出位置与条件
+#define MG6010E_CHECK(cond)                                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(cond))                                                                        \
+        {                                                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+            mg6010e_test_failures++;                                                        \
+        }                                                                                   \
+    } while (0)
+
+// 检查两个整数相等，失败时输出两者的值
+#define MG6010E_CHECK_EQ(actual, expected)                                                                             \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        long long mg6010e_actual = (long long)(actual);                                                                \
+        long long mg6010e_expected = (long long)(expected);                                                            \
+        if (mg6010e_actual != mg6010e_expected)                                                                        \
+        {                                                                                                              \
+            fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #actual, #expected, \
+                    mg6010e_actual, mg6010e_expected);                                                                 \
+            mg6010e_test_failures++;                                                                                   \
+        }                                                                                                              \
+    } while (0)
+
+// 运行一个测试函数并输出结果
+#define MG6010E_TEST_RUN(test)                                                           \
+    do                                                                                   \
+    {                                                                                    \
+        uint32_t mg6010e_before = mg6010e_test_failures;                                 \
+        test();                                                                          \
+        printf("%s %s\n", mg6010e_test_failures == mg6010e_before ? "PASS" : "FAIL", #test); \
+    } while (0)
+
+// main的返回值，有检查失败时为1
+#define MG6010E_TEST_RESULT() (mg6010e_test_failures != 0)
+
+#if !MG6010E_USE_HAL
+static mg6010e_sim_t mg6010e_test_sim; // 测试用的仿真总线（第0条总线）
+
+/**
+ * @brief 推进虚拟时间，延迟解析模式下每100us解析一次队列中的帧
+ */
+static inline void mg6010e_test_advance(uint32_t us)
+{
+#if MG6010E_USE_DEFERRED_RX
+    for (uint32_t t = 0; t < us; t += 100)
+    {
+        mg6010e_sim_advance(us - t < 100 ? us - t : 100);
+        mg6010e_process_pending();
+    }
+#else
+    mg6010e_sim_advance(us);
+#endif
+}
+
+/**
+ * @brief 重新初始化仿真总线，并在其上初始化电机1~motor_num
+ */
+static inline void mg6010e_test_sim_setup(uint8_t motor_num)
+{
+    mg6010e_set_transport(&mg6010e_sim_transport);
+    mg6010e_test_advance(20000); // 发出上一个测试留在发送队列中的帧，并解析其回复
+    for (uint8_t id = 1; id <= 32; id++)
+    {
+        mg6010e_deinit(id);
+    }
+    MG6010E_CHECK_EQ(mg6010e_sim_init(&mg6010e_test_sim), MG6010E_SUCCESS);
+    for (uint8_t id = 1; id <= motor_num; id++)
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_test_sim, .motor_id = id};
+        MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    }
+}
+#endif
+
+#endif /* __MG6010E_TEST_H__ */
@@ -0,0 +1,148 @@
+/**
+ * @file mg6010e_test_adapt.c
+ * @brief 自适应轮询（MG6010E_USE_ADAPTIVE_POLL）测试：静止时按最低频率轮询，转动时按反馈中的转速提高频率并受总线预算限制，
+ * 停止或反馈中断后回落到最低频率
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 8
+#define MG6010E_TEST_ADAPT_TICKS 20 // 每20个tick（50Hz）调用一次mg6010e_poll_adapt
+
+static uint32_t mg6010e_test_replies; // 电机1收到的状态2回复数
+static uint32_t mg6010e_test_last;    // 电机1最近一次状态2回复的时间戳
+
+/**
+ * @brief 以MG6010E_POLL_TICK_HZ调用mg6010e_poll_tick、以50Hz调用mg6010e_poll_adapt推进ms毫秒，统计电机1的状态2回复数
+ */
+static void mg6010e_test_run(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        mg6010e_poll_tick();
+        mg6010e_test_advance(1000000 / MG6010E_POLL_TICK_HZ);
+        if ((i + 1) % MG6010E_TEST_ADAPT_TICKS == 0)
+        {
+            mg6010e_poll_adapt();
+        }
+        mg6010e_status_t status;
+        mg6010e_status_time_t time;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(1, &status, &time), MG6010E_SUCCESS);
+        if (time.speed != mg6010e_test_last)
+        {
+            mg6010e_test_last = time.speed;
+            mg6010e_test_replies++;
+        }
+    }
+}
+
+/**
+ * @brief 检查电机的状态2、多圈角度与状态1均为最低频率
+ */
+static void mg6010e_test_check_minimum(uint8_t id)
+{
+    mg6010e_poll_rates_t rates;
+    MG6010E_CHECK_EQ(mg6010e_get_poll_rates(id, &rates), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(rates.rate_hz[MG6010E_POLL_STATUS_2], 20);
+    MG6010E_CHECK_EQ(rates.rate_hz[MG6010E_POLL_ANGLE], 10);
+    MG6010E_CHECK_EQ(rates.rate_hz[MG6010E_POLL_STATUS_1], 5);
+}
+
+/**
+ * @brief 按README中的示例配置8个电机，预算20%，静止运行到各项稳定在最低频率
+ */
+static void mg6010e_test_setup(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_STATUS_2, 20, 500), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_ANGLE, 10, 200), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_STATUS_1, 5, 100), MG6010E_SUCCESS);
+    }
+    MG6010E_CHECK_EQ(mg6010e_set_poll_budget(&mg6010e_test_sim, 20), MG6010E_SUCCESS);
+    mg6010e_test_run(500);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_test_check_minimum(id);
+    }
+    mg6010e_poll_budget_t budget;
+    MG6010E_CHECK_EQ(mg6010e_get_poll_budget(&mg6010e_test_sim, &budget), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(budget.granted_hz, MG6010E_TEST_MOTOR_NUM * (20 + 10 + 5));
+}
+
+static void mg6010e_test_teardown(void)
+{
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_STATUS_2, 0, 0), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_ANGLE, 0, 0), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_poll_adaptive(id, MG6010E_POLL_STATUS_1, 0, 0), MG6010E_SUCCESS);
+    }
+}
+
+/**
+ * @brief 电机1以720dps转动：新的反馈使其状态2频率升高并受预算限制，其他电机保持最低频率，实际回复数与频率一致；
+ * 停止后1s内回落到最低频率
+ */
+static void mg6010e_test_fresh(void)
+{
+    mg6010e_test_setup();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 72000), MG6010E_SUCCESS);
+    mg6010e_test_run(500);
+
+    mg6010e_poll_rates_t rates;
+    MG6010E_CHECK_EQ(mg6010e_get_poll_rates(1, &rates), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(rates.activity[MG6010E_POLL_STATUS_2], 1000);
+    MG6010E_CHECK_EQ(rates.demand_hz[MG6010E_POLL_STATUS_2], 500);
+    MG6010E_CHECK(rates.rate_hz[MG6010E_POLL_STATUS_2] > 20 && rates.rate_hz[MG6010E_POLL_STATUS_2] < 500); // 受预算限制
+    MG6010E_CHECK(rates.rate_hz[MG6010E_POLL_ANGLE] > 10);
+    uint16_t rate = rates.rate_hz[MG6010E_POLL_STATUS_2];
+    for (uint8_t id = 2; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_test_check_minimum(id);
+    }
+    mg6010e_poll_budget_t budget;
+    MG6010E_CHECK_EQ(mg6010e_get_poll_budget(&mg6010e_test_sim, &budget), MG6010E_SUCCESS);
+    MG6010E_CHECK(budget.demand_hz > budget.budget_hz);
+    MG6010E_CHECK(budget.granted_hz <= budget.budget_hz);
+    MG6010E_CHECK(budget.scale > 0 && budget.scale < 1000);
+
+    mg6010e_test_replies = 0;
+    mg6010e_test_run(1000);
+    MG6010E_CHECK(mg6010e_test_replies * 10 >= rate * 9U && mg6010e_test_replies * 10 <= rate * 11U);
+
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 0), MG6010E_SUCCESS);
+    mg6010e_test_run(1000);
+    mg6010e_test_check_minimum(1);
+    mg6010e_test_teardown();
+}
+
+/**
+ * @brief 电机1转动中掉线：没有新的反馈时不保持较高的频率，1s内回落到最低频率
+ */
+static void mg6010e_test_stale(void)
+{
+    mg6010e_test_setup();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 72000), MG6010E_SUCCESS);
+    mg6010e_test_run(500);
+    mg6010e_poll_rates_t rates;
+    MG6010E_CHECK_EQ(mg6010e_get_poll_rates(1, &rates), MG6010E_SUCCESS);
+    MG6010E_CHECK(rates.rate_hz[MG6010E_POLL_STATUS_2] > 20);
+
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->online = 0;
+    mg6010e_test_replies = 0;
+    mg6010e_test_run(1000);
+    MG6010E_CHECK_EQ(mg6010e_test_replies, 0);
+    mg6010e_test_check_minimum(1);
+    MG6010E_CHECK_EQ(mg6010e_get_poll_rates(1, &rates), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(rates.activity[MG6010E_POLL_STATUS_2], 0);
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->online = 1;
+    mg6010e_test_teardown();
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_fresh);
+    MG6010E_TEST_RUN(mg6010e_test_stale);
+    return MG6010E_TEST_RESULT();
+}
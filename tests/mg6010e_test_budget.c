@@ -0,0 +1,118 @@
+/**
+ * @file mg6010e_test_budget.c
+ * @brief 总线负载预算（MG6010E_USE_BUS_BUDGET）测试：超出每周期预算的命令推迟到之后的周期发出，实际总线占用不超过预算
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 8
+#define MG6010E_TEST_CYCLE_US 1000
+#define MG6010E_TEST_PERCENT 80 // 800位，可容纳2对最坏情况的命令与回复（各270位）
+#define MG6010E_TEST_PAIRS 2
+
+static mg6010e_sim_stats_t mg6010e_test_stats;
+
+/**
+ * @brief 开始新的预算周期，返回上一周期仿真总线发出的帧数与占用时间（ns）
+ */
+static uint32_t mg6010e_test_cycle(uint64_t *busy_ns)
+{
+    mg6010e_sim_stats_t stats;
+    mg6010e_sim_get_stats(&mg6010e_test_sim, &stats);
+    uint32_t frames = stats.frames_tx - mg6010e_test_stats.frames_tx;
+    *busy_ns = stats.busy_ns - mg6010e_test_stats.busy_ns;
+    mg6010e_test_stats = stats;
+    mg6010e_bus_budget_tick();
+    return frames;
+}
+
+/**
+ * @brief 一次发出8条读取命令：每周期只发出2条，其余逐周期推迟，每周期总线占用不超过预算，所有电机最终都收到回复
+ */
+static void mg6010e_test_defer(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_sim, MG6010E_TEST_CYCLE_US, MG6010E_TEST_PERCENT), MG6010E_SUCCESS);
+    uint64_t busy_ns;
+    mg6010e_test_cycle(&busy_ns);
+    mg6010e_bus_load_t load;
+    MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_sim, &load), MG6010E_SUCCESS);
+    uint32_t deferred = load.deferred;
+    MG6010E_CHECK_EQ(load.budget_bits, 800);
+
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    uint32_t pending = MG6010E_TEST_MOTOR_NUM;
+    uint32_t expected_deferred = 0;
+    for (uint32_t cycle = 0; cycle < MG6010E_TEST_MOTOR_NUM / MG6010E_TEST_PAIRS; cycle++)
+    {
+        mg6010e_test_advance(MG6010E_TEST_CYCLE_US);
+        MG6010E_CHECK_EQ(mg6010e_test_cycle(&busy_ns), MG6010E_TEST_PAIRS);
+        MG6010E_CHECK(busy_ns <= (uint64_t)MG6010E_TEST_CYCLE_US * 1000 * MG6010E_TEST_PERCENT / 100);
+        pending -= MG6010E_TEST_PAIRS;
+        expected_deferred += pending;
+        MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_sim, &load), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(load.reserved_bits, MG6010E_TEST_PAIRS * 2 * MG6010E_CAN_FRAME_BITS_MAX(8));
+        MG6010E_CHECK_EQ(load.deferred - deferred, expected_deferred);
+    }
+    mg6010e_test_advance(MG6010E_TEST_CYCLE_US);
+    MG6010E_CHECK_EQ(mg6010e_test_cycle(&busy_ns), 0);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_status_t status;
+        mg6010e_status_time_t time;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &time), MG6010E_SUCCESS);
+        MG6010E_CHECK(time.voltage != 0);
+    }
+}
+
+/**
+ * @brief 0x280广播帧按4个回复计入预算：同一周期内之后的命令推迟到下一周期
+ */
+static void mg6010e_test_broadcast(void)
+{
+    mg6010e_test_sim_setup(4);
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_sim, MG6010E_TEST_CYCLE_US, MG6010E_TEST_PERCENT), MG6010E_SUCCESS);
+    uint64_t busy_ns;
+    mg6010e_test_cycle(&busy_ns);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){1, 2, 3, 4}, (const int16_t[]){10, 20, 30, 40}, 4), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(1), MG6010E_SUCCESS);
+    mg6010e_test_advance(MG6010E_TEST_CYCLE_US);
+    MG6010E_CHECK_EQ(mg6010e_test_cycle(&busy_ns), 1);
+    mg6010e_bus_load_t load;
+    MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_sim, &load), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(load.reserved_bits, 5 * MG6010E_CAN_FRAME_BITS_MAX(8));
+    mg6010e_test_advance(MG6010E_TEST_CYCLE_US);
+    MG6010E_CHECK_EQ(mg6010e_test_cycle(&busy_ns), 1);
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_sim, MG6010E_TEST_CYCLE_US, 0), MG6010E_SUCCESS);
+}
+
+/**
+ * @brief percent为0时不限制发送，只统计负载
+ */
+static void mg6010e_test_unlimited(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_sim, MG6010E_TEST_CYCLE_US, 0), MG6010E_SUCCESS);
+    uint64_t busy_ns;
+    mg6010e_test_cycle(&busy_ns);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    mg6010e_test_advance(4 * MG6010E_TEST_CYCLE_US);
+    MG6010E_CHECK_EQ(mg6010e_test_cycle(&busy_ns), MG6010E_TEST_MOTOR_NUM);
+    mg6010e_bus_load_t load;
+    MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_sim, &load), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(load.budget_bits, 0);
+    MG6010E_CHECK(load.measured_bits > 0 && load.utilization > 0);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_defer);
+    MG6010E_TEST_RUN(mg6010e_test_broadcast);
+    MG6010E_TEST_RUN(mg6010e_test_unlimited);
+    return MG6010E_TEST_RESULT();
+}
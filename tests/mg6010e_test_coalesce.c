@@ -0,0 +1,124 @@
+/**
+ * @file mg6010e_test_coalesce.c
+ * @brief 控制命令合并（MG6010E_USE_COALESCE）测试：同一周期内后写覆盖先写、跳过与上次相同的设定值、按重发间隔保持刷新
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_KEEPALIVE 10
+
+static uint32_t mg6010e_test_frames(void)
+{
+    mg6010e_sim_stats_t stats;
+    mg6010e_sim_get_stats(&mg6010e_test_sim, &stats);
+    return stats.frames_tx;
+}
+
+/**
+ * @brief 同一周期内的多次写入只发出最后一条，未调用mg6010e_coalesce_flush前不发出
+ */
+static void mg6010e_test_overwrite(void)
+{
+    mg6010e_test_sim_setup(2);
+    mg6010e_set_coalesce_policy(0, 0);
+    uint32_t frames = mg6010e_test_frames();
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 100), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 200), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_speed_control(2, 500, 1000), MG6010E_SUCCESS);
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames);
+
+    mg6010e_coalesce_flush();
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames + 2);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 1)->mode, MG6010E_SIM_MODE_IQ);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim, 1)->target == 200.0f);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 2)->mode, MG6010E_SIM_MODE_SPEED);
+
+    mg6010e_coalesce_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_coalesce_stats(1, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.written, 2);
+    MG6010E_CHECK_EQ(stats.overwritten, 1);
+    MG6010E_CHECK_EQ(stats.sent, 1);
+    MG6010E_CHECK_EQ(mg6010e_get_coalesce_stats(0, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.written, 3);
+    MG6010E_CHECK_EQ(stats.sent, 2);
+
+    // 没有新写入时不再发出
+    mg6010e_coalesce_flush();
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames + 2);
+}
+
+/**
+ * @brief 不设重发间隔时，与上次发出的命令相同的设定值一直跳过，设定值改变后立即发出
+ */
+static void mg6010e_test_skip(void)
+{
+    mg6010e_test_sim_setup(1);
+    mg6010e_set_coalesce_policy(1, 0);
+    uint32_t frames = mg6010e_test_frames();
+    for (uint32_t cycle = 0; cycle < 20; cycle++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(1, 300), MG6010E_SUCCESS);
+        mg6010e_coalesce_flush();
+        mg6010e_test_advance(1000);
+    }
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames + 1);
+    mg6010e_coalesce_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_coalesce_stats(1, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.sent, 1);
+    MG6010E_CHECK_EQ(stats.skipped, 19);
+
+    // 命令字节不同的相同数值不算重复
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 301), MG6010E_SUCCESS);
+    mg6010e_coalesce_flush();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 301, 0), MG6010E_SUCCESS);
+    mg6010e_coalesce_flush();
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames + 3);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 1)->mode, MG6010E_SIM_MODE_SPEED);
+    mg6010e_set_coalesce_policy(0, 0);
+}
+
+/**
+ * @brief 设置重发间隔后，相同的设定值每MG6010E_TEST_KEEPALIVE个周期重发一次，反馈随之刷新
+ */
+static void mg6010e_test_keepalive(void)
+{
+    mg6010e_test_sim_setup(1);
+    mg6010e_set_coalesce_policy(1, MG6010E_TEST_KEEPALIVE);
+    uint32_t frames = mg6010e_test_frames();
+    uint32_t updated = 0;
+    uint32_t last_update = 0;
+    for (uint32_t cycle = 0; cycle < 3 * MG6010E_TEST_KEEPALIVE; cycle++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(1, 300), MG6010E_SUCCESS);
+        mg6010e_coalesce_flush();
+        mg6010e_test_advance(1000);
+        mg6010e_status_t status;
+        mg6010e_status_time_t time;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(1, &status, &time), MG6010E_SUCCESS);
+        if (time.speed != last_update)
+        {
+            MG6010E_CHECK_EQ(cycle % MG6010E_TEST_KEEPALIVE, 0); // 只有发出的周期有回复
+            last_update = time.speed;
+            updated++;
+        }
+    }
+    MG6010E_CHECK_EQ(updated, 3);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(), frames + 3);
+    mg6010e_coalesce_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_coalesce_stats(1, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.sent, 3);
+    MG6010E_CHECK_EQ(stats.skipped, 3 * MG6010E_TEST_KEEPALIVE - 3);
+    MG6010E_CHECK_EQ(stats.contended, 0);
+    mg6010e_set_coalesce_policy(0, 0);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_overwrite);
+    MG6010E_TEST_RUN(mg6010e_test_skip);
+    MG6010E_TEST_RUN(mg6010e_test_keepalive);
+    return MG6010E_TEST_RESULT();
+}
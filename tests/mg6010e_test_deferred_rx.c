@@ -0,0 +1,97 @@
+/**
+ * @file mg6010e_test_deferred_rx.c
+ * @brief 延迟解析（MG6010E_USE_DEFERRED_RX）测试：接收中断只入队，mg6010e_process_pending解析，队列满时计入overrun
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 4
+
+static mg6010e_can_frame_t mg6010e_test_status_1_frame(uint8_t motor_id, int16_t voltage)
+{
+    mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(motor_id), .dlc = 8, .data = {0x9A}};
+    frame.data[2] = (uint8_t)voltage;
+    frame.data[3] = (uint8_t)((uint16_t)voltage >> 8);
+    return frame;
+}
+
+/**
+ * @brief 回复在mg6010e_process_pending之前不改变电机数据，解析后的时间戳为接收时间
+ */
+static void mg6010e_test_decode_in_task(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_sim_motor(&mg6010e_test_sim, id)->voltage = 2300 + id;
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    mg6010e_sim_advance(5000);
+    uint32_t received = mg6010e_get_timestamp_us();
+
+    mg6010e_rx_stats_t rx_stats;
+    MG6010E_CHECK_EQ(mg6010e_get_rx_stats(&mg6010e_test_sim, &rx_stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(rx_stats.pending, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK(rx_stats.high_water >= MG6010E_TEST_MOTOR_NUM);
+    mg6010e_status_t status;
+    mg6010e_status_time_t status_time;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(1, &status), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(status.voltage, 0);
+
+    mg6010e_sim_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_process_pending(), MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &status_time), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(status.voltage, 2300 + id);
+        MG6010E_CHECK(status_time.voltage != 0 && status_time.voltage <= received);
+    }
+    MG6010E_CHECK_EQ(mg6010e_get_rx_stats(&mg6010e_test_sim, &rx_stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(rx_stats.pending, 0);
+    MG6010E_CHECK_EQ(mg6010e_process_pending(), 0);
+}
+
+/**
+ * @brief 队列满后到达的帧被丢弃并计入overrun，已入队的帧按到达顺序解析
+ */
+static void mg6010e_test_overrun(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_rx_stats_t before;
+    MG6010E_CHECK_EQ(mg6010e_get_rx_stats(&mg6010e_test_sim, &before), MG6010E_SUCCESS);
+    for (int16_t i = 0; i < MG6010E_RX_RING_DEPTH + 8; i++)
+    {
+        mg6010e_can_frame_t frame = mg6010e_test_status_1_frame(1, (int16_t)(2000 + i));
+        mg6010e_can_rx_frame(&mg6010e_test_sim, &frame);
+    }
+    // 不属于本驱动的帧不入队
+    mg6010e_can_frame_t foreign = {.std_id = 0x100, .dlc = 8, .data = {0x9A}};
+    mg6010e_can_rx_frame(&mg6010e_test_sim, &foreign);
+
+    mg6010e_rx_stats_t after;
+    MG6010E_CHECK_EQ(mg6010e_get_rx_stats(&mg6010e_test_sim, &after), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(after.pending, MG6010E_RX_RING_DEPTH);
+    MG6010E_CHECK_EQ(after.high_water, MG6010E_RX_RING_DEPTH);
+    MG6010E_CHECK_EQ(after.overrun - before.overrun, 8);
+    MG6010E_CHECK_EQ(after.isr_count - before.isr_count, MG6010E_RX_RING_DEPTH);
+
+    MG6010E_CHECK_EQ(mg6010e_process_pending(), MG6010E_RX_RING_DEPTH);
+    mg6010e_status_t status;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(1, &status), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(status.voltage, 2000 + MG6010E_RX_RING_DEPTH - 1); // 最后一个入队的帧
+
+    // 解析后队列恢复可用
+    mg6010e_can_frame_t frame = mg6010e_test_status_1_frame(2, 2222);
+    mg6010e_can_rx_frame(&mg6010e_test_sim, &frame);
+    MG6010E_CHECK_EQ(mg6010e_process_pending(), 1);
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(2, &status), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(status.voltage, 2222);
+    MG6010E_CHECK_EQ(mg6010e_get_rx_stats(&mg6010e_test_sim, &after), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(after.overrun - before.overrun, 8);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_decode_in_task);
+    MG6010E_TEST_RUN(mg6010e_test_overrun);
+    return MG6010E_TEST_RESULT();
+}
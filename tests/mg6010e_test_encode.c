@@ -0,0 +1,153 @@
+/**
+ * @file mg6010e_test_encode.c
+ * @brief 命令编码测试：每个命令发出的帧与基线版本（mg6010e_send_cmd直接写邮箱）逐字节一致
+ * @note 以HAL注册，经bench/mock_hal记录写入发送邮箱的帧。期望帧由基线版本的驱动以相同参数在同一模拟HAL上发送得到，
+ * 参数覆盖负数、多字节小端序与各字段位置。
+ */
+#include "mg6010e_test.h"
+#include "stm32f4xx_hal.h"
+
+#define MG6010E_TEST_MOTOR_ID 7
+
+static CAN_HandleTypeDef mg6010e_test_can; // 模拟的CAN句柄
+
+static uint8_t mg6010e_test_break_engage(uint8_t motor_id)
+{
+    return mg6010e_break_control(motor_id, 1);
+}
+
+static uint8_t mg6010e_test_break_release(uint8_t motor_id)
+{
+    return mg6010e_break_control(motor_id, 0);
+}
+
+static uint8_t mg6010e_test_iq(uint8_t motor_id)
+{
+    return mg6010e_iq_control(motor_id, -1234);
+}
+
+static uint8_t mg6010e_test_speed(uint8_t motor_id)
+{
+    return mg6010e_speed_control(motor_id, 300, -1234567);
+}
+
+static uint8_t mg6010e_test_angle(uint8_t motor_id)
+{
+    return mg6010e_angle_control(motor_id, 0x12345678);
+}
+
+static uint8_t mg6010e_test_angle_2(uint8_t motor_id)
+{
+    return mg6010e_angle_control_2(motor_id, -36000, 720);
+}
+
+static uint8_t mg6010e_test_single_angle(uint8_t motor_id)
+{
+    return mg6010e_single_angle_control(motor_id, 27000, 1);
+}
+
+static uint8_t mg6010e_test_single_angle_2(uint8_t motor_id)
+{
+    return mg6010e_single_angle_control_2(motor_id, 9000, 0xABCD, 0);
+}
+
+static uint8_t mg6010e_test_increment(uint8_t motor_id)
+{
+    return mg6010e_angle_increment_control(motor_id, -90000);
+}
+
+static uint8_t mg6010e_test_increment_2(uint8_t motor_id)
+{
+    return mg6010e_angle_increment_control_2(motor_id, 45000, 500);
+}
+
+static uint8_t mg6010e_test_read_param(uint8_t motor_id)
+{
+    return mg6010e_read_control_param(motor_id, 0x0B);
+}
+
+static uint8_t mg6010e_test_write_param(uint8_t motor_id)
+{
+    uint8_t param_data[6] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB};
+    return mg6010e_write_control_param(motor_id, 0x0A, param_data);
+}
+
+static uint8_t mg6010e_test_set_angle(uint8_t motor_id)
+{
+    return mg6010e_set_angle(motor_id, -123456);
+}
+
+// 一个命令及其期望帧
+typedef struct mg6010e_test_golden
+{
+    const char *name;                 // 命令名称，检查失败时输出
+    uint8_t (*send)(uint8_t motor_id); // 发送该命令
+    uint8_t data[8];                  // 基线版本发出的数据
+} mg6010e_test_golden_t;
+
+// 期望帧，ID均为MG6010E_CAN_CMD_ID(MG6010E_TEST_MOTOR_ID)
+static const mg6010e_test_golden_t mg6010e_test_goldens[] = {
+    {"read_status_1", mg6010e_read_status_1, {0x9A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"clean_error_flag", mg6010e_clean_error_flag, {0x9B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"read_status_2", mg6010e_read_status_2, {0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"read_status_3", mg6010e_read_status_3, {0x9D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"disable", mg6010e_disable, {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"run", mg6010e_run, {0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"stop", mg6010e_stop, {0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"break_status_read", mg6010e_break_status_read, {0x8C, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"break_control(1)", mg6010e_test_break_engage, {0x8C, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"break_control(0)", mg6010e_test_break_release, {0x8C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"iq_control(-1234)", mg6010e_test_iq, {0xA1, 0x00, 0x00, 0x00, 0x2E, 0xFB, 0x00, 0x00}},
+    {"speed_control(300, -1234567)", mg6010e_test_speed, {0xA2, 0x00, 0x2C, 0x01, 0x79, 0x29, 0xED, 0xFF}},
+    {"angle_control(0x12345678)", mg6010e_test_angle, {0xA3, 0x00, 0x00, 0x00, 0x78, 0x56, 0x34, 0x12}},
+    {"angle_control_2(-36000, 720)", mg6010e_test_angle_2, {0xA4, 0x00, 0xD0, 0x02, 0x60, 0x73, 0xFF, 0xFF}},
+    {"single_angle_control(27000, 1)", mg6010e_test_single_angle, {0xA5, 0x01, 0x00, 0x00, 0x78, 0x69, 0x00, 0x00}},
+    {"single_angle_control_2(9000, 0xABCD, 0)", mg6010e_test_single_angle_2, {0xA6, 0x00, 0xCD, 0xAB, 0x28, 0x23, 0x00, 0x00}},
+    {"angle_increment_control(-90000)", mg6010e_test_increment, {0xA7, 0x00, 0x00, 0x00, 0x70, 0xA0, 0xFE, 0xFF}},
+    {"angle_increment_control_2(45000, 500)", mg6010e_test_increment_2, {0xA8, 0x00, 0xF4, 0x01, 0xC8, 0xAF, 0x00, 0x00}},
+    {"read_control_param(0x0B)", mg6010e_test_read_param, {0xC0, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"write_control_param(0x0A)", mg6010e_test_write_param, {0xC1, 0x0A, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB}},
+    {"read_encoder", mg6010e_read_encoder, {0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"write_encoder_zero_point", mg6010e_write_encoder_zero_point, {0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"read_angle", mg6010e_read_angle, {0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"read_single_angle", mg6010e_read_single_angle, {0x94, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"set_angle(-123456)", mg6010e_test_set_angle, {0x95, 0x00, 0x00, 0x00, 0xC0, 0x1D, 0xFE, 0xFF}},
+};
+
+/**
+ * @brief 逐个发送命令，每个命令恰好发出一帧，ID与8字节数据与期望帧一致
+ */
+static void mg6010e_test_goldens_match(void)
+{
+    mock_hal_can_init(&mg6010e_test_can);
+    mg6010e_set_transport(&mg6010e_hal_transport);
+    mg6010e_config_t config = {.can_handle = &mg6010e_test_can, .motor_id = MG6010E_TEST_MOTOR_ID};
+    MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    for (uint32_t i = 0; i < sizeof(mg6010e_test_goldens) / sizeof(mg6010e_test_goldens[0]); i++)
+    {
+        const mg6010e_test_golden_t *golden = &mg6010e_test_goldens[i];
+        uint32_t tx_frames = mg6010e_test_can.tx_frames;
+        MG6010E_CHECK_EQ(golden->send(MG6010E_TEST_MOTOR_ID), MG6010E_SUCCESS);
+#if MG6010E_USE_COALESCE
+        mg6010e_coalesce_flush();
+#endif
+        uint32_t index = tx_frames % MOCK_HAL_TX_LOG_DEPTH;
+        const uint8_t *data = mg6010e_test_can.tx_log_data[index];
+        uint8_t match = mg6010e_test_can.tx_frames == tx_frames + 1 &&
+                        mg6010e_test_can.tx_log_id[index] == MG6010E_CAN_CMD_ID(MG6010E_TEST_MOTOR_ID) &&
+                        memcmp(data, golden->data, 8) == 0;
+        if (!match)
+        {
+            fprintf(stderr, "%s: %u frames, id 0x%03X, data %02X %02X %02X %02X %02X %02X %02X %02X\n", golden->name,
+                    mg6010e_test_can.tx_frames - tx_frames, mg6010e_test_can.tx_log_id[index],
+                    data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7]);
+        }
+        MG6010E_CHECK(match);
+    }
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_goldens_match);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file mg6010e_test_group.c
+ * @brief 命令组（MG6010E_USE_GROUP）测试：暂存、后写覆盖、提交后连续发出、偏差统计与发送队列不足时的提交
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 8
+
+static uint32_t mg6010e_test_frames_tx(void)
+{
+    mg6010e_sim_stats_t stats;
+    mg6010e_sim_get_stats(&mg6010e_test_sim, &stats);
+    return stats.frames_tx;
+}
+
+/**
+ * @brief 连续100个周期每个周期提交全部电机的命令组，每组都收齐回复
+ */
+static void mg6010e_test_cycles(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_group_stats_t before;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&before), MG6010E_SUCCESS);
+    for (int32_t cycle = 0; cycle < 100; cycle++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+        for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+        {
+            MG6010E_CHECK_EQ(mg6010e_angle_control(id, cycle * 100 + id), MG6010E_SUCCESS);
+        }
+        MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_SUCCESS);
+        mg6010e_test_advance(3000); // 8帧命令与8帧回复约占2.2ms
+    }
+    mg6010e_group_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.cycles - before.cycles, 100);
+    MG6010E_CHECK_EQ(stats.incomplete, before.incomplete);
+    MG6010E_CHECK_EQ(stats.motors, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(stats.replies, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK(stats.skew_us > 0 && stats.skew_us < 3000);
+    MG6010E_CHECK(stats.latency_us >= stats.skew_us && stats.latency_us < 3000);
+    MG6010E_CHECK(stats.max_skew_us >= stats.avg_skew_us && stats.avg_skew_us > 0);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, id)->target, 99 * 100 + id);
+    }
+}
+
+/**
+ * @brief 打开期间控制命令不发出，同一电机后写覆盖先写，广播命令返回MG6010E_ERROR_BUSY；读取命令不受命令组影响
+ */
+static void mg6010e_test_staging(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_ERROR_BUSY);
+    uint32_t frames_tx = mg6010e_test_frames_tx();
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 100), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 200), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, -50), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 300), MG6010E_SUCCESS);
+    mg6010e_test_advance(2000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames_tx(), frames_tx);
+
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(3), MG6010E_SUCCESS);
+    mg6010e_test_advance(2000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames_tx(), frames_tx + 1);
+
+    MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_SUCCESS);
+    mg6010e_test_advance(2000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames_tx(), frames_tx + 3);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, 300);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 2)->target, -50);
+    MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_ERROR_NOT_INITIALIZED);
+
+    // 放弃的命令组不发出任何命令，打开期间广播命令被拒绝
+    uint8_t motor_ids[4] = {1, 2, 3, 4};
+    int16_t iqs[4] = {500, 500, 500, 500};
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 400), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group(motor_ids, iqs, 4), MG6010E_ERROR_BUSY);
+    mg6010e_group_abort();
+    mg6010e_test_advance(2000);
+    MG6010E_CHECK_EQ(mg6010e_test_frames_tx(), frames_tx + 3);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, 300);
+}
+
+/**
+ * @brief 掉线电机未回复的命令组在下一次提交时计为未完成
+ */
+static void mg6010e_test_incomplete(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_group_stats_t before;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&before), MG6010E_SUCCESS);
+    mg6010e_sim_motor(&mg6010e_test_sim, 3)->online = 0;
+    for (int32_t cycle = 0; cycle < 2; cycle++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+        for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+        {
+            MG6010E_CHECK_EQ(mg6010e_iq_control(id, (int16_t)(10 * id)), MG6010E_SUCCESS);
+        }
+        MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_SUCCESS);
+        mg6010e_test_advance(3000);
+    }
+    mg6010e_group_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.cycles - before.cycles, 2);
+    MG6010E_CHECK_EQ(stats.incomplete - before.incomplete, 1); // 第二组尚未结束
+    MG6010E_CHECK_EQ(stats.motors, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(stats.replies, MG6010E_TEST_MOTOR_NUM - 1);
+    mg6010e_sim_motor(&mg6010e_test_sim, 3)->online = 1;
+}
+
+/**
+ * @brief 一条总线容纳不下本组命令时提交失败，另一条总线上可丢弃的旧帧也不丢弃，命令组保持打开
+ */
+static void mg6010e_test_queue_full(void)
+{
+    static mg6010e_sim_t second; // 第1条总线
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_sim_init(&second), MG6010E_SUCCESS);
+    mg6010e_config_t config = {.can_handle = &second, .motor_id = 1};
+    MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    uint8_t remote = MG6010E_MOTOR(mg6010e_get_bus_index(&second), 1);
+
+    // 虚拟时间不推进：第0条总线的队列被读取命令（可丢弃）占满，第1条总线的队列被停止命令（不可丢弃）占满
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH + 3; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(1), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_stop(remote), MG6010E_SUCCESS);
+    }
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_sim);
+    mg6010e_group_stats_t before;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&before), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 10), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, 20), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(remote, 30), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_ERROR_QUEUE_FULL);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_sim), dropped);
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_ERROR_BUSY); // 仍然打开
+    mg6010e_group_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.cycles, before.cycles);
+
+    // 第1条总线有空位后重试提交，第0条总线丢弃两条旧的读取命令
+    mg6010e_test_advance(20000);
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH + 3; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(1), MG6010E_SUCCESS);
+    }
+    dropped = mg6010e_get_tx_dropped(&mg6010e_test_sim);
+    MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_sim) - dropped, 2);
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.cycles, before.cycles + 1);
+    MG6010E_CHECK_EQ(stats.unsent[0], 0);
+    MG6010E_CHECK_EQ(stats.unsent[1], 0);
+    mg6010e_test_advance(20000);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 2)->target, 20);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&second, 1)->target, 30);
+    MG6010E_CHECK_EQ(mg6010e_deinit(remote), MG6010E_SUCCESS);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_cycles);
+    MG6010E_TEST_RUN(mg6010e_test_staging);
+    MG6010E_TEST_RUN(mg6010e_test_incomplete);
+    MG6010E_TEST_RUN(mg6010e_test_queue_full);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,212 @@
+/**
+ * @file mg6010e_test_health.c
+ * @brief 健康监测（MG6010E_USE_HEALTH）测试：各类故障的检测、故障动作、回调、控制命令拒绝与故障清除
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 4
+
+static uint32_t mg6010e_test_callbacks;     // 回调次数
+static uint8_t mg6010e_test_callback_motor;  // 最近一次回调的电机编号
+static uint8_t mg6010e_test_callback_faults; // 最近一次回调的故障
+
+static void mg6010e_test_health_callback(uint8_t motor_id, uint8_t faults)
+{
+    mg6010e_test_callbacks++;
+    mg6010e_test_callback_motor = motor_id;
+    mg6010e_test_callback_faults = faults;
+}
+
+/**
+ * @brief 推进虚拟时间，每1ms调用一次mg6010e_health_tick（启用合并时先发出合并的控制命令）
+ */
+static void mg6010e_test_run(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+#if MG6010E_USE_COALESCE
+        mg6010e_coalesce_flush();
+#endif
+        mg6010e_test_advance(1000);
+        mg6010e_health_tick();
+    }
+}
+
+static void mg6010e_test_setup(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_set_health_config(id, NULL), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_clear_health_fault(id), MG6010E_SUCCESS);
+    }
+    mg6010e_set_health_callback(mg6010e_test_health_callback);
+    mg6010e_test_callbacks = 0;
+}
+
+/**
+ * @brief 不回复的电机在超时后锁存STALE并收到停止命令，控制命令被拒绝；持续回复的电机不超时
+ */
+static void mg6010e_test_stale(void)
+{
+    mg6010e_test_setup();
+    mg6010e_health_config_t config = {.timeout_us = 20000, .reaction = MG6010E_HEALTH_REACT_STOP};
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(1, &config), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(2, &config), MG6010E_SUCCESS);
+    for (uint32_t ms = 0; ms < 40; ms++)
+    {
+        if (ms % 5 == 0)
+        {
+            MG6010E_CHECK_EQ(mg6010e_read_status_2(2), MG6010E_SUCCESS); // 电机1不读取，不会回复
+        }
+        mg6010e_test_run(1);
+        mg6010e_health_t health;
+        MG6010E_CHECK_EQ(mg6010e_get_health(1, &health), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(health.faults, ms < 20 ? 0 : MG6010E_HEALTH_STALE);
+    }
+    mg6010e_health_t health;
+    MG6010E_CHECK_EQ(mg6010e_get_health(1, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.trips, 1);
+    MG6010E_CHECK_EQ(health.reaction_result, MG6010E_SUCCESS);
+    MG6010E_CHECK(health.fault_time != 0);
+    MG6010E_CHECK(health.age_us < 20000); // 停止命令的回复
+    MG6010E_CHECK_EQ(mg6010e_get_health(2, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, 0);
+    MG6010E_CHECK(health.max_interval_us <= 6000);
+    MG6010E_CHECK_EQ(mg6010e_test_callbacks, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_callback_motor, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_callback_faults, MG6010E_HEALTH_STALE);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 1)->stopped, 1);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 2)->stopped, 0);
+
+    // 控制命令被拒绝，读取与配置命令不受影响
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 100), MG6010E_ERROR_FAULT);
+    MG6010E_CHECK_EQ(mg6010e_angle_control(1, 100), MG6010E_ERROR_FAULT);
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_run(1), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 1)->stopped, 0);
+    MG6010E_CHECK_EQ(mg6010e_get_health(1, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, MG6010E_HEALTH_STALE); // 故障保持锁存
+
+    MG6010E_CHECK_EQ(mg6010e_clear_health_fault(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 100), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, 100);
+    MG6010E_CHECK_EQ(mg6010e_get_health(1, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, 0);
+}
+
+/**
+ * @brief 低压锁存UNDERVOLTAGE并停止、抱闸；过温锁存OVERTEMP并关闭电机；errorState只回调不动作
+ */
+static void mg6010e_test_feedback_faults(void)
+{
+    mg6010e_test_setup();
+    mg6010e_health_config_t brake = {.min_voltage = 2000, .reaction = MG6010E_HEALTH_REACT_BRAKE};
+    mg6010e_health_config_t disable = {.max_temperature = 60, .reaction = MG6010E_HEALTH_REACT_DISABLE};
+    mg6010e_health_config_t notify = {.error_mask = 0x08, .reaction = MG6010E_HEALTH_REACT_NONE};
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(2, &brake), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(3, &disable), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(4, &notify), MG6010E_SUCCESS);
+    mg6010e_health_config_t invalid = {.reaction = MG6010E_HEALTH_REACT_BRAKE + 1};
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(1, &invalid), MG6010E_ERROR_INVALID_PARAM);
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(20, &notify), MG6010E_ERROR_NOT_INITIALIZED);
+
+    // 条件正常时不锁存
+    for (uint8_t id = 2; id <= 4; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ(mg6010e_test_callbacks, 0);
+
+    mg6010e_sim_motor(&mg6010e_test_sim, 2)->voltage = 1900;
+    mg6010e_sim_motor(&mg6010e_test_sim, 3)->temperature = 70.5f;
+    mg6010e_sim_motor(&mg6010e_test_sim, 4)->error_state = 0x08;
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(2), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_2(3), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(4), MG6010E_SUCCESS);
+    mg6010e_test_run(3);
+
+    mg6010e_health_t health;
+    MG6010E_CHECK_EQ(mg6010e_get_health(2, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, MG6010E_HEALTH_UNDERVOLTAGE);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 2)->stopped, 1);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 2)->brake, 0);
+    MG6010E_CHECK_EQ(mg6010e_get_health(3, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, MG6010E_HEALTH_OVERTEMP);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 3)->motor_state, 0x10);
+    MG6010E_CHECK_EQ(mg6010e_get_health(4, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, MG6010E_HEALTH_ERROR_STATE);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 4)->stopped, 0);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 4)->motor_state, 0);
+    MG6010E_CHECK_EQ(mg6010e_test_callbacks, 3);
+    MG6010E_CHECK_EQ(mg6010e_test_callback_motor, 4);
+    MG6010E_CHECK_EQ(mg6010e_test_callback_faults, MG6010E_HEALTH_ERROR_STATE);
+
+    // 已锁存的故障再次出现不再回调或动作
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(4), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ(mg6010e_test_callbacks, 3);
+    MG6010E_CHECK_EQ(mg6010e_get_health(4, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.trips, 1);
+
+    // 条件仍存在时清除后再次锁存
+    MG6010E_CHECK_EQ(mg6010e_clear_health_fault(4), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(4), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ(mg6010e_get_health(4, &health), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(health.faults, MG6010E_HEALTH_ERROR_STATE);
+    MG6010E_CHECK_EQ(health.trips, 2);
+    mg6010e_sim_motor(&mg6010e_test_sim, 4)->error_state = 0;
+}
+
+/**
+ * @brief 故障锁存的电机不进入命令组，也不计入0x280广播帧，其余电机照常发送
+ */
+static void mg6010e_test_group_and_broadcast(void)
+{
+    mg6010e_test_setup();
+    mg6010e_health_config_t config = {.error_mask = 0x01, .reaction = MG6010E_HEALTH_REACT_STOP}; // 只有配置了故障动作的电机拒绝控制命令
+    MG6010E_CHECK_EQ(mg6010e_set_health_config(1, &config), MG6010E_SUCCESS);
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->error_state = 0x01;
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(1), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->error_state = 0;
+
+    MG6010E_CHECK_EQ(mg6010e_group_begin(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 11), MG6010E_ERROR_FAULT);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, 22), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_group_commit(), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, 0);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 2)->target, 22);
+    mg6010e_group_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_group_get_stats(&stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.motors, 1);
+    MG6010E_CHECK_EQ(stats.replies, 1);
+
+    static const uint8_t motor_ids[] = {1, 2, 3, 4};
+    static const int16_t iqs[] = {-10, -20, -30, -40};
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group(motor_ids, iqs, 4), MG6010E_ERROR_FAULT);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, 0);
+    for (uint8_t id = 2; id <= 4; id++)
+    {
+        MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, id)->target, -10 * id);
+    }
+
+    MG6010E_CHECK_EQ(mg6010e_clear_health_fault(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group(motor_ids, iqs, 4), MG6010E_SUCCESS);
+    mg6010e_test_run(2);
+    MG6010E_CHECK_EQ((int32_t)mg6010e_sim_motor(&mg6010e_test_sim, 1)->target, -10);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_stale);
+    MG6010E_TEST_RUN(mg6010e_test_feedback_faults);
+    MG6010E_TEST_RUN(mg6010e_test_group_and_broadcast);
+    return MG6010E_TEST_RESULT();
+}
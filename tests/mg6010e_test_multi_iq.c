@@ -0,0 +1,133 @@
+/**
+ * @file mg6010e_test_multi_iq.c
+ * @brief 多电机转矩电流命令（mg6010e_iq_control_group）测试：同一总线上的1~4号电机合并为一帧0x280广播命令，
+ * 未初始化的ID不影响合并，已初始化但未包含的电机使合并退回逐个发送0xA1
+ */
+#include "mg6010e_test.h"
+
+static mg6010e_sim_stats_t mg6010e_test_stats;
+static uint32_t mg6010e_test_last[6]; // 各电机最近一次转矩电流反馈的时间戳
+
+/**
+ * @brief 推进5ms，返回期间上位机发出的帧数，并通过reply输出电机回复的帧数
+ */
+static uint32_t mg6010e_test_frames(uint32_t *reply)
+{
+    mg6010e_test_advance(5000);
+    mg6010e_sim_stats_t stats;
+    mg6010e_sim_get_stats(&mg6010e_test_sim, &stats);
+    uint32_t frames = stats.frames_tx - mg6010e_test_stats.frames_tx;
+    *reply = stats.frames_rx - mg6010e_test_stats.frames_rx;
+    mg6010e_test_stats = stats;
+    return frames;
+}
+
+static void mg6010e_test_setup(uint8_t motor_num)
+{
+    mg6010e_test_sim_setup(motor_num);
+    uint32_t reply;
+    mg6010e_test_frames(&reply);
+    for (uint8_t id = 1; id <= motor_num; id++)
+    {
+        mg6010e_status_t status;
+        mg6010e_status_time_t time;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &time), MG6010E_SUCCESS);
+        mg6010e_test_last[id - 1] = time.iqActual;
+    }
+}
+
+/**
+ * @brief 检查仿真电机处于转矩电流模式且目标值为iq，驱动已解析其新的回复
+ */
+static void mg6010e_test_check_iq(uint8_t id, int16_t iq)
+{
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, id)->mode, MG6010E_SIM_MODE_IQ);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim, id)->target == (float)iq);
+    mg6010e_status_t status;
+    mg6010e_status_time_t time;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &time), MG6010E_SUCCESS);
+    MG6010E_CHECK(time.iqActual != mg6010e_test_last[id - 1]);
+    mg6010e_test_last[id - 1] = time.iqActual;
+}
+
+/**
+ * @brief 4个电机按任意顺序传入，合并为一帧，每个电机按自身ID取得对应的转矩电流并各自回复
+ */
+static void mg6010e_test_pack(void)
+{
+    mg6010e_test_setup(4);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){3, 1, 4, 2}, (const int16_t[]){30, -10, -2048, 2000}, 4), MG6010E_SUCCESS);
+    uint32_t reply;
+    MG6010E_CHECK_EQ(mg6010e_test_frames(&reply), 1);
+    MG6010E_CHECK_EQ(reply, 4);
+    mg6010e_test_check_iq(1, -10);
+    mg6010e_test_check_iq(2, 2000);
+    mg6010e_test_check_iq(3, 30);
+    mg6010e_test_check_iq(4, -2048);
+}
+
+/**
+ * @brief 1~6号电机：1~4号合并为一帧，5、6号逐个发送
+ */
+static void mg6010e_test_overflow(void)
+{
+    mg6010e_test_setup(6);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){1, 2, 3, 4, 5, 6}, (const int16_t[]){1, 2, 3, 4, 5, 6}, 6), MG6010E_SUCCESS);
+    uint32_t reply;
+    MG6010E_CHECK_EQ(mg6010e_test_frames(&reply), 3);
+    MG6010E_CHECK_EQ(reply, 6);
+    for (uint8_t id = 1; id <= 6; id++)
+    {
+        mg6010e_test_check_iq(id, id);
+    }
+}
+
+/**
+ * @brief 3号电机未初始化：1、2、4号仍合并为一帧，广播帧中3号的位置为0
+ */
+static void mg6010e_test_uninitialized(void)
+{
+    mg6010e_test_setup(4);
+    MG6010E_CHECK_EQ(mg6010e_deinit(3), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){1, 2, 4}, (const int16_t[]){100, 200, 400}, 3), MG6010E_SUCCESS);
+    uint32_t reply;
+    MG6010E_CHECK_EQ(mg6010e_test_frames(&reply), 1);
+    MG6010E_CHECK_EQ(reply, 4); // 仿真中的3号电机同样回复，驱动忽略
+    mg6010e_test_check_iq(1, 100);
+    mg6010e_test_check_iq(2, 200);
+    mg6010e_test_check_iq(4, 400);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim, 3)->target == 0.0f);
+
+    // 包含未初始化的电机时不发送任何帧
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){1, 3}, (const int16_t[]){1, 3}, 2), MG6010E_ERROR_NOT_INITIALIZED);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(&reply), 0);
+}
+
+/**
+ * @brief 3、4号电机已初始化但未包含在本次调用中：广播帧会改变它们的设定值，因此1、2号逐个发送，3、4号保持原设定值
+ */
+static void mg6010e_test_missing(void)
+{
+    mg6010e_test_setup(4);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(3, 300), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_speed_control(4, 500, 36000), MG6010E_SUCCESS);
+    uint32_t reply;
+    mg6010e_test_frames(&reply);
+
+    MG6010E_CHECK_EQ(mg6010e_iq_control_group((const uint8_t[]){2, 1}, (const int16_t[]){-20, -10}, 2), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_test_frames(&reply), 2);
+    MG6010E_CHECK_EQ(reply, 2);
+    mg6010e_test_check_iq(1, -10);
+    mg6010e_test_check_iq(2, -20);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim, 3)->target == 300.0f);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim, 4)->mode, MG6010E_SIM_MODE_SPEED);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_pack);
+    MG6010E_TEST_RUN(mg6010e_test_overflow);
+    MG6010E_TEST_RUN(mg6010e_test_uninitialized);
+    MG6010E_TEST_RUN(mg6010e_test_missing);
+    return MG6010E_TEST_RESULT();
+}
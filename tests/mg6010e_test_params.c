@@ -0,0 +1,146 @@
+/**
+ * @file mg6010e_test_params.c
+ * @brief 控制参数快照与恢复（MG6010E_USE_PARAMS_SNAPSHOT）测试
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 8
+
+static uint8_t mg6010e_test_blob[MG6010E_PARAMS_BLOB_SIZE(MG6010E_TEST_MOTOR_NUM)];
+
+/**
+ * @brief 推进快照或恢复直至结束，返回mg6010e_params_poll的结果
+ */
+static uint8_t mg6010e_test_params_run(void)
+{
+    uint8_t result = MG6010E_ERROR_BUSY;
+    for (uint32_t t = 0; t < 2000000 && result == MG6010E_ERROR_BUSY; t += 100)
+    {
+        mg6010e_test_advance(100);
+        result = mg6010e_params_poll();
+    }
+    return result;
+}
+
+/**
+ * @brief 为每个仿真电机写入不同的参数，便于核对快照内容
+ */
+static void mg6010e_test_fill_params(void)
+{
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_sim_motor_t *motor = mg6010e_sim_motor(&mg6010e_test_sim, id);
+        for (uint32_t k = 0; k < MG6010E_PARAMS_NUM; k++)
+        {
+            for (uint32_t b = 0; b < 6; b++)
+            {
+                motor->params[k][b] = (uint8_t)(id * 16 + k * 6 + b);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 快照读取所有电机的全部参数，导出的记录与电机中的参数一致
+ */
+static void mg6010e_test_snapshot(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_test_fill_params();
+    MG6010E_CHECK_EQ(mg6010e_params_poll(), MG6010E_ERROR_NOT_INITIALIZED);
+    MG6010E_CHECK_EQ(mg6010e_snapshot_params_all(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_snapshot_params_all(), MG6010E_ERROR_BUSY);
+    uint32_t length = 0;
+    MG6010E_CHECK_EQ(mg6010e_params_serialize(mg6010e_test_blob, sizeof(mg6010e_test_blob), &length), MG6010E_ERROR_BUSY);
+    MG6010E_CHECK_EQ(mg6010e_test_params_run(), MG6010E_SUCCESS);
+
+    mg6010e_params_progress_t progress;
+    MG6010E_CHECK_EQ(mg6010e_params_get_progress(&progress), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(progress.motors, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(progress.total, MG6010E_TEST_MOTOR_NUM * MG6010E_PARAMS_NUM);
+    MG6010E_CHECK_EQ(progress.done, progress.total);
+    MG6010E_CHECK_EQ(progress.failed, 0);
+
+    MG6010E_CHECK_EQ(mg6010e_params_serialize(mg6010e_test_blob, sizeof(mg6010e_test_blob) - 1, &length), MG6010E_ERROR_INVALID_PARAM);
+    MG6010E_CHECK_EQ(mg6010e_params_serialize(mg6010e_test_blob, sizeof(mg6010e_test_blob), &length), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(length, MG6010E_PARAMS_BLOB_SIZE(MG6010E_TEST_MOTOR_NUM));
+    MG6010E_CHECK_EQ(mg6010e_test_blob[0] | (mg6010e_test_blob[1] << 8) | (mg6010e_test_blob[2] << 16) | ((uint32_t)mg6010e_test_blob[3] << 24), MG6010E_PARAMS_MAGIC);
+    MG6010E_CHECK_EQ(mg6010e_test_blob[4], MG6010E_PARAMS_VERSION);
+    MG6010E_CHECK_EQ(mg6010e_test_blob[5], MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        const uint8_t *record = mg6010e_test_blob + MG6010E_PARAMS_HEADER_SIZE + (id - 1) * MG6010E_PARAMS_RECORD_SIZE;
+        MG6010E_CHECK_EQ(record[0], MG6010E_MOTOR(0, id));
+        MG6010E_CHECK(memcmp(record + 1, mg6010e_sim_motor(&mg6010e_test_sim, id)->params, MG6010E_PARAMS_NUM * 6) == 0);
+        // 读取的参数同时写入句柄
+        mg6010e_control_params_t params;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_control_params(id, &params), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(params.anglekp, record[1] | (record[2] << 8));
+    }
+}
+
+/**
+ * @brief 恢复将快照写回被改动的电机并读回校验；截断、损坏的快照被拒绝
+ */
+static void mg6010e_test_restore(void)
+{
+    // 沿用mg6010e_test_snapshot导出的快照
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        memset(mg6010e_sim_motor(&mg6010e_test_sim, id)->params, 0x5A, MG6010E_PARAMS_NUM * 6);
+    }
+    uint32_t length = MG6010E_PARAMS_BLOB_SIZE(MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_restore_params_all(NULL, length), MG6010E_ERROR_CONFIG_NULL_PTR);
+    MG6010E_CHECK_EQ(mg6010e_restore_params_all(mg6010e_test_blob, length - 1), MG6010E_ERROR_INVALID_PARAM);
+    mg6010e_test_blob[MG6010E_PARAMS_HEADER_SIZE + 3] ^= 0x01;
+    MG6010E_CHECK_EQ(mg6010e_restore_params_all(mg6010e_test_blob, length), MG6010E_ERROR_INVALID_PARAM);
+    mg6010e_test_blob[MG6010E_PARAMS_HEADER_SIZE + 3] ^= 0x01;
+
+    MG6010E_CHECK_EQ(mg6010e_restore_params_all(mg6010e_test_blob, length), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_test_params_run(), MG6010E_SUCCESS);
+    mg6010e_params_progress_t progress;
+    MG6010E_CHECK_EQ(mg6010e_params_get_progress(&progress), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(progress.done, MG6010E_TEST_MOTOR_NUM * MG6010E_PARAMS_NUM);
+    MG6010E_CHECK_EQ(progress.mismatched, 0);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        const uint8_t *record = mg6010e_test_blob + MG6010E_PARAMS_HEADER_SIZE + (id - 1) * MG6010E_PARAMS_RECORD_SIZE;
+        MG6010E_CHECK(memcmp(record + 1, mg6010e_sim_motor(&mg6010e_test_sim, id)->params, MG6010E_PARAMS_NUM * 6) == 0);
+    }
+    // 恢复之后不能导出快照
+    MG6010E_CHECK_EQ(mg6010e_params_serialize(mg6010e_test_blob, sizeof(mg6010e_test_blob), &length), MG6010E_ERROR_NOT_INITIALIZED);
+}
+
+/**
+ * @brief 掉线电机的参数重发后仍无回复，快照以超时结束，导出时不包含该电机
+ */
+static void mg6010e_test_offline(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_test_fill_params();
+    mg6010e_sim_motor(&mg6010e_test_sim, 5)->online = 0;
+    MG6010E_CHECK_EQ(mg6010e_snapshot_params_all(), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_test_params_run(), MG6010E_ERROR_TIMEOUT);
+    mg6010e_params_progress_t progress;
+    MG6010E_CHECK_EQ(mg6010e_params_get_progress(&progress), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(progress.failed, MG6010E_PARAMS_NUM);
+    MG6010E_CHECK_EQ(progress.done, (MG6010E_TEST_MOTOR_NUM - 1) * MG6010E_PARAMS_NUM);
+
+    uint32_t length = 0;
+    MG6010E_CHECK_EQ(mg6010e_params_serialize(mg6010e_test_blob, sizeof(mg6010e_test_blob), &length), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(length, MG6010E_PARAMS_BLOB_SIZE(MG6010E_TEST_MOTOR_NUM - 1));
+    MG6010E_CHECK_EQ(mg6010e_test_blob[5], MG6010E_TEST_MOTOR_NUM - 1);
+    for (uint32_t i = 0; i < MG6010E_TEST_MOTOR_NUM - 1; i++)
+    {
+        MG6010E_CHECK(mg6010e_test_blob[MG6010E_PARAMS_HEADER_SIZE + i * MG6010E_PARAMS_RECORD_SIZE] != MG6010E_MOTOR(0, 5));
+    }
+    mg6010e_sim_motor(&mg6010e_test_sim, 5)->online = 1;
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_snapshot);
+    MG6010E_TEST_RUN(mg6010e_test_restore);
+    MG6010E_TEST_RUN(mg6010e_test_offline);
+    return MG6010E_TEST_RESULT();
+}
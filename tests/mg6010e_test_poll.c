@@ -0,0 +1,129 @@
+/**
+ * @file mg6010e_test_poll.c
+ * @brief 自动轮询（MG6010E_USE_POLL_SCHEDULER）测试：各电机的读取请求交错发出、按注册频率得到回复，超出总线容量时限量发出且各电机的回复数均衡
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_MAX 16
+
+static uint32_t mg6010e_test_replies[MG6010E_TEST_MOTOR_MAX]; // 各电机收到的状态2回复数
+static uint32_t mg6010e_test_last[MG6010E_TEST_MOTOR_MAX];    // 各电机最近一次状态2回复的时间戳
+static uint32_t mg6010e_test_max_frames;                      // 单个tick内发出的最大帧数
+
+/**
+ * @brief 以MG6010E_POLL_TICK_HZ调用mg6010e_poll_tick推进ms毫秒，统计每个tick发出的帧数与各电机的回复数
+ */
+static void mg6010e_test_run(uint8_t motor_num, uint32_t ms)
+{
+    mg6010e_sim_stats_t before;
+    mg6010e_sim_get_stats(&mg6010e_test_sim, &before);
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        mg6010e_poll_tick();
+        mg6010e_test_advance(1000000 / MG6010E_POLL_TICK_HZ);
+        mg6010e_sim_stats_t after;
+        mg6010e_sim_get_stats(&mg6010e_test_sim, &after);
+        uint32_t frames = after.frames_tx - before.frames_tx;
+        mg6010e_test_max_frames = frames > mg6010e_test_max_frames ? frames : mg6010e_test_max_frames;
+        before = after;
+        for (uint8_t id = 1; id <= motor_num; id++)
+        {
+            mg6010e_status_t status;
+            mg6010e_status_time_t time;
+            MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &time), MG6010E_SUCCESS);
+            if (time.speed != mg6010e_test_last[id - 1])
+            {
+                mg6010e_test_last[id - 1] = time.speed;
+                mg6010e_test_replies[id - 1]++;
+            }
+        }
+    }
+}
+
+static void mg6010e_test_setup(uint8_t motor_num, uint16_t rate_hz)
+{
+    mg6010e_test_sim_setup(motor_num);
+    for (uint8_t id = 1; id <= motor_num; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_poll_register(id, MG6010E_POLL_STATUS_2, rate_hz), MG6010E_SUCCESS);
+    }
+    mg6010e_test_run(motor_num, 100); // 越过第一个周期
+    memset(mg6010e_test_replies, 0, sizeof(mg6010e_test_replies));
+    mg6010e_test_max_frames = 0;
+}
+
+static void mg6010e_test_teardown(uint8_t motor_num)
+{
+    for (uint8_t id = 1; id <= motor_num; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_poll_register(id, MG6010E_POLL_STATUS_2, 0), MG6010E_SUCCESS);
+    }
+}
+
+/**
+ * @brief 8个电机各250Hz：相位错开，每个tick只发出2帧，每个电机1s内恰好收到250次回复
+ */
+static void mg6010e_test_stagger(void)
+{
+    mg6010e_test_setup(8, 250);
+    mg6010e_test_run(8, 1000);
+    MG6010E_CHECK_EQ(mg6010e_test_max_frames, 2);
+    for (uint8_t id = 1; id <= 8; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_test_replies[id - 1], 250);
+    }
+    mg6010e_test_teardown(8);
+}
+
+/**
+ * @brief 不同频率混合注册：每个电机仍按各自频率得到回复，每个tick的帧数不超过平均值向上取整
+ */
+static void mg6010e_test_mixed(void)
+{
+    static const uint16_t rates[6] = {500, 250, 250, 100, 100, 50};
+    mg6010e_test_sim_setup(6);
+    for (uint8_t id = 1; id <= 6; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_poll_register(id, MG6010E_POLL_STATUS_2, rates[id - 1]), MG6010E_SUCCESS);
+    }
+    mg6010e_test_run(6, 100);
+    memset(mg6010e_test_replies, 0, sizeof(mg6010e_test_replies));
+    mg6010e_test_max_frames = 0;
+    mg6010e_test_run(6, 1000);
+    MG6010E_CHECK_EQ(mg6010e_test_max_frames, 2); // 共1250次/s
+    for (uint8_t id = 1; id <= 6; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_test_replies[id - 1], rates[id - 1]);
+    }
+    mg6010e_test_teardown(6);
+}
+
+/**
+ * @brief 16个电机各500Hz（8000次/s）超出总线容量：每个tick发出的读取命令不超过总线容量，各电机回复数与平均值相差不超过5%
+ */
+static void mg6010e_test_overload(void)
+{
+    mg6010e_test_setup(MG6010E_TEST_MOTOR_MAX, 500);
+    mg6010e_test_run(MG6010E_TEST_MOTOR_MAX, 1000);
+    uint32_t total = 0;
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_MAX; id++)
+    {
+        total += mg6010e_test_replies[id - 1];
+    }
+    uint32_t mean = total / MG6010E_TEST_MOTOR_MAX;
+    MG6010E_CHECK(total < MG6010E_TEST_MOTOR_MAX * 500); // 确实超出容量
+    MG6010E_CHECK(mg6010e_test_max_frames <= MG6010E_CAN_BITRATE / MG6010E_POLL_TICK_HZ / (2 * MG6010E_CAN_FRAME_BITS_MAX(8)));
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_MAX; id++)
+    {
+        MG6010E_CHECK(mg6010e_test_replies[id - 1] * 20 >= mean * 19 && mg6010e_test_replies[id - 1] * 20 <= mean * 21);
+    }
+    mg6010e_test_teardown(MG6010E_TEST_MOTOR_MAX);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_stagger);
+    MG6010E_TEST_RUN(mg6010e_test_mixed);
+    MG6010E_TEST_RUN(mg6010e_test_overload);
+    return MG6010E_TEST_RESULT();
+}
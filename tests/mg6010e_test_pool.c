@@ -0,0 +1,108 @@
+/**
+ * @file mg6010e_test_pool.c
+ * @brief 句柄池测试：MG6010E_MAX_MOTOR_NUM个句柄用完后初始化失败，注销释放句柄供其他总线使用，同一总线上可重新初始化
+ */
+#include "mg6010e_test.h"
+
+static mg6010e_sim_t mg6010e_test_sim_2; // 第二条仿真总线（第1条总线）
+
+/**
+ * @brief 在仿真总线上初始化电机
+ */
+static uint8_t mg6010e_test_init(mg6010e_sim_t *sim, uint8_t id)
+{
+    mg6010e_config_t config = {.can_handle = sim, .motor_id = id};
+    return mg6010e_init(&config);
+}
+
+/**
+ * @brief 读取状态2并推进5ms，返回读取的结果，电机已回复时status_time非0
+ */
+static uint8_t mg6010e_test_read(uint8_t motor_id, mg6010e_status_time_t *time)
+{
+    uint8_t ret = mg6010e_read_status_2(motor_id);
+    mg6010e_test_advance(5000);
+    mg6010e_status_t status;
+    *time = (mg6010e_status_time_t){0};
+    mg6010e_get_motor_status_time(motor_id, &status, time);
+    return ret;
+}
+
+/**
+ * @brief 总线0上初始化32个电机用完句柄池：总线1上的电机初始化失败，已初始化的电机仍可重新初始化
+ */
+static void mg6010e_test_exhaust(void)
+{
+    mg6010e_test_sim_setup(MG6010E_MAX_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_sim_init(&mg6010e_test_sim_2), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 1), MG6010E_ERROR_NO_RESOURCE);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(MG6010E_MOTOR(1, 1), 100), MG6010E_ERROR_NOT_INITIALIZED);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim, MG6010E_MAX_MOTOR_NUM), MG6010E_SUCCESS); // 沿用原句柄
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 1), MG6010E_ERROR_NO_RESOURCE);
+
+    // 总线表已满时新的CAN句柄无法注册
+    mg6010e_sim_t other;
+    MG6010E_CHECK_EQ(mg6010e_test_init(&other, 1), MG6010E_ERROR_NO_RESOURCE);
+}
+
+/**
+ * @brief 注销释放句柄：注销后命令与读取返回未初始化、反馈被忽略，释放的句柄可用于总线1上的电机
+ */
+static void mg6010e_test_release(void)
+{
+    mg6010e_test_sim_setup(MG6010E_MAX_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_sim_init(&mg6010e_test_sim_2), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_deinit(5), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_deinit(5), MG6010E_ERROR_NOT_INITIALIZED);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(5, 100), MG6010E_ERROR_NOT_INITIALIZED);
+    mg6010e_status_t status;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(5, &status), MG6010E_ERROR_NOT_INITIALIZED);
+
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 2), MG6010E_ERROR_NO_RESOURCE);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(MG6010E_MOTOR(1, 1), 100), MG6010E_SUCCESS);
+    mg6010e_test_advance(5000);
+    MG6010E_CHECK_EQ(mg6010e_sim_motor(&mg6010e_test_sim_2, 1)->mode, MG6010E_SIM_MODE_IQ);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim_2, 1)->target == 100.0f);
+    MG6010E_CHECK(mg6010e_sim_motor(&mg6010e_test_sim, 1)->target == 0.0f); // 同ID的另一总线上的电机不受影响
+    mg6010e_status_time_t time;
+    MG6010E_CHECK_EQ(mg6010e_test_read(MG6010E_MOTOR(1, 1), &time), MG6010E_SUCCESS);
+    MG6010E_CHECK(time.speed != 0);
+    MG6010E_CHECK_EQ(mg6010e_deinit(MG6010E_MOTOR(1, 1)), MG6010E_SUCCESS);
+}
+
+/**
+ * @brief 同一总线上注销后重新初始化：之前的反馈数据被清除，之后的回复照常解析，不多占用句柄
+ */
+static void mg6010e_test_reinit(void)
+{
+    mg6010e_test_sim_setup(MG6010E_MAX_MOTOR_NUM);
+    MG6010E_CHECK_EQ(mg6010e_sim_init(&mg6010e_test_sim_2), MG6010E_SUCCESS);
+    mg6010e_status_time_t time;
+    MG6010E_CHECK_EQ(mg6010e_test_read(5, &time), MG6010E_SUCCESS);
+    MG6010E_CHECK(time.speed != 0);
+
+    MG6010E_CHECK_EQ(mg6010e_deinit(5), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_2(5), MG6010E_ERROR_NOT_INITIALIZED);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim, 5), MG6010E_SUCCESS);
+    mg6010e_status_t status;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(5, &status, &time), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(time.speed, 0);
+    MG6010E_CHECK_EQ(mg6010e_test_read(5, &time), MG6010E_SUCCESS);
+    MG6010E_CHECK(time.speed != 0);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 1), MG6010E_ERROR_NO_RESOURCE);
+
+    // 未注销时重新初始化同样清除反馈数据
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim, 5), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(5, &status, &time), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(time.speed, 0);
+    MG6010E_CHECK_EQ(mg6010e_test_init(&mg6010e_test_sim_2, 1), MG6010E_ERROR_NO_RESOURCE);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_exhaust);
+    MG6010E_TEST_RUN(mg6010e_test_release);
+    MG6010E_TEST_RUN(mg6010e_test_reinit);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file mg6010e_test_recorder.c
+ * @brief 遥测记录（MG6010E_USE_RECORDER）测试：以tools/mg6010e_record_decode.c的解析函数还原仿真中记录的反馈，
+ * 检查每条记录的数据与时间戳，以及缓冲区满时的丢弃计数与重新同步
+ */
+#define MG6010E_RECORD_DECODE_NO_MAIN
+#include "tools/mg6010e_record_decode.c"
+#include "mg6010e_test.h"
+#include <stdlib.h>
+
+#define MG6010E_TEST_MOTOR_NUM 4
+#define MG6010E_TEST_FRAME_MAX 1024 // 每个电机最多记录的反馈数
+#define MG6010E_TEST_EXPORT_SIZE 65536
+
+// 驱动解析后的一条状态2反馈
+typedef struct mg6010e_test_feedback
+{
+    uint32_t time;
+    int8_t temperature;
+    int16_t iq;
+    int16_t speed;
+    uint16_t encoder;
+} mg6010e_test_feedback_t;
+
+static mg6010e_test_feedback_t mg6010e_test_expected[MG6010E_TEST_MOTOR_NUM][MG6010E_TEST_FRAME_MAX];
+static uint32_t mg6010e_test_expected_num[MG6010E_TEST_MOTOR_NUM];
+static uint8_t mg6010e_test_export[MG6010E_TEST_EXPORT_SIZE];
+static uint32_t mg6010e_test_export_length;
+
+/**
+ * @brief 以1kHz读取各电机的状态2，记下驱动解析出的每条反馈；export为1时每周期导出记录
+ */
+static void mg6010e_test_run(uint32_t ms, uint8_t export)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+        {
+            MG6010E_CHECK_EQ(mg6010e_read_status_2(id), MG6010E_SUCCESS);
+        }
+        mg6010e_test_advance(1000);
+        for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+        {
+            mg6010e_status_t status;
+            mg6010e_status_time_t time;
+            MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &status, &time), MG6010E_SUCCESS);
+            uint32_t *num = &mg6010e_test_expected_num[id - 1];
+            if (*num < MG6010E_TEST_FRAME_MAX && (*num == 0 || mg6010e_test_expected[id - 1][*num - 1].time != time.encoder))
+            {
+                mg6010e_test_expected[id - 1][(*num)++] = (mg6010e_test_feedback_t){time.encoder, status.temperature, status.iqActual, status.speed, status.encoder};
+            }
+        }
+        if (export)
+        {
+            mg6010e_test_export_length += mg6010e_recorder_read(mg6010e_test_export + mg6010e_test_export_length, MG6010E_TEST_EXPORT_SIZE - mg6010e_test_export_length);
+        }
+    }
+}
+
+static void mg6010e_test_start(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(id, (int16_t)(100 * id)), MG6010E_SUCCESS); // 各电机以不同速度加速，反馈逐帧变化
+    }
+    mg6010e_test_advance(1000);
+    memset(mg6010e_test_expected_num, 0, sizeof(mg6010e_test_expected_num));
+    mg6010e_test_export_length = 0;
+    mg6010e_recorder_start();
+}
+
+/**
+ * @brief 导出剩余记录并解析，逐条与驱动解析的反馈比较
+ *
+ * @param skipped 输出记录中缺少的反馈数
+ * @param decoded 解析统计输出
+ */
+static void mg6010e_test_decode(uint32_t *skipped, decode_stats_t *decoded)
+{
+    mg6010e_recorder_stop();
+    uint32_t length;
+    while ((length = mg6010e_recorder_read(mg6010e_test_export + mg6010e_test_export_length, MG6010E_TEST_EXPORT_SIZE - mg6010e_test_export_length)) != 0)
+    {
+        mg6010e_test_export_length += length;
+    }
+    FILE *input = tmpfile();
+    FILE *output = tmpfile();
+    MG6010E_CHECK(input != NULL && output != NULL);
+    if (input == NULL || output == NULL)
+    {
+        return;
+    }
+    fwrite(mg6010e_test_export, 1, mg6010e_test_export_length, input);
+    rewind(input);
+    MG6010E_CHECK_EQ(decode_stream(input, output, decoded), 0);
+    MG6010E_CHECK_EQ(decoded->bytes, mg6010e_test_export_length);
+    rewind(output);
+
+    char line[256];
+    MG6010E_CHECK(fgets(line, sizeof(line), output) != NULL); // 表头
+    uint32_t next[MG6010E_TEST_MOTOR_NUM] = {0};
+    *skipped = 0;
+    while (fgets(line, sizeof(line), output) != NULL)
+    {
+        // time_us,bus,motor,opcode,temperature,voltage,current,motor_state,error_state,iq,speed,encoder,...
+        long long column[12] = {0};
+        char *field = line;
+        for (uint32_t i = 0; i < 12 && field != NULL; i++)
+        {
+            column[i] = strtoll(field, NULL, 0);
+            field = strchr(field, ',');
+            field = field != NULL ? field + 1 : NULL;
+        }
+        MG6010E_CHECK_EQ(column[1], 0);
+        MG6010E_CHECK(column[2] >= 1 && column[2] <= MG6010E_TEST_MOTOR_NUM);
+        MG6010E_CHECK_EQ(column[3], 0x9C);
+        if (column[2] < 1 || column[2] > MG6010E_TEST_MOTOR_NUM)
+        {
+            continue;
+        }
+        uint32_t motor = (uint32_t)column[2] - 1;
+        while (next[motor] < mg6010e_test_expected_num[motor] && mg6010e_test_expected[motor][next[motor]].time != (uint32_t)column[0])
+        {
+            next[motor]++; // 记录时被丢弃的反馈
+            (*skipped)++;
+        }
+        MG6010E_CHECK(next[motor] < mg6010e_test_expected_num[motor]);
+        if (next[motor] >= mg6010e_test_expected_num[motor])
+        {
+            continue;
+        }
+        const mg6010e_test_feedback_t *expected = &mg6010e_test_expected[motor][next[motor]++];
+        MG6010E_CHECK_EQ(column[4], expected->temperature);
+        MG6010E_CHECK_EQ(column[9], expected->iq);
+        MG6010E_CHECK_EQ(column[10], expected->speed);
+        MG6010E_CHECK_EQ(column[11], expected->encoder);
+    }
+    for (uint32_t motor = 0; motor < MG6010E_TEST_MOTOR_NUM; motor++)
+    {
+        *skipped += mg6010e_test_expected_num[motor] - next[motor];
+    }
+    fclose(input);
+    fclose(output);
+}
+
+/**
+ * @brief 每周期导出时不丢弃记录，解析出的每条反馈及其时间戳与驱动解析的一致
+ */
+static void mg6010e_test_round_trip(void)
+{
+    mg6010e_test_start();
+    mg6010e_test_run(100, 1);
+    uint32_t skipped;
+    decode_stats_t decoded;
+    mg6010e_test_decode(&skipped, &decoded);
+
+    mg6010e_recorder_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_recorder_stats(&mg6010e_test_sim, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.dropped, 0);
+    MG6010E_CHECK_EQ(stats.records, 100 * MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(decoded.records, stats.records);
+    MG6010E_CHECK_EQ(decoded.syncs, 1);
+    MG6010E_CHECK_EQ(decoded.dropped, 0);
+    MG6010E_CHECK_EQ(decoded.unsynced, 0);
+    MG6010E_CHECK_EQ(decoded.bytes, MG6010E_RECORDER_HEADER_SIZE + stats.bytes);
+    MG6010E_CHECK_EQ(skipped, 0);
+}
+
+/**
+ * @brief 长时间不导出时缓冲区满，新记录被丢弃且计数；恢复导出后先写入同步记录，之后的记录仍能正确解析
+ */
+static void mg6010e_test_overflow(void)
+{
+    mg6010e_test_start();
+    mg6010e_test_run(300, 0);
+    mg6010e_recorder_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_recorder_stats(&mg6010e_test_sim, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK(stats.dropped > 0);
+    MG6010E_CHECK(stats.high_water <= MG6010E_RECORDER_SIZE && stats.high_water > MG6010E_RECORDER_SIZE - MG6010E_RECORDER_SYNC_SIZE - MG6010E_RECORDER_RECORD_MAX);
+    uint32_t dropped = stats.dropped;
+
+    mg6010e_test_export_length = mg6010e_recorder_read(mg6010e_test_export, MG6010E_TEST_EXPORT_SIZE);
+    MG6010E_CHECK(mg6010e_test_export_length > MG6010E_RECORDER_SIZE - MG6010E_RECORDER_SYNC_SIZE - MG6010E_RECORDER_RECORD_MAX);
+    mg6010e_test_run(50, 1);
+    uint32_t skipped;
+    decode_stats_t decoded;
+    mg6010e_test_decode(&skipped, &decoded);
+    MG6010E_CHECK_EQ(mg6010e_get_recorder_stats(&mg6010e_test_sim, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.dropped, dropped); // 恢复导出后不再丢弃
+    MG6010E_CHECK_EQ(stats.records + stats.dropped, 350 * MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(decoded.records, stats.records);
+    MG6010E_CHECK_EQ(decoded.syncs, 2);
+    MG6010E_CHECK_EQ(decoded.dropped, stats.dropped);
+    MG6010E_CHECK_EQ(decoded.bytes, MG6010E_RECORDER_HEADER_SIZE + stats.bytes);
+    MG6010E_CHECK_EQ(skipped, stats.dropped);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_round_trip);
+    MG6010E_TEST_RUN(mg6010e_test_overflow);
+    return MG6010E_TEST_RESULT();
+}
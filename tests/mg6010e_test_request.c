@@ -0,0 +1,143 @@
+/**
+ * @file mg6010e_test_request.c
+ * @brief 请求跟踪（MG6010E_USE_REQUEST_TRACKING）测试：回复完成请求并记录往返延迟，未回复的请求超时后回调并释放，控制类命令默认不登记
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 2
+#define MG6010E_TEST_TIMEOUT_US 5000
+
+// 最近一次回调的参数
+typedef struct mg6010e_test_request_result
+{
+    uint32_t calls;
+    uint8_t motor_id;
+    uint8_t cmd;
+    uint8_t param_id;
+    uint8_t result;
+    uint32_t latency_us;
+} mg6010e_test_request_result_t;
+
+static mg6010e_test_request_result_t mg6010e_test_result;
+static uint8_t mg6010e_test_resend; // 为1时在超时回调中向同一电机再次发送请求，占用刚释放的槽位
+
+static void mg6010e_test_callback(uint8_t motor_id, uint8_t cmd, uint8_t param_id, uint8_t result, uint32_t latency_us)
+{
+    mg6010e_test_result = (mg6010e_test_request_result_t){mg6010e_test_result.calls + 1, motor_id, cmd, param_id, result, latency_us};
+    if (mg6010e_test_resend && result == MG6010E_ERROR_TIMEOUT)
+    {
+        mg6010e_test_resend = 0;
+        MG6010E_CHECK_EQ(mg6010e_read_control_param(motor_id, 0x0B), MG6010E_SUCCESS);
+    }
+}
+
+/**
+ * @brief 收到回复的请求以result为0回调，往返延迟计入统计
+ */
+static void mg6010e_test_reply(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_set_request_callback(mg6010e_test_callback);
+    mg6010e_test_result = (mg6010e_test_request_result_t){0};
+    MG6010E_CHECK_EQ(mg6010e_reset_latency_stats(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_control_param(1, 0x0A), MG6010E_SUCCESS);
+    mg6010e_test_advance(2000);
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_result.motor_id, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_result.cmd, 0xC0);
+    MG6010E_CHECK_EQ(mg6010e_test_result.param_id, 0x0A);
+    MG6010E_CHECK_EQ(mg6010e_test_result.result, MG6010E_SUCCESS);
+    MG6010E_CHECK(mg6010e_test_result.latency_us > 0 && mg6010e_test_result.latency_us < 2000);
+    mg6010e_latency_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_latency_stats(1, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.count, 1);
+    MG6010E_CHECK_EQ(stats.timeouts, 0);
+    mg6010e_set_request_callback(NULL);
+}
+
+/**
+ * @brief 掉线电机的请求超时后以result为9回调，延迟为发送至检查的时间；回调中再次发送的请求占用释放的槽位，按自身的发送时间计时
+ */
+static void mg6010e_test_timeout(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_set_request_callback(mg6010e_test_callback);
+    mg6010e_set_request_timeout(MG6010E_TEST_TIMEOUT_US);
+    mg6010e_test_result = (mg6010e_test_request_result_t){0};
+    MG6010E_CHECK_EQ(mg6010e_reset_latency_stats(2), MG6010E_SUCCESS);
+    mg6010e_sim_motor(&mg6010e_test_sim, 2)->online = 0;
+
+    uint32_t sent = mg6010e_get_timestamp_us();
+    MG6010E_CHECK_EQ(mg6010e_read_control_param(2, 0x0A), MG6010E_SUCCESS);
+    mg6010e_test_advance(MG6010E_TEST_TIMEOUT_US / 2);
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 0);
+
+    mg6010e_test_advance(MG6010E_TEST_TIMEOUT_US);
+    uint32_t checked = mg6010e_get_timestamp_us();
+    mg6010e_test_resend = 1;
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_result.motor_id, 2);
+    MG6010E_CHECK_EQ(mg6010e_test_result.cmd, 0xC0);
+    MG6010E_CHECK_EQ(mg6010e_test_result.param_id, 0x0A);
+    MG6010E_CHECK_EQ(mg6010e_test_result.result, MG6010E_ERROR_TIMEOUT);
+    MG6010E_CHECK(mg6010e_test_result.latency_us >= MG6010E_TEST_TIMEOUT_US && mg6010e_test_result.latency_us <= checked - sent);
+
+    // 回调中发送的请求尚未超时
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 1);
+    mg6010e_test_advance(MG6010E_TEST_TIMEOUT_US + 1000);
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 2);
+    MG6010E_CHECK_EQ(mg6010e_test_result.param_id, 0x0B);
+    MG6010E_CHECK(mg6010e_test_result.latency_us >= MG6010E_TEST_TIMEOUT_US && mg6010e_test_result.latency_us < 2 * MG6010E_TEST_TIMEOUT_US);
+
+    mg6010e_latency_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_latency_stats(2, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.timeouts, 2);
+    MG6010E_CHECK_EQ(stats.count, 0);
+    mg6010e_sim_motor(&mg6010e_test_sim, 2)->online = 1;
+    mg6010e_set_request_callback(NULL);
+    mg6010e_set_request_timeout(MG6010E_REQUEST_TIMEOUT_US);
+}
+
+/**
+ * @brief 控制类命令默认不登记，发往掉线电机也不产生超时回调；开启后与读取命令一样超时
+ */
+static void mg6010e_test_setpoint(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_set_request_callback(mg6010e_test_callback);
+    mg6010e_set_request_timeout(MG6010E_TEST_TIMEOUT_US);
+    mg6010e_test_result = (mg6010e_test_request_result_t){0};
+    mg6010e_sim_motor(&mg6010e_test_sim, 2)->online = 0;
+    MG6010E_CHECK_EQ(mg6010e_set_request_tracking(MG6010E_CMD_CLASS_NUM, 1), MG6010E_ERROR_INVALID_PARAM);
+
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, 100), MG6010E_SUCCESS);
+    mg6010e_test_advance(2 * MG6010E_TEST_TIMEOUT_US);
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 0);
+
+    MG6010E_CHECK_EQ(mg6010e_set_request_tracking(MG6010E_CMD_CLASS_SETPOINT, 1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, 100), MG6010E_SUCCESS);
+    mg6010e_test_advance(2 * MG6010E_TEST_TIMEOUT_US);
+    mg6010e_request_check_timeout();
+    MG6010E_CHECK_EQ(mg6010e_test_result.calls, 1);
+    MG6010E_CHECK_EQ(mg6010e_test_result.motor_id, 2);
+    MG6010E_CHECK_EQ(mg6010e_test_result.cmd, 0xA1);
+    MG6010E_CHECK_EQ(mg6010e_test_result.result, MG6010E_ERROR_TIMEOUT);
+
+    MG6010E_CHECK_EQ(mg6010e_set_request_tracking(MG6010E_CMD_CLASS_SETPOINT, 0), MG6010E_SUCCESS);
+    mg6010e_sim_motor(&mg6010e_test_sim, 2)->online = 1;
+    mg6010e_set_request_callback(NULL);
+    mg6010e_set_request_timeout(MG6010E_REQUEST_TIMEOUT_US);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_reply);
+    MG6010E_TEST_RUN(mg6010e_test_timeout);
+    MG6010E_TEST_RUN(mg6010e_test_setpoint);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,221 @@
+/**
+ * @file mg6010e_test_rx_burst.c
+ * @brief 批量解析（mg6010e_can_rx_process_burst）与逐帧解析（mg6010e_can_rx_frame）结果一致性测试
+ * @note 随机帧覆盖所有命令字节、控制参数ID、未知命令字节、未初始化的电机与其他设备的ID。
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_FRAME_NUM 4096
+#define MG6010E_TEST_MOTOR_NUM 8
+#define MG6010E_TEST_BURST 37 // 不是MG6010E_RX_BURST_NUM的整数倍，覆盖不满一组的情况
+
+// 一个电机解析后的全部数据
+typedef struct mg6010e_test_state
+{
+    mg6010e_status_t status;
+    mg6010e_status_time_t status_time;
+    mg6010e_encoder_data_t encoder_data;
+    mg6010e_control_params_t control_params;
+} mg6010e_test_state_t;
+
+static mg6010e_can_frame_t mg6010e_test_frames[MG6010E_TEST_FRAME_NUM];
+
+/**
+ * @brief 线性同余伪随机数，结果可复现
+ */
+static uint32_t mg6010e_test_random(void)
+{
+    static uint32_t seed = 12345;
+    seed = seed * 1103515245U + 12345U;
+    return seed >> 8;
+}
+
+static void mg6010e_test_generate(void)
+{
+    static const uint8_t opcodes[] = {0x9A, 0x9B, 0x9C, 0x9D, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0x8C, 0xC0, 0xC1,
+                                      0x90, 0x19, 0x92, 0x94, 0x95, 0x80, 0x81, 0x88, 0x55, 0xFF};
+    static const uint8_t param_ids[] = {0x0A, 0x0B, 0x0C, 0x1E, 0x20, 0x22, 0x24, 0x26, 0x33};
+    static const uint16_t foreign_ids[] = {0x100, 0x140, 0x161, 0x280, 0x7FF};
+    for (uint32_t i = 0; i < MG6010E_TEST_FRAME_NUM; i++)
+    {
+        mg6010e_can_frame_t *frame = &mg6010e_test_frames[i];
+        uint32_t kind = mg6010e_test_random() % 16;
+        if (kind == 0)
+        {
+            frame->std_id = foreign_ids[mg6010e_test_random() % (sizeof(foreign_ids) / sizeof(foreign_ids[0]))];
+        }
+        else if (kind == 1)
+        {
+            frame->std_id = MG6010E_CAN_FEEDBACK_ID(20); // 未初始化的电机
+        }
+        else
+        {
+            frame->std_id = MG6010E_CAN_FEEDBACK_ID(1 + mg6010e_test_random() % MG6010E_TEST_MOTOR_NUM);
+        }
+        frame->dlc = 8;
+        for (uint32_t k = 0; k < 8; k++)
+        {
+            frame->data[k] = (uint8_t)mg6010e_test_random();
+        }
+        frame->data[0] = opcodes[mg6010e_test_random() % (sizeof(opcodes) / sizeof(opcodes[0]))];
+        if (frame->data[0] == 0xC0 || frame->data[0] == 0xC1)
+        {
+            frame->data[1] = param_ids[mg6010e_test_random() % (sizeof(param_ids) / sizeof(param_ids[0]))];
+        }
+    }
+}
+
+static void mg6010e_test_capture(mg6010e_test_state_t *states)
+{
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_test_state_t *state = &states[id - 1];
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status_time(id, &state->status, &state->status_time), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_get_motor_encoder_data(id, &state->encoder_data), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_get_motor_control_params(id, &state->control_params), MG6010E_SUCCESS);
+    }
+}
+
+#define MG6010E_TEST_SAME(a, b, field) MG6010E_CHECK_EQ((a)->field, (b)->field)
+
+static void mg6010e_test_compare(const mg6010e_test_state_t *a, const mg6010e_test_state_t *b)
+{
+    MG6010E_TEST_SAME(a, b, status.temperature);
+    MG6010E_TEST_SAME(a, b, status.voltage);
+    MG6010E_TEST_SAME(a, b, status.current);
+    MG6010E_TEST_SAME(a, b, status.motorState);
+    MG6010E_TEST_SAME(a, b, status.errorState);
+    MG6010E_TEST_SAME(a, b, status.iqActual);
+    MG6010E_TEST_SAME(a, b, status.speed);
+    MG6010E_TEST_SAME(a, b, status.encoder);
+    MG6010E_TEST_SAME(a, b, status.iA);
+    MG6010E_TEST_SAME(a, b, status.iB);
+    MG6010E_TEST_SAME(a, b, status.iC);
+    MG6010E_TEST_SAME(a, b, status.brakeStatus);
+    MG6010E_TEST_SAME(a, b, status.angle);
+    MG6010E_TEST_SAME(a, b, status.single_angle);
+    MG6010E_CHECK(memcmp(&a->status_time, &b->status_time, sizeof(mg6010e_status_time_t)) == 0);
+    MG6010E_CHECK(memcmp(&a->encoder_data, &b->encoder_data, sizeof(mg6010e_encoder_data_t)) == 0);
+    MG6010E_TEST_SAME(a, b, control_params.anglekp);
+    MG6010E_TEST_SAME(a, b, control_params.angleki);
+    MG6010E_TEST_SAME(a, b, control_params.anglekd);
+    MG6010E_TEST_SAME(a, b, control_params.speedkp);
+    MG6010E_TEST_SAME(a, b, control_params.speedki);
+    MG6010E_TEST_SAME(a, b, control_params.speedkd);
+    MG6010E_TEST_SAME(a, b, control_params.currentkp);
+    MG6010E_TEST_SAME(a, b, control_params.currentki);
+    MG6010E_TEST_SAME(a, b, control_params.currentkd);
+    MG6010E_TEST_SAME(a, b, control_params.inputTorqueLimit);
+    MG6010E_TEST_SAME(a, b, control_params.inputSpeedLimit);
+    MG6010E_TEST_SAME(a, b, control_params.inputAngleLimit);
+    MG6010E_TEST_SAME(a, b, control_params.inputCurrentRamp);
+    MG6010E_TEST_SAME(a, b, control_params.inputSpeedRamp);
+}
+
+/**
+ * @brief 同一组帧逐帧解析与按MG6010E_TEST_BURST帧一批解析，电机数据与时间戳完全相同
+ */
+static void mg6010e_test_burst_matches_single(void)
+{
+    static mg6010e_test_state_t single[MG6010E_TEST_MOTOR_NUM];
+    static mg6010e_test_state_t burst[MG6010E_TEST_MOTOR_NUM];
+    mg6010e_test_generate();
+
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_sim_advance(1000); // 时间戳为0表示从未更新，先离开0时刻
+    for (uint32_t i = 0; i < MG6010E_TEST_FRAME_NUM; i++)
+    {
+        mg6010e_can_rx_frame(&mg6010e_test_sim, &mg6010e_test_frames[i]);
+    }
+    mg6010e_test_capture(single);
+#if MG6010E_USE_SOA_TELEMETRY
+    int16_t single_speeds[32], single_iqs[32];
+    uint16_t single_encoders[32];
+    int8_t single_temperatures[32];
+    int64_t single_angles[32];
+    mg6010e_get_speeds(0, single_speeds, 0xFF);
+    mg6010e_get_iqs(0, single_iqs, 0xFF);
+    mg6010e_get_encoders(0, single_encoders, 0xFF);
+    mg6010e_get_temperatures(0, single_temperatures, 0xFF);
+    mg6010e_get_angles(0, single_angles, 0xFF);
+#endif
+
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++) // 重新初始化清空电机数据，虚拟时间不变
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_test_sim, .motor_id = id};
+        MG6010E_CHECK_EQ(mg6010e_deinit(id), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    }
+    uint32_t processed = 0;
+    for (uint32_t i = 0; i < MG6010E_TEST_FRAME_NUM; i += MG6010E_TEST_BURST)
+    {
+        uint32_t count = MG6010E_TEST_FRAME_NUM - i < MG6010E_TEST_BURST ? MG6010E_TEST_FRAME_NUM - i : MG6010E_TEST_BURST;
+        processed += mg6010e_can_rx_process_burst(&mg6010e_test_sim, &mg6010e_test_frames[i], count);
+    }
+    mg6010e_test_capture(burst);
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < MG6010E_TEST_FRAME_NUM; i++)
+    {
+        uint32_t index = mg6010e_test_frames[i].std_id - (MG6010E_CAN_FEEDBACK_BASE_ID + 1);
+        expected += index < MG6010E_TEST_MOTOR_NUM;
+    }
+    MG6010E_CHECK_EQ(processed, expected);
+    for (uint32_t i = 0; i < MG6010E_TEST_MOTOR_NUM; i++)
+    {
+        mg6010e_test_compare(&single[i], &burst[i]);
+        MG6010E_CHECK(burst[i].status_time.speed != 0); // 每个电机都收到过状态2布局的帧
+    }
+#if MG6010E_USE_SOA_TELEMETRY
+    int16_t speeds[32], iqs[32];
+    uint16_t encoders[32];
+    int8_t temperatures[32];
+    int64_t angles[32];
+    mg6010e_get_speeds(0, speeds, 0xFF);
+    mg6010e_get_iqs(0, iqs, 0xFF);
+    mg6010e_get_encoders(0, encoders, 0xFF);
+    mg6010e_get_temperatures(0, temperatures, 0xFF);
+    mg6010e_get_angles(0, angles, 0xFF);
+    MG6010E_CHECK(memcmp(speeds, single_speeds, sizeof(int16_t) * MG6010E_TEST_MOTOR_NUM) == 0);
+    MG6010E_CHECK(memcmp(iqs, single_iqs, sizeof(int16_t) * MG6010E_TEST_MOTOR_NUM) == 0);
+    MG6010E_CHECK(memcmp(encoders, single_encoders, sizeof(uint16_t) * MG6010E_TEST_MOTOR_NUM) == 0);
+    MG6010E_CHECK(memcmp(temperatures, single_temperatures, sizeof(int8_t) * MG6010E_TEST_MOTOR_NUM) == 0);
+    MG6010E_CHECK(memcmp(angles, single_angles, sizeof(int64_t) * MG6010E_TEST_MOTOR_NUM) == 0);
+    MG6010E_CHECK_EQ(mg6010e_get_speeds(MG6010E_MAX_CAN_BUS, speeds, 0xFF), MG6010E_ERROR_INVALID_ID);
+    MG6010E_CHECK_EQ(mg6010e_get_angles(MG6010E_MAX_CAN_BUS, angles, 0xFF), MG6010E_ERROR_INVALID_ID);
+    MG6010E_CHECK_EQ(mg6010e_get_iqs(0, NULL, 0xFF), MG6010E_ERROR_CONFIG_NULL_PTR);
+#endif
+}
+
+/**
+ * @brief 轮询接收：仿真器的回复放入接收FIFO，由mg6010e_can_rx_poll一次取出并批量解析
+ */
+static void mg6010e_test_rx_poll(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_test_sim.rx_interrupt = 0;
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_sim_motor(&mg6010e_test_sim, id)->voltage = 2300 + id;
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    mg6010e_sim_advance(5000);
+    mg6010e_status_t status;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(1, &status), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(status.voltage, 0); // 尚未取出
+    MG6010E_CHECK_EQ(mg6010e_can_rx_poll(&mg6010e_test_sim), MG6010E_TEST_MOTOR_NUM);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_get_motor_status(id, &status), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(status.voltage, 2300 + id);
+    }
+    MG6010E_CHECK_EQ(mg6010e_can_rx_poll(&mg6010e_test_sim), 0);
+    mg6010e_test_sim.rx_interrupt = 1;
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_burst_matches_single);
+    MG6010E_TEST_RUN(mg6010e_test_rx_poll);
+    return MG6010E_TEST_RESULT();
+}
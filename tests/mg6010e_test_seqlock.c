@@ -0,0 +1,173 @@
+/**
+ * @file mg6010e_test_seqlock.c
+ * @brief 顺序锁压力测试：一个线程模拟接收中断持续写入反馈，多个线程同时读取，检查不会读到写了一半的数据（含64位的angle）
+ * @note 读写线程定期让出CPU，单核上依靠抢占交错，多核上真正并行。写入的每一帧自洽：多圈角度的高32位与低32位相等，状态2中转矩电流、速度与编码器值相等。
+ * 读者经mg6010e_get_motor_status与（启用MG6010E_USE_SOA_TELEMETRY时）mg6010e_get_angles读取，读到不自洽的值即为撕裂读。
+ */
+#define _POSIX_C_SOURCE 199309L
+#include "mg6010e_test.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+#define MG6010E_TEST_MOTOR_ID 1
+#define MG6010E_TEST_WRITES 400000 // 写线程写入的帧数
+#define MG6010E_TEST_READERS 3     // 读线程数
+#define MG6010E_TEST_YIELD 256     // 每隔若干次读写让出CPU，单核上也能使读写交错
+
+static atomic_int mg6010e_test_writing; // 写线程运行中
+
+// 读线程的结果
+typedef struct mg6010e_test_reader
+{
+    uint32_t reads; // 成功读取的次数
+    uint32_t busy;  // 重试后仍冲突而返回MG6010E_ERROR_BUSY的次数
+    uint32_t torn;  // 读到不自洽数据的次数
+    uint32_t moved; // 读到的角度发生变化的次数，用于确认读写确实并发
+} mg6010e_test_reader_t;
+
+/**
+ * @brief 多圈角度：高32位与低32位均为k，写了一半时两者不等
+ */
+static int64_t mg6010e_test_angle(uint32_t k)
+{
+    return ((int64_t)k << 32) | k;
+}
+
+static uint8_t mg6010e_test_angle_valid(int64_t angle)
+{
+    return (uint32_t)((uint64_t)angle >> 32) == (uint32_t)angle;
+}
+
+/**
+ * @brief 写线程：交替写入多圈角度（0x92）与状态2（0x9C）反馈
+ */
+static void *mg6010e_test_writer(void *arg)
+{
+    (void)arg;
+    for (uint32_t k = 1; k <= MG6010E_TEST_WRITES; k++)
+    {
+        uint32_t value = k & 0x7FFFFF; // 7字节有符号数中保持为正
+        mg6010e_can_frame_t frame = {.std_id = MG6010E_CAN_FEEDBACK_ID(MG6010E_TEST_MOTOR_ID), .dlc = 8};
+        if (k & 1)
+        {
+            uint64_t angle = (uint64_t)mg6010e_test_angle(value);
+            frame.data[0] = 0x92;
+            for (uint32_t b = 0; b < 7; b++)
+            {
+                frame.data[1 + b] = (uint8_t)(angle >> (8 * b));
+            }
+        }
+        else
+        {
+            frame.data[0] = 0x9C;
+            frame.data[1] = (uint8_t)(value & 0x7F);
+            for (uint32_t b = 0; b < 3; b++)
+            {
+                frame.data[2 + 2 * b] = (uint8_t)value;
+                frame.data[3 + 2 * b] = (uint8_t)(value >> 8);
+            }
+        }
+        mg6010e_can_rx_frame(&mg6010e_test_sim, &frame);
+        if (k % MG6010E_TEST_YIELD == 0)
+        {
+            sched_yield();
+        }
+    }
+    atomic_store(&mg6010e_test_writing, 0);
+    return NULL;
+}
+
+/**
+ * @brief 读线程：写线程运行期间反复读取并检查自洽性
+ */
+static void *mg6010e_test_reader(void *arg)
+{
+    mg6010e_test_reader_t *result = arg;
+    int64_t last_angle = 0;
+    for (uint32_t n = 1; atomic_load(&mg6010e_test_writing); n++)
+    {
+        if (n % MG6010E_TEST_YIELD == 0)
+        {
+            sched_yield();
+        }
+        mg6010e_status_t status;
+        uint8_t ret = mg6010e_get_motor_status(MG6010E_TEST_MOTOR_ID, &status);
+        if (ret == MG6010E_ERROR_BUSY)
+        {
+            result->busy++;
+            continue;
+        }
+        result->reads++;
+        if (!mg6010e_test_angle_valid(status.angle) || status.iqActual != status.speed || (uint16_t)status.speed != status.encoder)
+        {
+            result->torn++;
+        }
+        if (status.angle != last_angle)
+        {
+            result->moved++;
+            last_angle = status.angle;
+        }
+#if MG6010E_USE_SOA_TELEMETRY
+        int64_t angles[32];
+        ret = mg6010e_get_angles(0, angles, 1UL << (MG6010E_TEST_MOTOR_ID - 1));
+        if (ret == MG6010E_ERROR_BUSY)
+        {
+            result->busy++;
+            continue;
+        }
+        result->reads++;
+        if (!mg6010e_test_angle_valid(angles[MG6010E_TEST_MOTOR_ID - 1]))
+        {
+            result->torn++;
+        }
+#endif
+    }
+    return NULL;
+}
+
+/**
+ * @brief 一个写线程与MG6010E_TEST_READERS个读线程并发，读者始终读到某一帧写入后的完整数据
+ */
+static void mg6010e_test_concurrent(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_ID);
+    atomic_store(&mg6010e_test_writing, 1);
+    pthread_t writer;
+    pthread_t readers[MG6010E_TEST_READERS];
+    mg6010e_test_reader_t results[MG6010E_TEST_READERS] = {0};
+    for (uint32_t i = 0; i < MG6010E_TEST_READERS; i++)
+    {
+        MG6010E_CHECK_EQ(pthread_create(&readers[i], NULL, mg6010e_test_reader, &results[i]), 0);
+    }
+    MG6010E_CHECK_EQ(pthread_create(&writer, NULL, mg6010e_test_writer, NULL), 0);
+    pthread_join(writer, NULL);
+    uint32_t reads = 0, moved = 0;
+    for (uint32_t i = 0; i < MG6010E_TEST_READERS; i++)
+    {
+        pthread_join(readers[i], NULL);
+        MG6010E_CHECK_EQ(results[i].torn, 0);
+        reads += results[i].reads;
+        moved += results[i].moved;
+        printf("reader %u: %u reads, %u busy, %u angle changes\n", i, results[i].reads, results[i].busy, results[i].moved);
+    }
+    MG6010E_CHECK(reads > 0);
+    MG6010E_CHECK(moved > 1);
+
+    // 写线程结束后读到最后写入的值
+    mg6010e_status_t status;
+    MG6010E_CHECK_EQ(mg6010e_get_motor_status(MG6010E_TEST_MOTOR_ID, &status), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(status.angle, mg6010e_test_angle((MG6010E_TEST_WRITES - 1) & 0x7FFFFF));
+    MG6010E_CHECK_EQ(status.speed, (int16_t)MG6010E_TEST_WRITES);
+#if MG6010E_USE_SOA_TELEMETRY
+    int64_t angles[32];
+    MG6010E_CHECK_EQ(mg6010e_get_angles(0, angles, 1UL << (MG6010E_TEST_MOTOR_ID - 1)), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(angles[MG6010E_TEST_MOTOR_ID - 1], status.angle);
+#endif
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_concurrent);
+    return MG6010E_TEST_RESULT();
+}
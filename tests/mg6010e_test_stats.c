@@ -0,0 +1,136 @@
+/**
+ * @file mg6010e_test_stats.c
+ * @brief 收发统计（MG6010E_USE_STATS）与跟踪（MG6010E_USE_TRACE）测试
+ * @note 以MG6010E_TRACE_DEPTH=64注册，覆盖跟踪环形缓冲区回绕。
+ */
+#include "mg6010e_test.h"
+
+#define MG6010E_TEST_MOTOR_NUM 4
+
+static void mg6010e_test_inject(uint32_t std_id, uint8_t opcode)
+{
+    mg6010e_can_frame_t frame = {.std_id = std_id, .dlc = 8, .data = {opcode}};
+    mg6010e_can_rx_frame(&mg6010e_test_sim, &frame);
+}
+
+static uint32_t mg6010e_test_get_le32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * @brief 电机统计之和等于总线统计，未初始化的ID与未知命令字节各计一次，0x80等无数据回复不算未知
+ */
+static void mg6010e_test_counters(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_reset_stats();
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_1(id), MG6010E_SUCCESS);
+    }
+    mg6010e_sim_advance(5000);
+    mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(20), 0x9A); // 未初始化的电机
+    mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(1), 0x55);  // 未知命令字节
+    mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(2), 0x80);  // 无数据的回复
+    mg6010e_test_inject(0x100, 0x9A);                       // 其他设备，不计入
+
+    mg6010e_bus_stats_t bus_stats;
+    MG6010E_CHECK_EQ(mg6010e_get_bus_stats(&mg6010e_test_sim, &bus_stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(bus_stats.tx_frames, MG6010E_TEST_MOTOR_NUM);
+    MG6010E_CHECK_EQ(bus_stats.tx_failures, 0);
+    MG6010E_CHECK_EQ(bus_stats.tx_dropped, 0);
+    MG6010E_CHECK_EQ(bus_stats.rx_frames, MG6010E_TEST_MOTOR_NUM + 3);
+    MG6010E_CHECK_EQ(bus_stats.rx_unregistered, 1);
+    MG6010E_CHECK_EQ(bus_stats.rx_unknown, 1);
+    MG6010E_CHECK_EQ(bus_stats.isr_count, MG6010E_TEST_MOTOR_NUM + 3);
+
+    uint32_t tx_frames = 0, rx_frames = 0, rx_unknown = 0;
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_motor_stats_t motor_stats;
+        MG6010E_CHECK_EQ(mg6010e_get_motor_stats(id, &motor_stats), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(motor_stats.tx_frames, 1);
+        MG6010E_CHECK_EQ(motor_stats.rx_unknown, id == 1);
+        tx_frames += motor_stats.tx_frames;
+        rx_frames += motor_stats.rx_frames;
+        rx_unknown += motor_stats.rx_unknown;
+    }
+    MG6010E_CHECK_EQ(tx_frames, bus_stats.tx_frames);
+    MG6010E_CHECK_EQ(rx_frames, bus_stats.rx_frames - bus_stats.rx_unregistered);
+    MG6010E_CHECK_EQ(rx_unknown, bus_stats.rx_unknown);
+
+    mg6010e_reset_stats();
+    MG6010E_CHECK_EQ(mg6010e_get_bus_stats(&mg6010e_test_sim, &bus_stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(bus_stats.rx_frames, 0);
+    MG6010E_CHECK_EQ(mg6010e_get_motor_stats(21, NULL), MG6010E_ERROR_NOT_INITIALIZED);
+}
+
+/**
+ * @brief 跟踪记录按时间顺序导出，事件类型与ID正确；记录超过缓冲区深度或导出缓冲区不足时保留最近的记录
+ */
+static void mg6010e_test_trace(void)
+{
+    static uint8_t dump[MG6010E_TRACE_DUMP_SIZE];
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    mg6010e_trace_clear();
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(3), MG6010E_SUCCESS);
+    mg6010e_sim_advance(5000);
+    mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(20), 0x9A);
+    mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(1), 0x55);
+
+    // TX、RX、RX_UNREGISTERED、RX、RX_UNKNOWN（未知命令字节先记录到达，解析时再记录未知）
+    static const uint8_t events[] = {MG6010E_TRACE_TX, MG6010E_TRACE_RX, MG6010E_TRACE_RX_UNREGISTERED, MG6010E_TRACE_RX, MG6010E_TRACE_RX_UNKNOWN};
+    static const uint16_t ids[] = {MG6010E_CAN_CMD_ID(3), MG6010E_CAN_FEEDBACK_ID(3), MG6010E_CAN_FEEDBACK_ID(20), MG6010E_CAN_FEEDBACK_ID(1), MG6010E_CAN_FEEDBACK_ID(1)};
+    static const uint8_t opcodes[] = {0x9A, 0x9A, 0x9A, 0x55, 0x55};
+    uint32_t length = mg6010e_trace_dump(dump, sizeof(dump));
+    MG6010E_CHECK_EQ(length, MG6010E_TRACE_HEADER_SIZE + sizeof(events) * MG6010E_TRACE_ENTRY_SIZE);
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(dump), MG6010E_TRACE_MAGIC);
+    MG6010E_CHECK_EQ(dump[4] | (dump[5] << 8), MG6010E_TRACE_VERSION);
+    MG6010E_CHECK_EQ(dump[6] | (dump[7] << 8), MG6010E_TRACE_ENTRY_SIZE);
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(dump + 8), sizeof(events));
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(dump + 12), sizeof(events));
+    uint32_t last_time = 0;
+    for (uint32_t i = 0; i < sizeof(events); i++)
+    {
+        const uint8_t *entry = dump + MG6010E_TRACE_HEADER_SIZE + i * MG6010E_TRACE_ENTRY_SIZE;
+        uint32_t timestamp = mg6010e_test_get_le32(entry);
+        MG6010E_CHECK(timestamp >= last_time);
+        last_time = timestamp;
+        MG6010E_CHECK_EQ(entry[4] | (entry[5] << 8), ids[i]); // 总线0，bit11~13为0
+        MG6010E_CHECK_EQ(entry[6], opcodes[i]);
+        MG6010E_CHECK_EQ(entry[7], events[i]);
+    }
+
+    // 写满并回绕：只保留最近MG6010E_TRACE_DEPTH条
+    uint32_t total = sizeof(events);
+    for (uint32_t i = 0; i < MG6010E_TRACE_DEPTH + 10; i++)
+    {
+        mg6010e_test_inject(MG6010E_CAN_FEEDBACK_ID(2), (uint8_t)(0x90 + (i & 1) * 2)); // 0x90与0x92交替
+        total++;
+    }
+    length = mg6010e_trace_dump(dump, sizeof(dump));
+    MG6010E_CHECK_EQ(length, MG6010E_TRACE_DUMP_SIZE);
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(dump + 8), MG6010E_TRACE_DEPTH);
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(dump + 12), total);
+    const uint8_t *newest = dump + MG6010E_TRACE_HEADER_SIZE + (MG6010E_TRACE_DEPTH - 1) * MG6010E_TRACE_ENTRY_SIZE;
+    MG6010E_CHECK_EQ(newest[6], 0x92);
+    MG6010E_CHECK_EQ(newest[7], MG6010E_TRACE_RX);
+
+    // 导出缓冲区只能容纳3条时导出最近的3条
+    uint8_t small[MG6010E_TRACE_HEADER_SIZE + 3 * MG6010E_TRACE_ENTRY_SIZE + 5];
+    MG6010E_CHECK_EQ(mg6010e_trace_dump(small, sizeof(small)), MG6010E_TRACE_HEADER_SIZE + 3 * MG6010E_TRACE_ENTRY_SIZE);
+    MG6010E_CHECK_EQ(mg6010e_test_get_le32(small + 8), 3);
+    MG6010E_CHECK(memcmp(small + MG6010E_TRACE_HEADER_SIZE, newest - 2 * MG6010E_TRACE_ENTRY_SIZE, 3 * MG6010E_TRACE_ENTRY_SIZE) == 0);
+    MG6010E_CHECK_EQ(mg6010e_trace_dump(small, MG6010E_TRACE_HEADER_SIZE - 1), 0);
+
+    mg6010e_trace_clear();
+    MG6010E_CHECK_EQ(mg6010e_trace_dump(dump, sizeof(dump)), MG6010E_TRACE_HEADER_SIZE);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_counters);
+    MG6010E_TEST_RUN(mg6010e_test_trace);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file mg6010e_test_traj.c
+ * @brief 轨迹流式发送（MG6010E_USE_TRAJECTORY）测试：角度轨迹与速度轨迹在仿真中到达终点，发送频率与速度限制符合配置
+ */
+#include "mg6010e_test.h"
+#include <math.h>
+
+#define MG6010E_TEST_MOTOR_NUM 2
+#define MG6010E_TEST_LAG 1200 // 运行中多圈角度与轨迹的允许偏差，单位0.01°；仿真的位置环只有比例项，转速v dps时滞后约v/10°
+
+/**
+ * @brief 以MG6010E_TRAJ_TICK_HZ调用mg6010e_traj_tick推进ms毫秒，记录电机1转速绝对值的最大值（dps）
+ */
+static float mg6010e_test_run(uint32_t ms)
+{
+    float max_speed = 0;
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        mg6010e_traj_tick();
+        mg6010e_test_advance(1000000 / MG6010E_TRAJ_TICK_HZ);
+        float speed = fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->speed);
+        max_speed = speed > max_speed ? speed : max_speed;
+    }
+    return max_speed;
+}
+
+/**
+ * @brief 线性角度轨迹：两个电机同时到达终点，设定值按rate_hz发出，转速不超过轨迹速度加余量
+ */
+static void mg6010e_test_angle_linear(void)
+{
+    mg6010e_test_sim_setup(MG6010E_TEST_MOTOR_NUM);
+    const mg6010e_traj_point_t points[] = {
+        {.time_ms = 0, .value = 0},
+        {.time_ms = 1000, .value = 9000}, // 90dps
+        {.time_ms = 1500, .value = 9000},
+        {.time_ms = 2000, .value = -4500}, // 270dps
+    };
+    const mg6010e_traj_config_t config = {.mode = MG6010E_TRAJ_ANGLE_LINEAR, .rate_hz = 500, .speed_margin = 20, .min_speed = 60};
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_traj_load(id, &config, points, 4), MG6010E_SUCCESS);
+    }
+    MG6010E_CHECK_EQ(mg6010e_traj_start((const uint8_t[]){1, 2}, MG6010E_TEST_MOTOR_NUM), MG6010E_SUCCESS);
+
+    float max_speed = mg6010e_test_run(1000);
+    MG6010E_CHECK(max_speed > 85 && max_speed <= 90 * 1.2f + 5); // 第一段以90dps跟随，上限108dps
+    MG6010E_CHECK(fabs(mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle - 9000) < MG6010E_TEST_LAG);
+    max_speed = mg6010e_test_run(2000); // 终点设定值的最大速度为min_speed，滞后的角度以60dps补上
+    MG6010E_CHECK(max_speed > 260 && max_speed <= 270 * 1.2f + 5);
+
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        MG6010E_CHECK(fabs(mg6010e_sim_motor(&mg6010e_test_sim, id)->angle - -4500) < 50);
+        mg6010e_traj_stats_t stats;
+        MG6010E_CHECK_EQ(mg6010e_traj_get_stats(id, &stats), MG6010E_SUCCESS);
+        MG6010E_CHECK_EQ(stats.state, MG6010E_TRAJ_DONE);
+        MG6010E_CHECK_EQ(stats.elapsed_ms, 2000);
+        MG6010E_CHECK_EQ(stats.setpoints, 2000 / 2 + 1); // 每2ms一个设定值，另加终点
+        MG6010E_CHECK_EQ(stats.send_failures, 0);
+    }
+}
+
+/**
+ * @brief 三次角度轨迹按路点速度经过中间路点并停在终点
+ */
+static void mg6010e_test_angle_cubic(void)
+{
+    mg6010e_test_sim_setup(1);
+    const mg6010e_traj_point_t points[] = {
+        {.time_ms = 0, .value = 0},
+        {.time_ms = 1000, .value = 9000, .velocity = 9000},
+        {.time_ms = 2000, .value = 18000},
+    };
+    const mg6010e_traj_config_t config = {.mode = MG6010E_TRAJ_ANGLE_CUBIC, .rate_hz = 1000, .speed_margin = 20, .min_speed = 30};
+    MG6010E_CHECK_EQ(mg6010e_traj_load(1, &config, points, 3), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_traj_start((const uint8_t[]){1}, 1), MG6010E_SUCCESS);
+    mg6010e_test_run(1000);
+    MG6010E_CHECK(fabs(mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle - 9000) < MG6010E_TEST_LAG);
+    MG6010E_CHECK(fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->speed - 90) < 20);
+    float max_speed = mg6010e_test_run(1500);
+    MG6010E_CHECK(max_speed <= 135 * 1.2f + 5); // 三次插值的峰值速度为1.5倍平均速度
+    MG6010E_CHECK(fabs(mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle - 18000) < 50);
+    MG6010E_CHECK(fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->speed) < 5);
+}
+
+/**
+ * @brief 速度轨迹到达各路点的速度，转矩电流不超过iq_limit，停止后转速为0
+ */
+static void mg6010e_test_speed_linear(void)
+{
+    mg6010e_test_sim_setup(1);
+    const mg6010e_traj_point_t points[] = {
+        {.time_ms = 0, .value = 0},
+        {.time_ms = 500, .value = 36000}, // 360dps
+        {.time_ms = 1000, .value = 36000},
+        {.time_ms = 1500, .value = 0},
+    };
+    const mg6010e_traj_config_t config = {.mode = MG6010E_TRAJ_SPEED_LINEAR, .rate_hz = 200, .iq_limit = 400};
+    MG6010E_CHECK_EQ(mg6010e_traj_load(1, &config, points, 4), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_traj_start((const uint8_t[]){1}, 1), MG6010E_SUCCESS);
+    float max_iq = 0;
+    for (uint32_t ms = 0; ms < 1000; ms += 10)
+    {
+        mg6010e_test_run(10);
+        float iq = fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->iq);
+        max_iq = iq > max_iq ? iq : max_iq;
+    }
+    MG6010E_CHECK(fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->speed - 360) < 10);
+    MG6010E_CHECK(max_iq <= 400);
+    mg6010e_test_run(1000);
+    MG6010E_CHECK(fabsf(mg6010e_sim_motor(&mg6010e_test_sim, 1)->speed) < 5);
+
+    mg6010e_traj_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_traj_get_stats(1, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.state, MG6010E_TRAJ_DONE);
+    MG6010E_CHECK_EQ(stats.setpoints, 1500 / 5 + 1);
+    MG6010E_CHECK(stats.speed_error.samples > 0);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_angle_linear);
+    MG6010E_TEST_RUN(mg6010e_test_angle_cubic);
+    MG6010E_TEST_RUN(mg6010e_test_speed_linear);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,243 @@
+/**
+ * @file mg6010e_test_tx_queue.c
+ * @brief 发送队列测试：经HAL传输层（bench/mock_hal）覆盖队列回绕、控制命令丢弃最早的帧、配置命令永不丢弃、
+ * 队头为配置命令时丢弃其后的控制命令，以及部分发送时保留未发出的帧
+ * @note 以HAL注册，tx_free为0时命令只入队，恢复后由mg6010e_can_tx_complete_hook发出；tx_limit使邮箱写入在指定帧数后失败。
+ */
+#include "mg6010e_test.h"
+#include "stm32f4xx_hal.h"
+
+#define MG6010E_TEST_MOTOR_NUM 5
+
+static CAN_HandleTypeDef mg6010e_test_can; // 模拟的CAN句柄
+
+/**
+ * @brief 重新初始化模拟的CAN句柄，并在其上初始化电机1~MG6010E_TEST_MOTOR_NUM
+ */
+static void mg6010e_test_hal_setup(void)
+{
+    mock_hal_can_init(&mg6010e_test_can);
+    mg6010e_set_transport(&mg6010e_hal_transport);
+    for (uint8_t id = 1; id <= MG6010E_TEST_MOTOR_NUM; id++)
+    {
+        mg6010e_config_t config = {.can_handle = &mg6010e_test_can, .motor_id = id};
+        MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    }
+}
+
+/**
+ * @brief 恢复空闲邮箱并模拟发送完成中断，发出队列中的帧
+ */
+static void mg6010e_test_release(void)
+{
+    mg6010e_test_can.tx_free = 3;
+    mg6010e_can_tx_complete_hook(&mg6010e_test_can);
+}
+
+/**
+ * @brief 检查写入发送邮箱的第index帧的ID与命令字节
+ */
+static void mg6010e_test_check_tx(uint32_t index, uint8_t motor_id, uint8_t cmd)
+{
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_log_id[index % MOCK_HAL_TX_LOG_DEPTH], MG6010E_CAN_CMD_ID(motor_id));
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_log_data[index % MOCK_HAL_TX_LOG_DEPTH][0], cmd);
+}
+
+/**
+ * @brief 检查写入发送邮箱的第index帧为转矩闭环命令，且转矩电流为iq
+ */
+static void mg6010e_test_check_iq(uint32_t index, int16_t iq)
+{
+    const uint8_t *data = mg6010e_test_can.tx_log_data[index % MOCK_HAL_TX_LOG_DEPTH];
+    MG6010E_CHECK_EQ(data[0], 0xA1);
+    MG6010E_CHECK_EQ((int16_t)(data[4] | (data[5] << 8)), iq);
+}
+
+/**
+ * @brief 多轮入队与发出使读写位置多次越过队列末尾，每轮的帧都按入队顺序完整发出
+ */
+static void mg6010e_test_wraparound(void)
+{
+    mg6010e_test_hal_setup();
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_can);
+    uint32_t tx_frames = mg6010e_test_can.tx_frames;
+    for (int16_t round = 0; round < 40; round++)
+    {
+        mg6010e_test_can.tx_free = 0;
+        for (int16_t i = 0; i < 10; i++)
+        {
+            MG6010E_CHECK_EQ(mg6010e_iq_control(1, (int16_t)(round * 10 + i)), MG6010E_SUCCESS);
+        }
+        MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames, tx_frames);
+        mg6010e_test_release();
+        MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames, tx_frames + 10);
+        for (int16_t i = 0; i < 10; i++)
+        {
+            mg6010e_test_check_iq(tx_frames + i, (int16_t)(round * 10 + i));
+        }
+        tx_frames += 10;
+    }
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can), dropped);
+}
+
+/**
+ * @brief 队列满时控制命令丢弃最早入队的帧并计入丢弃数，保留最近的MG6010E_TX_QUEUE_DEPTH帧
+ */
+static void mg6010e_test_drop_oldest(void)
+{
+    mg6010e_test_hal_setup();
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_can);
+    uint32_t tx_frames = mg6010e_test_can.tx_frames;
+    mg6010e_test_can.tx_free = 0;
+    for (int16_t i = 0; i < MG6010E_TX_QUEUE_DEPTH + 5; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(2, (int16_t)(100 + i)), MG6010E_SUCCESS);
+    }
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can) - dropped, 5);
+    mg6010e_test_release();
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, MG6010E_TX_QUEUE_DEPTH);
+    for (int16_t i = 0; i < MG6010E_TX_QUEUE_DEPTH; i++)
+    {
+        mg6010e_test_check_iq(tx_frames + i, (int16_t)(105 + i));
+    }
+}
+
+/**
+ * @brief 队头为配置命令时队列满返回MG6010E_ERROR_QUEUE_FULL，已入队的配置命令全部发出
+ */
+static void mg6010e_test_never_drop(void)
+{
+    mg6010e_test_hal_setup();
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_can);
+    uint32_t tx_frames = mg6010e_test_can.tx_frames;
+    mg6010e_test_can.tx_free = 0;
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_stop((uint8_t)(1 + i % MG6010E_TEST_MOTOR_NUM)), MG6010E_SUCCESS);
+    }
+    MG6010E_CHECK_EQ(mg6010e_stop(1), MG6010E_ERROR_QUEUE_FULL);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 10), MG6010E_ERROR_QUEUE_FULL);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can), dropped);
+    mg6010e_test_release();
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, MG6010E_TX_QUEUE_DEPTH);
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH; i++)
+    {
+        mg6010e_test_check_tx(tx_frames + i, (uint8_t)(1 + i % MG6010E_TEST_MOTOR_NUM), 0x81);
+    }
+    MG6010E_CHECK_EQ(mg6010e_iq_control(1, 10), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_set_tx_policy(MG6010E_CMD_CLASS_NUM, MG6010E_TX_POLICY_NEVER_DROP), MG6010E_ERROR_INVALID_PARAM);
+    MG6010E_CHECK_EQ(mg6010e_set_tx_policy(MG6010E_CMD_CLASS_CONFIG, MG6010E_TX_POLICY_NEVER_DROP + 1), MG6010E_ERROR_INVALID_PARAM);
+}
+
+/**
+ * @brief 队头为配置命令时丢弃其后最早的控制命令：配置命令移出队列（不丢失且仍最先发出）并腾出槽位，其余帧保持入队顺序
+ */
+static void mg6010e_test_evict_behind(void)
+{
+    mg6010e_test_hal_setup();
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_can);
+    uint32_t tx_frames = mg6010e_test_can.tx_frames;
+    mg6010e_test_can.tx_free = 0;
+    MG6010E_CHECK_EQ(mg6010e_stop(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_stop(2), MG6010E_SUCCESS);
+    for (int16_t i = 0; i < MG6010E_TX_QUEUE_DEPTH - 2; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(3, (int16_t)(200 + i)), MG6010E_SUCCESS);
+    }
+    // 队列已满：两条停止命令移出队列，丢弃其后的第一条控制命令，共腾出3个槽位
+    MG6010E_CHECK_EQ(mg6010e_stop(4), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can) - dropped, 1);
+    for (int16_t i = 0; i < 3; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_iq_control(3, (int16_t)(300 + i)), MG6010E_SUCCESS);
+    }
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can) - dropped, 2); // 最后一条丢弃队头的控制命令
+
+    for (uint32_t i = 0; i < MG6010E_TX_QUEUE_DEPTH; i++)
+    {
+        mg6010e_test_release();
+    }
+    uint32_t setpoints = MG6010E_TX_QUEUE_DEPTH - 4; // 第一条与第二条控制命令被丢弃
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, 2 + setpoints + 1 + 3);
+    mg6010e_test_check_tx(tx_frames + 0, 1, 0x81);
+    mg6010e_test_check_tx(tx_frames + 1, 2, 0x81);
+    for (uint32_t i = 0; i < setpoints; i++)
+    {
+        mg6010e_test_check_iq(tx_frames + 2 + i, (int16_t)(202 + i));
+    }
+    mg6010e_test_check_tx(tx_frames + 2 + setpoints, 4, 0x81);
+    for (int16_t i = 0; i < 3; i++)
+    {
+        mg6010e_test_check_iq(tx_frames + 3 + setpoints + i, (int16_t)(300 + i));
+    }
+}
+
+/**
+ * @brief 传输层只发出一批中的一部分时，未发出的帧（含配置命令）保留并在下一次发送时按原顺序最先发出，不计入丢弃数
+ */
+static void mg6010e_test_partial_send(void)
+{
+    mg6010e_test_hal_setup();
+#if MG6010E_USE_STATS
+    mg6010e_reset_stats();
+#endif
+#if MG6010E_USE_BUS_BUDGET
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_can, 10000, 100), MG6010E_SUCCESS);
+    mg6010e_bus_budget_tick();
+#endif
+    uint32_t dropped = mg6010e_get_tx_dropped(&mg6010e_test_can);
+    uint32_t tx_frames = mg6010e_test_can.tx_frames;
+    mg6010e_test_can.tx_free = 0;
+    MG6010E_CHECK_EQ(mg6010e_stop(1), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_iq_control(2, 20), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_stop(3), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_read_status_1(4), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_stop(5), MG6010E_SUCCESS);
+
+    // 邮箱在写入2帧后失败：第一批3帧只发出2帧
+    mg6010e_test_can.tx_limit = tx_frames + 2;
+    mg6010e_test_release();
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, 2);
+    mg6010e_test_release(); // 再次失败，保留的帧不重复计入
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, 2);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can), dropped);
+#if MG6010E_USE_BUS_BUDGET
+    mg6010e_bus_load_t load;
+    mg6010e_bus_budget_tick();
+    MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_can, &load), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(load.reserved_bits, 2 * 2 * MG6010E_CAN_FRAME_BITS_MAX(8)); // 只有已发出的帧计入预算
+#endif
+
+    mg6010e_test_can.tx_limit = 0;
+    mg6010e_test_release();
+    MG6010E_CHECK_EQ(mg6010e_test_can.tx_frames - tx_frames, 5);
+    mg6010e_test_check_tx(tx_frames + 0, 1, 0x81);
+    mg6010e_test_check_iq(tx_frames + 1, 20);
+    mg6010e_test_check_tx(tx_frames + 2, 3, 0x81);
+    mg6010e_test_check_tx(tx_frames + 3, 4, 0x9A);
+    mg6010e_test_check_tx(tx_frames + 4, 5, 0x81);
+    MG6010E_CHECK_EQ(mg6010e_get_tx_dropped(&mg6010e_test_can), dropped);
+#if MG6010E_USE_STATS
+    mg6010e_bus_stats_t stats;
+    MG6010E_CHECK_EQ(mg6010e_get_bus_stats(&mg6010e_test_can, &stats), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(stats.tx_frames, 5);
+    MG6010E_CHECK(stats.tx_failures >= 2);
+    MG6010E_CHECK_EQ(stats.tx_dropped, dropped);
+#endif
+#if MG6010E_USE_BUS_BUDGET
+    mg6010e_bus_budget_tick();
+    MG6010E_CHECK_EQ(mg6010e_get_bus_load(&mg6010e_test_can, &load), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(load.reserved_bits, 3 * 2 * MG6010E_CAN_FRAME_BITS_MAX(8));
+    MG6010E_CHECK_EQ(mg6010e_set_bus_budget(&mg6010e_test_can, 10000, 0), MG6010E_SUCCESS);
+#endif
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_wraparound);
+    MG6010E_TEST_RUN(mg6010e_test_drop_oldest);
+    MG6010E_TEST_RUN(mg6010e_test_never_drop);
+    MG6010E_TEST_RUN(mg6010e_test_evict_behind);
+    MG6010E_TEST_RUN(mg6010e_test_partial_send);
+    return MG6010E_TEST_RESULT();
+}
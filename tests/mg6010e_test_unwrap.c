@@ -0,0 +1,161 @@
+/**
+ * @file mg6010e_test_unwrap.c
+ * @brief 编码器累计（MG6010E_USE_ENCODER_UNWRAP）测试：正反转跨越编码器回绕点、长时间无反馈后的累计与校准、重新初始化后的状态
+ * @note 以不同的MG6010E_ENCODER_BITS注册多次，仿真电机按相同位数回复编码器值。
+ */
+#include "mg6010e_test.h"
+#include <math.h>
+
+#define MG6010E_TEST_SPEED 72000     // 转速，单位0.01dps（720dps，每500ms一圈）
+#define MG6010E_TEST_TOLERANCE 100   // 累计位置与仿真多圈角度的允许偏差，单位0.01°
+#define MG6010E_TEST_TURN 36000      // 一圈对应的多圈角度，单位0.01°
+
+/**
+ * @brief 以1kHz读取状态2，推进ms毫秒
+ */
+static void mg6010e_test_poll(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        MG6010E_CHECK_EQ(mg6010e_read_status_2(1), MG6010E_SUCCESS);
+        mg6010e_test_advance(1000);
+    }
+}
+
+/**
+ * @brief 读取多圈角度校准，等待回复
+ */
+static void mg6010e_test_anchor(void)
+{
+    MG6010E_CHECK_EQ(mg6010e_read_angle(1), MG6010E_SUCCESS);
+    mg6010e_test_advance(1000);
+}
+
+/**
+ * @brief 读取状态2并等待回复，返回累计位置与回复时仿真多圈角度之差
+ */
+static int64_t mg6010e_test_error(mg6010e_position_t *position)
+{
+    MG6010E_CHECK_EQ(mg6010e_read_status_2(1), MG6010E_SUCCESS);
+    mg6010e_test_advance(1000);
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, position), MG6010E_SUCCESS);
+    return position->position - llround(mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle);
+}
+
+static void mg6010e_test_setup(void)
+{
+    mg6010e_test_sim_setup(1);
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->encoder_bits = MG6010E_ENCODER_BITS;
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle = 12345; // 编码器不从零开始
+}
+
+/**
+ * @brief 正转三圈后反转六圈，两个方向都多次跨越编码器回绕点，累计位置与多圈角度一致
+ */
+static void mg6010e_test_wrap(void)
+{
+    mg6010e_test_setup();
+    mg6010e_position_t position;
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, &position), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(position.samples, 0);
+    mg6010e_test_poll(10);
+    mg6010e_test_anchor();
+    int64_t error = mg6010e_test_error(&position);
+    MG6010E_CHECK(position.anchored && llabs(error) < MG6010E_TEST_TOLERANCE);
+    int64_t start = position.position;
+
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, MG6010E_TEST_SPEED), MG6010E_SUCCESS);
+    mg6010e_test_poll(1500);
+    error = mg6010e_test_error(&position);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+    MG6010E_CHECK(position.position - start > 2 * MG6010E_TEST_TURN);
+    MG6010E_CHECK(llabs(position.velocity - MG6010E_TEST_SPEED) < MG6010E_TEST_SPEED / 20);
+
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, -MG6010E_TEST_SPEED), MG6010E_SUCCESS);
+    mg6010e_test_poll(3000);
+    error = mg6010e_test_error(&position);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+    MG6010E_CHECK(start - position.position > 2 * MG6010E_TEST_TURN);
+    MG6010E_CHECK(llabs(position.velocity + MG6010E_TEST_SPEED) < MG6010E_TEST_SPEED / 20);
+
+    // 累计过程中未再校准，停止后校准的偏差仍很小
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 0), MG6010E_SUCCESS);
+    mg6010e_test_poll(500);
+    mg6010e_test_anchor();
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, &position), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(position.anchors, 2);
+    MG6010E_CHECK(llabs(position.last_correction) < MG6010E_TEST_TOLERANCE);
+}
+
+/**
+ * @brief 匀速转动时停止读取700ms（超过半圈），之后的第一个采样按速度补上整圈；随后先校准再采样，校准不重复计入间隔内的转动
+ */
+static void mg6010e_test_gap(void)
+{
+    mg6010e_test_setup();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, MG6010E_TEST_SPEED), MG6010E_SUCCESS);
+    mg6010e_test_poll(500);
+    mg6010e_test_anchor();
+    mg6010e_position_t position;
+    int64_t error = mg6010e_test_error(&position);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+
+    mg6010e_test_advance(700000);
+    error = mg6010e_test_error(&position);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+
+    mg6010e_test_poll(100);
+    mg6010e_test_advance(700000);
+    mg6010e_test_anchor();
+    error = mg6010e_test_error(&position);
+    MG6010E_CHECK_EQ(position.anchors, 2);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+    MG6010E_CHECK(llabs(position.last_correction) < MG6010E_TEST_TOLERANCE);
+    mg6010e_test_poll(100);
+    error = mg6010e_test_error(&position);
+    MG6010E_CHECK(llabs(error) < MG6010E_TEST_TOLERANCE);
+
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 0), MG6010E_SUCCESS);
+    mg6010e_test_poll(500);
+}
+
+/**
+ * @brief 重新初始化的电机从零开始累计：没有采样、未校准，校准后位置与多圈角度一致
+ */
+static void mg6010e_test_reinit(void)
+{
+    mg6010e_test_setup();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, MG6010E_TEST_SPEED), MG6010E_SUCCESS);
+    mg6010e_test_poll(700);
+    mg6010e_test_anchor();
+    MG6010E_CHECK_EQ(mg6010e_speed_control(1, 2000, 0), MG6010E_SUCCESS);
+    mg6010e_test_poll(500);
+
+    MG6010E_CHECK_EQ(mg6010e_deinit(1), MG6010E_SUCCESS);
+    mg6010e_position_t position;
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, &position), MG6010E_ERROR_NOT_INITIALIZED);
+    mg6010e_sim_motor(&mg6010e_test_sim, 1)->angle += 3 * MG6010E_TEST_TURN + 9000; // 未初始化期间转动
+    mg6010e_config_t config = {.can_handle = &mg6010e_test_sim, .motor_id = 1};
+    MG6010E_CHECK_EQ(mg6010e_init(&config), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, &position), MG6010E_SUCCESS);
+    MG6010E_CHECK_EQ(position.samples, 0);
+    MG6010E_CHECK_EQ(position.anchored, 0);
+    MG6010E_CHECK_EQ(position.anchors, 0);
+    MG6010E_CHECK_EQ(position.max_correction, 0);
+
+    mg6010e_test_poll(10);
+    MG6010E_CHECK_EQ(mg6010e_get_position(1, &position), MG6010E_SUCCESS);
+    MG6010E_CHECK(position.samples > 0 && position.position >= 0 && position.position < MG6010E_TEST_TURN); // 未校准时以编码器零点为0
+    mg6010e_test_anchor();
+    int64_t error = mg6010e_test_error(&position);
+    MG6010E_CHECK(position.anchored && llabs(error) < MG6010E_TEST_TOLERANCE);
+    MG6010E_CHECK_EQ(position.max_correction, 0);
+}
+
+int main(void)
+{
+    MG6010E_TEST_RUN(mg6010e_test_wrap);
+    MG6010E_TEST_RUN(mg6010e_test_gap);
+    MG6010E_TEST_RUN(mg6010e_test_reinit);
+    return MG6010E_TEST_RESULT();
+}
@@ -0,0 +1,275 @@
+/**
+ * @file mg6010e_record_decode.c
+ * @brief 领控6010E电机驱动遥测记录解析工具（上位机）
+ * @note 流式读取mg6010e_recorder_read导出的二进制数据，还原每条反馈并按列输出为CSV，统计信息输出到标准错误。
+ * 编译：gcc -DMG6010E_USE_HAL=0 -I. tools/mg6010e_record_decode.c -o mg6010e_record_decode
+ * 用法：mg6010e_record_decode <导出文件，-表示标准输入>
+ * 定义MG6010E_RECORD_DECODE_NO_MAIN后可被包含到其他程序中，直接调用decode_stream（如tests/mg6010e_test_recorder.c）。
+ */
+#include "mg6010e.h"
+#include <stdio.h>
+#include <string.h>
+
+// 每条总线的解析状态
+typedef struct bus_state
+{
+    uint8_t synced;                                 // 是否已收到同步记录
+    uint32_t timestamp;                             // 上一条记录的时间戳，单位us
+    uint64_t time;                                  // 按32位时间戳的差值累加的时间，处理回绕
+    uint32_t dropped;                               // 设备端累计丢弃的记录数
+    uint8_t ref[32][MG6010E_RECORDER_CLASS_NUM][7]; // 与设备端相同的参考值
+} bus_state_t;
+
+// 解析统计
+typedef struct decode_stats
+{
+    uint32_t records;  // 解析出的反馈记录数
+    uint32_t syncs;    // 同步记录数
+    uint32_t dropped;  // 各总线最后一条同步记录中的设备端丢弃数之和
+    uint32_t unsynced; // 同步记录之前的记录数
+    uint64_t bytes;    // 读取的字节数，含文件头
+} decode_stats_t;
+
+static bus_state_t buses[8];
+
+static uint32_t read_le32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint16_t read_le16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+// 读取n个字节，文件结束时返回0
+static int read_bytes(FILE *file, uint8_t *data, size_t n)
+{
+    return fread(data, 1, n, file) == n;
+}
+
+/**
+ * @brief 按命令字节将反馈数据输出为各列，不含该字段的列留空
+ *
+ * 列：temperature,voltage,current,motor_state,error_state,iq,speed,encoder,ia,ib,ic,brake,encoder_raw,encoder_offset,angle,single_angle,param_id,param_data
+ */
+static void print_fields(FILE *out, uint8_t opcode, const uint8_t *data)
+{
+    char columns[18][24];
+    memset(columns, 0, sizeof(columns));
+    switch (opcode)
+    {
+    case 0x9A:
+    case 0x9B:
+        snprintf(columns[0], sizeof(columns[0]), "%d", (int8_t)data[1]);
+        snprintf(columns[1], sizeof(columns[1]), "%d", (int16_t)read_le16(&data[2]));
+        snprintf(columns[2], sizeof(columns[2]), "%d", (int16_t)read_le16(&data[4]));
+        snprintf(columns[3], sizeof(columns[3]), "%u", data[6]);
+        snprintf(columns[4], sizeof(columns[4]), "%u", data[7]);
+        break;
+    case 0x9C:
+    case 0xA1:
+    case 0xA2:
+    case 0xA3:
+    case 0xA4:
+    case 0xA5:
+    case 0xA6:
+    case 0xA7:
+    case 0xA8:
+        snprintf(columns[0], sizeof(columns[0]), "%d", (int8_t)data[1]);
+        snprintf(columns[5], sizeof(columns[5]), "%d", (int16_t)read_le16(&data[2]));
+        snprintf(columns[6], sizeof(columns[6]), "%d", (int16_t)read_le16(&data[4]));
+        snprintf(columns[7], sizeof(columns[7]), "%u", read_le16(&data[6]));
+        break;
+    case 0x9D:
+        snprintf(columns[0], sizeof(columns[0]), "%d", (int8_t)data[1]);
+        snprintf(columns[8], sizeof(columns[8]), "%d", (int16_t)read_le16(&data[2]));
+        snprintf(columns[9], sizeof(columns[9]), "%d", (int16_t)read_le16(&data[4]));
+        snprintf(columns[10], sizeof(columns[10]), "%d", (int16_t)read_le16(&data[6]));
+        break;
+    case 0x8C:
+        snprintf(columns[11], sizeof(columns[11]), "%u", data[1]);
+        break;
+    case 0x90:
+        snprintf(columns[7], sizeof(columns[7]), "%u", read_le16(&data[2]));
+        snprintf(columns[12], sizeof(columns[12]), "%u", read_le16(&data[4]));
+        snprintf(columns[13], sizeof(columns[13]), "%u", read_le16(&data[6]));
+        break;
+    case 0x19:
+        snprintf(columns[13], sizeof(columns[13]), "%u", read_le16(&data[6]));
+        break;
+    case 0x92:
+    {
+        uint64_t angle = 0;
+        for (uint32_t i = 7; i >= 1; i--)
+        {
+            angle = (angle << 8) | data[i];
+        }
+        snprintf(columns[14], sizeof(columns[14]), "%lld", (long long)((int64_t)(angle ^ (1ULL << 55)) - (int64_t)(1ULL << 55)));
+        break;
+    }
+    case 0x94:
+        snprintf(columns[15], sizeof(columns[15]), "%u", read_le32(&data[4]));
+        break;
+    case 0x95:
+        snprintf(columns[14], sizeof(columns[14]), "%d", (int32_t)read_le32(&data[4]));
+        break;
+    case 0xC0:
+    case 0xC1:
+        snprintf(columns[16], sizeof(columns[16]), "0x%02X", data[1]);
+        snprintf(columns[17], sizeof(columns[17]), "%02X%02X%02X%02X%02X%02X", data[2], data[3], data[4], data[5], data[6], data[7]);
+        break;
+    default:
+        break;
+    }
+    for (uint32_t i = 0; i < 18; i++)
+    {
+        fprintf(out, ",%s", columns[i]);
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * @brief 解析导出数据，每条反馈输出一行CSV
+ *
+ * @param file 导出数据，读到文件结束或遇到不完整、损坏的记录为止
+ * @param out CSV输出
+ * @param stats 解析统计输出
+ * @return int 0表示成功，1表示不是遥测记录或版本不支持
+ */
+static int decode_stream(FILE *file, FILE *out, decode_stats_t *stats)
+{
+    memset(buses, 0, sizeof(buses));
+    *stats = (decode_stats_t){0};
+    uint8_t header[MG6010E_RECORDER_HEADER_SIZE];
+    if (!read_bytes(file, header, sizeof(header)) || read_le32(header) != MG6010E_RECORDER_MAGIC)
+    {
+        fprintf(stderr, "not a mg6010e record stream\n");
+        return 1;
+    }
+    if (read_le16(header + 4) != MG6010E_RECORDER_VERSION)
+    {
+        fprintf(stderr, "unsupported version %u\n", read_le16(header + 4));
+        return 1;
+    }
+    fprintf(out, "time_us,bus,motor,opcode,temperature,voltage,current,motor_state,error_state,iq,speed,encoder,ia,ib,ic,brake,"
+                 "encoder_raw,encoder_offset,angle,single_angle,param_id,param_data\n");
+
+    stats->bytes = MG6010E_RECORDER_HEADER_SIZE;
+    int mask;
+    while ((mask = fgetc(file)) != EOF)
+    {
+        uint8_t record[MG6010E_RECORDER_SYNC_SIZE];
+        if (mask == MG6010E_RECORDER_SYNC)
+        {
+            if (!read_bytes(file, record + 1, MG6010E_RECORDER_SYNC_SIZE - 1) || record[1] >= 8)
+            {
+                break;
+            }
+            bus_state_t *bus = &buses[record[1]];
+            uint32_t timestamp = read_le32(record + 2);
+            bus->time = bus->synced ? bus->time + (uint32_t)(timestamp - bus->timestamp) : timestamp;
+            bus->timestamp = timestamp;
+            bus->dropped = read_le32(record + 6);
+            bus->synced = 1;
+            memset(bus->ref, 0, sizeof(bus->ref));
+            stats->bytes += MG6010E_RECORDER_SYNC_SIZE;
+            stats->syncs++;
+            continue;
+        }
+        if (mask & 0x80)
+        {
+            fprintf(stderr, "corrupt record at byte %llu\n", (unsigned long long)stats->bytes);
+            break;
+        }
+        if (!read_bytes(file, record, 2))
+        {
+            break;
+        }
+        uint8_t motor = record[0];
+        uint8_t opcode = record[1];
+        uint32_t delta = 0;
+        uint32_t length = 3;
+        int byte;
+        for (uint32_t shift = 0; shift < 35 && (byte = fgetc(file)) != EOF; shift += 7)
+        {
+            length++;
+            delta |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                break;
+            }
+        }
+        if (byte == EOF || motor == 0 || MG6010E_MOTOR_BUS(motor) >= 8)
+        {
+            break;
+        }
+        bus_state_t *bus = &buses[MG6010E_MOTOR_BUS(motor)];
+        uint8_t *ref = bus->ref[MG6010E_MOTOR_CAN_ID(motor) - 1][MG6010E_RECORDER_CLASS(opcode)];
+        uint8_t data[8] = {opcode};
+        for (uint32_t i = 0; i < 7; i++)
+        {
+            if (mask & (1 << i))
+            {
+                if ((byte = fgetc(file)) == EOF)
+                {
+                    break;
+                }
+                ref[i] = (uint8_t)byte;
+                length++;
+            }
+            data[i + 1] = ref[i];
+        }
+        if (byte == EOF)
+        {
+            break;
+        }
+        stats->bytes += length;
+        if (!bus->synced)
+        {
+            stats->unsynced++; // 开始记录前写入的记录，没有参考值
+            continue;
+        }
+        bus->timestamp += delta;
+        bus->time += delta;
+        stats->records++;
+        fprintf(out, "%llu,%u,%u,0x%02X", (unsigned long long)bus->time, MG6010E_MOTOR_BUS(motor), MG6010E_MOTOR_CAN_ID(motor), opcode);
+        print_fields(out, opcode, data);
+    }
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        stats->dropped += buses[i].dropped;
+    }
+    return 0;
+}
+
+#ifndef MG6010E_RECORD_DECODE_NO_MAIN
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <record file | ->\n", argv[0]);
+        return 2;
+    }
+    FILE *file = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    decode_stats_t stats;
+    int result = decode_stream(file, stdout, &stats);
+    if (file != stdin)
+    {
+        fclose(file);
+    }
+    if (result != 0)
+    {
+        return result;
+    }
+    fprintf(stderr, "# %u records, %u syncs, %u dropped on device, %u before first sync, %llu bytes (%.2f bytes/record)\n",
+            stats.records, stats.syncs, stats.dropped, stats.unsynced, (unsigned long long)stats.bytes,
+            stats.records ? (double)stats.bytes / stats.records : 0.0);
+    return 0;
+}
+#endif
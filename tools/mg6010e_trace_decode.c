@@ -0,0 +1,269 @@
+/**
+ * @file mg6010e_trace_decode.c
+ * @brief 领控6010E电机驱动跟踪记录解析工具（上位机）
+ * @note 将mg6010e_trace_dump导出的二进制数据解析为时间线，按电机配对命令与回复并统计往返延迟，标出延迟尖峰。
+ * 编译：gcc -DMG6010E_USE_HAL=0 -I. tools/mg6010e_trace_decode.c -o mg6010e_trace_decode
+ * 用法：mg6010e_trace_decode <导出文件> [尖峰阈值us，默认2000]
+ */
+#include "mg6010e.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PENDING_NUM 8 // 每个电机记录的未回复命令数
+
+// 未回复的命令
+typedef struct pending
+{
+    uint8_t used;
+    uint8_t opcode;  // 期望的回复命令字节
+    uint64_t time;   // 发出时间，单位us
+} pending_t;
+
+// 每个电机的统计
+typedef struct motor_summary
+{
+    uint32_t tx;
+    uint32_t rx;
+    uint32_t matched;
+    uint32_t spikes;
+    uint64_t rtt_total;
+    uint32_t rtt_min;
+    uint32_t rtt_max;
+    pending_t pending[PENDING_NUM];
+} motor_summary_t;
+
+static motor_summary_t summary[8][32]; // 按总线编号与电机ID-1索引
+
+static uint32_t read_le32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint16_t read_le16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static const char *event_name(uint8_t event)
+{
+    switch (event)
+    {
+    case MG6010E_TRACE_TX:
+        return "TX";
+    case MG6010E_TRACE_TX_FAIL:
+        return "TX_FAIL";
+    case MG6010E_TRACE_RX:
+        return "RX";
+    case MG6010E_TRACE_RX_UNREGISTERED:
+        return "RX_UNREG";
+    case MG6010E_TRACE_RX_UNKNOWN:
+        return "RX_UNKNOWN";
+    default:
+        return "?";
+    }
+}
+
+static void pending_push(motor_summary_t *motor, uint8_t opcode, uint64_t time)
+{
+    pending_t *oldest = &motor->pending[0];
+    for (uint32_t i = 0; i < PENDING_NUM; i++)
+    {
+        if (!motor->pending[i].used)
+        {
+            oldest = &motor->pending[i];
+            break;
+        }
+        if (motor->pending[i].time < oldest->time)
+        {
+            oldest = &motor->pending[i];
+        }
+    }
+    oldest->used = 1;
+    oldest->opcode = opcode;
+    oldest->time = time;
+}
+
+// 取出与回复匹配的最早一条命令，返回往返延迟，没有匹配时返回-1
+static int64_t pending_match(motor_summary_t *motor, uint8_t opcode, uint64_t time)
+{
+    pending_t *match = NULL;
+    for (uint32_t i = 0; i < PENDING_NUM; i++)
+    {
+        pending_t *pending = &motor->pending[i];
+        if (pending->used && pending->opcode == opcode && (match == NULL || pending->time < match->time))
+        {
+            match = pending;
+        }
+    }
+    if (match == NULL)
+    {
+        return -1;
+    }
+    match->used = 0;
+    return (int64_t)(time - match->time);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <dump file> [spike threshold us, default 2000]\n", argv[0]);
+        return 2;
+    }
+    uint32_t spike_us = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 2000;
+    FILE *file = fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    uint8_t header[MG6010E_TRACE_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) || read_le32(header) != MG6010E_TRACE_MAGIC)
+    {
+        fprintf(stderr, "%s: not a mg6010e trace dump\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+    uint16_t version = read_le16(header + 4);
+    uint16_t entry_size = read_le16(header + 6);
+    uint32_t count = read_le32(header + 8);
+    uint32_t total = read_le32(header + 12);
+    if (version != MG6010E_TRACE_VERSION || entry_size < MG6010E_TRACE_ENTRY_SIZE)
+    {
+        fprintf(stderr, "%s: unsupported version %u or entry size %u\n", argv[1], version, entry_size);
+        fclose(file);
+        return 1;
+    }
+    printf("# %u records (%u recorded, %u overwritten), spike threshold %u us\n", count, total, total - count, spike_us);
+    printf("# %12s %10s  bus  id     motor  event       opcode  rtt_us\n", "time_us", "delta_us");
+
+    uint8_t entry[256];
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint64_t now = 0; // 自第一条记录起的时间，按32位时间戳的差值累加以处理回绕
+    uint32_t gaps = 0;
+    uint32_t tx_fail = 0;
+    uint32_t unregistered = 0;
+    uint32_t unknown = 0;
+    for (uint32_t n = 0; n < count && fread(entry, 1, entry_size, file) == entry_size; n++)
+    {
+        uint32_t timestamp = read_le32(entry);
+        uint16_t id = read_le16(entry + 4);
+        uint8_t opcode = entry[6];
+        uint8_t event = entry[7];
+        uint32_t bus = id >> 11;
+        uint32_t std_id = id & 0x7FF;
+        if (n == 0)
+        {
+            first = timestamp;
+            last = timestamp;
+        }
+        uint32_t delta = timestamp - last;
+        if (delta > 0x80000000U)
+        {
+            delta = 0; // 并发写入的记录可能略早于上一条
+        }
+        now += delta;
+        last = timestamp;
+
+        int64_t rtt = -1;
+        uint32_t motor = 0;
+        if (event == MG6010E_TRACE_TX || event == MG6010E_TRACE_TX_FAIL)
+        {
+            if (event == MG6010E_TRACE_TX_FAIL)
+            {
+                tx_fail++;
+            }
+            else if (std_id == MG6010E_CAN_MULTI_IQ_ID)
+            {
+                for (uint32_t i = 0; i < MG6010E_CAN_MULTI_IQ_MOTOR_NUM; i++)
+                {
+                    pending_push(&summary[bus][i], 0xA1, now); // 广播帧的每个电机以0xA1格式回复
+                    summary[bus][i].tx++;
+                }
+            }
+            else if (std_id - (MG6010E_CAN_CMD_BASE_ID + 1) < 32)
+            {
+                motor = std_id - MG6010E_CAN_CMD_BASE_ID;
+                pending_push(&summary[bus][motor - 1], opcode, now);
+                summary[bus][motor - 1].tx++;
+            }
+        }
+        else if (std_id - (MG6010E_CAN_FEEDBACK_BASE_ID + 1) < 32)
+        {
+            motor = std_id - MG6010E_CAN_FEEDBACK_BASE_ID;
+            motor_summary_t *summary_motor = &summary[bus][motor - 1];
+            if (event == MG6010E_TRACE_RX)
+            {
+                summary_motor->rx++;
+                rtt = pending_match(summary_motor, opcode, now);
+                if (rtt >= 0)
+                {
+                    uint32_t value = (uint32_t)rtt;
+                    if (summary_motor->matched == 0 || value < summary_motor->rtt_min)
+                    {
+                        summary_motor->rtt_min = value;
+                    }
+                    if (value > summary_motor->rtt_max)
+                    {
+                        summary_motor->rtt_max = value;
+                    }
+                    summary_motor->rtt_total += value;
+                    summary_motor->matched++;
+                    if (value > spike_us)
+                    {
+                        summary_motor->spikes++;
+                    }
+                }
+            }
+            else if (event == MG6010E_TRACE_RX_UNREGISTERED)
+            {
+                unregistered++;
+            }
+            else if (event == MG6010E_TRACE_RX_UNKNOWN)
+            {
+                unknown++;
+            }
+        }
+
+        printf("  %12llu %10u  %3u  0x%03X  ", (unsigned long long)now, delta, bus, std_id);
+        if (motor != 0)
+        {
+            printf("%5u  ", motor);
+        }
+        else
+        {
+            printf("%5s  ", "-");
+        }
+        printf("%-10s  0x%02X", event_name(event), opcode);
+        if (rtt >= 0)
+        {
+            printf("  %6lld", (long long)rtt);
+        }
+        uint8_t gap = n > 0 && delta > spike_us; // 两条记录间的空白，如控制循环停顿
+        if (rtt > (int64_t)spike_us || gap)
+        {
+            printf("  <-- spike");
+        }
+        printf("\n");
+        gaps += gap;
+    }
+    fclose(file);
+
+    printf("\n# span %u us, %u gaps over threshold, %u tx failures, %u unregistered, %u unknown opcodes\n", last - first, gaps, tx_fail, unregistered, unknown);
+    printf("# bus  motor      tx      rx  matched  rtt_min  rtt_avg  rtt_max  spikes\n");
+    for (uint32_t bus = 0; bus < 8; bus++)
+    {
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            motor_summary_t *motor = &summary[bus][i];
+            if (motor->tx == 0 && motor->rx == 0)
+            {
+                continue;
+            }
+            printf("  %3u  %5u  %6u  %6u  %7u  %7u  %7llu  %7u  %6u\n", bus, i + 1, motor->tx, motor->rx, motor->matched, motor->rtt_min,
+                   (unsigned long long)(motor->matched ? motor->rtt_total / motor->matched : 0), motor->rtt_max, motor->spikes);
+        }
+    }
+    return 0;
+}